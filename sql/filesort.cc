@@ -40,14 +40,19 @@
 
 static uchar *read_buffpek_from_file(IO_CACHE *buffer_file, uint count,
                                      uchar *buf);
+class Sort_workers;
 static ha_rows find_all_keys(THD *thd, Sort_param *param, SQL_SELECT *select,
                              SORT_INFO *fs_info,
                              IO_CACHE *buffer_file,
                              IO_CACHE *tempfile,
                              Bounded_queue<uchar, uchar> *pq,
+                             Sort_workers *workers,
                              ha_rows *found_rows);
 static bool write_keys(Sort_param *param, SORT_INFO *fs_info,
                       uint count, IO_CACHE *buffer_file, IO_CACHE *tempfile);
+static bool write_sorted_keys(Sort_param *param, uchar **sorted_keys,
+                              uint count, IO_CACHE *buffer_file,
+                              IO_CACHE *tempfile);
 static uint make_sortkey(Sort_param *param, uchar *to, uchar *ref_pos,
                          bool using_packed_sortkeys= false);
 static uint make_sortkey(Sort_param *param, uchar *to);
@@ -63,6 +68,103 @@ static Addon_fields *get_addon_fields(TABLE *table, uint sortlength,
                                       uint *addon_length,
                                       uint *m_packable_length);
 
+#ifdef HAVE_PSI_INTERFACE
+extern PSI_mutex_key key_LOCK_sort_workers, key_LOCK_sort_output;
+extern PSI_cond_key key_COND_sort_workers;
+extern PSI_thread_key key_thread_sort_worker;
+#endif
+
+
+/**
+  Helper threads of one filesort() call, see @@sort_threads.
+  The helpers of all filesorts in the server are limited by
+  @@max_sort_threads.
+
+  The query thread reads the rows and makes the sort keys. When the sort
+  buffer is full, it is exchanged with an empty one and handed to a
+  helper, which sorts it and writes it to the temporary file as a sorted
+  run, while the query thread goes on filling the next buffer. The merge
+  passes of merge_many_buff() are split between the helpers and the query
+  thread.
+
+  The helpers have no THD and must not touch Items, Fields or the handler:
+  they work only on the sort buffers, Sort_param and the temporary files.
+*/
+
+class Sort_workers
+{
+public:
+  class Job
+  {
+  public:
+    Job *next_job;
+    virtual ~Job() = default;
+    /** @return whether an error occurred */
+    virtual bool run()= 0;
+    /** Called under Sort_workers::lock when run() has returned */
+    virtual void finish() {}
+  };
+
+  Sort_workers()
+    : threads(NULL), n_threads(0), first_job(NULL), last_job(NULL),
+      n_pending(0), stopping(false), error(0),
+      runs(NULL), idle_runs(NULL), n_runs(0),
+      param(NULL), buffpek_pointers(NULL), tempfile(NULL)
+  {}
+  ~Sort_workers() { stop(); }
+
+  /** Number of running helper threads; 0 if the sort is not parallel */
+  uint size() const { return n_threads; }
+
+  bool start(uint n);
+  void stop();
+
+  bool start_runs(Sort_param *param, IO_CACHE *buffpek_pointers,
+                  IO_CACHE *tempfile, uint n);
+  bool write_run(SORT_INFO *fs_info, uint count);
+  bool end_runs();
+
+  int merge_many_buff(Sort_param *param, Sort_buffer sort_buffer,
+                      Merge_chunk *buffpek, uint *maxbuffer,
+                      IO_CACHE *t_file);
+
+  /** Main loop of a helper thread */
+  void work();
+
+private:
+  class Run_job;
+  class Merge_job;
+
+  void submit(Job *job);
+  int wait_all();
+  bool report_error(int err, const IO_CACHE *file);
+  void free_runs();
+
+  pthread_t *threads;
+  uint n_threads;
+  /** Protects the job queue, n_pending, error and idle_runs */
+  mysql_mutex_t lock;
+  /** Signalled when a job is queued, finished, or the helpers stop */
+  mysql_cond_t cond;
+  /** Serializes the writes of sorted runs to tempfile */
+  mysql_mutex_t output_lock;
+  Job *first_job, *last_job;
+  /** Number of queued or running jobs */
+  uint n_pending;
+  bool stopping;
+  /** my_errno of the first failed job, or 0 */
+  int error;
+
+  /** Run generation: one spare sort buffer per job */
+  Run_job *runs;
+  Run_job *idle_runs;
+  uint n_runs;
+  Sort_param *param;
+  IO_CACHE *buffpek_pointers;
+  IO_CACHE *tempfile;
+};
+
+
 static void store_key_part_length(uint32 num, uchar *to, uint bytes)
 {
   switch(bytes) {
@@ -220,6 +322,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
   Sort_param param;
   bool allow_packing_for_sortkeys;
   Bounded_queue<uchar, uchar> pq;
+  Sort_workers workers;
   SQL_SELECT *const select= filesort->select;
   Sort_costs costs;
   ha_rows limit_rows= filesort->limit;
@@ -410,6 +513,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
                           &buffpek_pointers,
                           &tempfile,
                           pq.is_initialized() ? &pq : NULL,
+                          &workers,
                           &sort->found_rows);
   if (num_rows == HA_POS_ERROR)
     goto err;
@@ -466,7 +570,11 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
     set_if_bigger(param.max_keys_per_buffer, 1);
     maxbuffer--;				// Offset from 0
 
-    if (merge_many_buff(&param, sort->get_raw_buf(),
+    if (workers.size() ?
+        workers.merge_many_buff(&param, sort->get_raw_buf(),
+                                buffpek, &maxbuffer,
+                                &tempfile) :
+        merge_many_buff(&param, sort->get_raw_buf(),
                         buffpek, &maxbuffer,
                         &tempfile))
       goto err;
@@ -490,6 +598,8 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
   error= 0;
 
   err:
+  /* Wait for the helpers before the buffers and files are freed */
+  workers.stop();
   param.tmp_buffer.free();
   if (!subselect || !subselect->is_uncacheable())
   {
@@ -846,6 +956,8 @@ static void dbug_print_record(TABLE *table, bool print_rowid)
                            in tempfile.
   @param tempfile          File to write sorted sequences of sortkeys to.
   @param pq                If !NULL, use it for keeping top N elements
+  @param workers           Helper threads, started here on the first full
+                           sort buffer if @@sort_threads > 1
   @param [out] found_rows  The number of FOUND_ROWS().
                            For a query with LIMIT, this value will typically
                            be larger than the function return value.
@@ -885,6 +997,7 @@ static ha_rows find_all_keys(THD *thd, Sort_param *param, SQL_SELECT *select,
                              IO_CACHE *buffpek_pointers,
                              IO_CACHE *tempfile,
                              Bounded_queue<uchar, uchar> *pq,
+                             Sort_workers *workers,
                              ha_rows *found_rows)
 {
   int error, quick_select;
@@ -1018,7 +1131,15 @@ static ha_rows find_all_keys(THD *thd, Sort_param *param, SQL_SELECT *select,
       {
         if (fs_info->isfull())
         {
-          if (write_keys(param, fs_info, num_elements_in_buffer,
+          if (!indexpos && thd->variables.sort_threads > 1)
+          {
+            workers->start_runs(param, buffpek_pointers, tempfile,
+                                (uint) thd->variables.sort_threads - 1);
+            DEBUG_SYNC(thd, "filesort_workers_started");
+          }
+          if (workers->size() ?
+              workers->write_run(fs_info, num_elements_in_buffer) :
+              write_keys(param, fs_info, num_elements_in_buffer,
                          buffpek_pointers, tempfile))
             goto err;
           num_elements_in_buffer= 0;
@@ -1069,9 +1190,13 @@ static ha_rows find_all_keys(THD *thd, Sort_param *param, SQL_SELECT *select,
     DBUG_RETURN(HA_POS_ERROR);
   }
   if (indexpos && num_elements_in_buffer &&
-      write_keys(param, fs_info, num_elements_in_buffer, buffpek_pointers,
-                 tempfile))
+      (workers->size() ?
+       workers->write_run(fs_info, num_elements_in_buffer) :
+       write_keys(param, fs_info, num_elements_in_buffer, buffpek_pointers,
+                  tempfile)))
     DBUG_RETURN(HA_POS_ERROR);			/* purecov: inspected */
+  if (workers->size() && workers->end_runs())
+    DBUG_RETURN(HA_POS_ERROR);
 
   (*found_rows)= num_records;
   if (pq)
@@ -1113,11 +1238,28 @@ static bool
 write_keys(Sort_param *param,  SORT_INFO *fs_info, uint count,
            IO_CACHE *buffpek_pointers, IO_CACHE *tempfile)
 {
-  Merge_chunk buffpek;
   DBUG_ENTER("write_keys");
 
   fs_info->sort_buffer(param, count);
 
+  DBUG_RETURN(write_sorted_keys(param, fs_info->get_sort_keys(), count,
+                                buffpek_pointers, tempfile));
+} /* write_keys */
+
+
+/**
+  Write a sorted buffer as a run, see write_keys().
+
+  @param sorted_keys       The sorted array of pointers to keys
+*/
+
+static bool
+write_sorted_keys(Sort_param *param, uchar **sorted_keys, uint count,
+                  IO_CACHE *buffpek_pointers, IO_CACHE *tempfile)
+{
+  Merge_chunk buffpek;
+  DBUG_ENTER("write_sorted_keys");
+
   if (!my_b_inited(tempfile) &&
       open_cached_file(tempfile, mysql_tmpdir, TEMP_PREFIX, DISK_CHUNK_SIZE,
                        MYF(MY_WME)))
@@ -1133,7 +1275,7 @@ write_keys(Sort_param *param,  SORT_INFO *fs_info, uint count,
 
   for (uint ix= 0; ix < count; ++ix)
   {
-    uchar *record= fs_info->get_sorted_record(ix);
+    uchar *record= sorted_keys[ix];
     if (my_b_write(tempfile, record, param->get_record_length(record)))
       DBUG_RETURN(1);                           /* purecov: inspected */
   }
@@ -1143,7 +1285,518 @@ write_keys(Sort_param *param,  SORT_INFO *fs_info, uint count,
 
   DBUG_RETURN(0);
 
-} /* write_keys */
+} /* write_sorted_keys */
+
+
+/** A full sort buffer that a helper sorts and writes as a run */
+
+class Sort_workers::Run_job : public Sort_workers::Job
+{
+public:
+  Sort_workers *workers;
+  Filesort_buffer buffer;
+  uint count;
+  Run_job *next_idle;
+
+  bool run() override
+  {
+    Sort_param *param= workers->param;
+    bool res;
+    buffer.sort_buffer(param, count);
+    mysql_mutex_lock(&workers->output_lock);
+    res= write_sorted_keys(param, buffer.get_sort_keys(), count,
+                           workers->buffpek_pointers, workers->tempfile);
+    mysql_mutex_unlock(&workers->output_lock);
+    return res;
+  }
+
+  void finish() override
+  {
+    next_idle= workers->idle_runs;
+    workers->idle_runs= this;
+  }
+};
+
+
+/** A range of the groups of one merge_many_buff() pass */
+
+class Sort_workers::Merge_job : public Sort_workers::Job
+{
+public:
+  Sort_param param;
+  Sort_buffer buffer;
+  IO_CACHE *from_file;
+  File to_file;
+  Merge_chunk *buffpek;
+  Merge_chunk *lastbuff;
+  /** Index in buffpek of the first run of each group */
+  const uint *group_start;
+  uint first_group, end_group;
+  /** End of the data written by run() */
+  my_off_t end_pos;
+
+  bool run() override;
+};
+
+
+/**
+  IO_CACHE::write_function of Sort_workers::Merge_job: write at the cache
+  position with pwrite(), so that the jobs can share the file descriptor.
+*/
+
+static int sort_merge_pwrite(IO_CACHE *info, const uchar *buffer, size_t count)
+{
+  if (mysql_file_pwrite(info->file, buffer, count, info->pos_in_file,
+                        info->myflags | MY_NABP))
+    return info->error= -1;
+  info->pos_in_file+= count;
+  return 0;
+}
+
+
+bool Sort_workers::Merge_job::run()
+{
+  IO_CACHE out;
+  bool res= false;
+
+  /*
+    The runs of a group are stored one after another, and merging does
+    not make them longer, so the output of each group is written where
+    its input starts. The groups of different jobs do not overlap.
+  */
+  if (init_io_cache(&out, to_file, DISK_CHUNK_SIZE, WRITE_CACHE,
+                    buffpek[group_start[first_group]].file_position(), 0,
+                    MYF(MY_WME)))
+    return true;
+  out.write_function= sort_merge_pwrite;
+
+  for (uint g= first_group; !res && g < end_group; g++)
+  {
+    const my_off_t pos= buffpek[group_start[g]].file_position();
+    if (my_b_tell(&out) != pos)
+    {
+      /* The previous group was cut by LIMIT */
+      if ((res= reinit_io_cache(&out, WRITE_CACHE, pos, 0, 0)))
+        break;
+      out.write_function= sort_merge_pwrite;
+    }
+    res= merge_buffers(&param, from_file, &out, buffer, lastbuff + g,
+                       buffpek + group_start[g],
+                       buffpek + group_start[g + 1] - 1, 0);
+  }
+
+  end_pos= my_b_tell(&out);
+  if (flush_io_cache(&out))
+    res= true;
+  end_io_cache(&out);
+  return res;
+}
+
+
+/** Number of running helpers of all filesorts, see @@max_sort_threads */
+static Atomic_counter<ulong> sort_workers_running;
+
+
+/** Main function of the @@sort_threads helpers */
+
+pthread_handler_t sort_worker_thread(void *arg)
+{
+  my_thread_init();
+  static_cast<Sort_workers*>(arg)->work();
+  my_thread_end();
+  return 0;
+}
+
+
+/**
+  Start the helper threads. Fewer threads are started if the server
+  would have more than @@max_sort_threads helpers.
+
+  @param n  Number of threads
+
+  @retval false  At least one thread was started
+  @retval true   No thread could be started
+*/
+
+bool Sort_workers::start(uint n)
+{
+  DBUG_ASSERT(!n_threads);
+  ulong max_threads= max_sort_threads;
+  ulong running= (sort_workers_running+= n);
+  if (running > max_threads)
+  {
+    uint excess= (uint) std::min<ulong>(n, running - max_threads);
+    sort_workers_running-= excess;
+    if (!(n-= excess))
+      return true;
+  }
+
+  if (!(threads= (pthread_t*) my_malloc(PSI_INSTRUMENT_ME,
+                                        n * sizeof(pthread_t), MYF(0))))
+  {
+    sort_workers_running-= n;
+    return true;
+  }
+  mysql_mutex_init(key_LOCK_sort_workers, &lock, MY_MUTEX_INIT_FAST);
+  mysql_mutex_init(key_LOCK_sort_output, &output_lock, MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_COND_sort_workers, &cond, NULL);
+  stopping= false;
+  error= 0;
+
+  while (n_threads < n &&
+         !mysql_thread_create(key_thread_sort_worker, &threads[n_threads],
+                              NULL, sort_worker_thread, this))
+    n_threads++;
+  sort_workers_running-= n - n_threads;
+  if (n_threads)
+    return false;
+
+  mysql_cond_destroy(&cond);
+  mysql_mutex_destroy(&output_lock);
+  mysql_mutex_destroy(&lock);
+  my_free(threads);
+  threads= NULL;
+  return true;
+}
+
+
+/** Let the helpers finish the queued jobs, and stop them */
+
+void Sort_workers::stop()
+{
+  if (!n_threads)
+    return;
+
+  mysql_mutex_lock(&lock);
+  stopping= true;
+  mysql_cond_broadcast(&cond);
+  mysql_mutex_unlock(&lock);
+  for (uint i= 0; i < n_threads; i++)
+    pthread_join(threads[i], NULL);
+
+  free_runs();
+  mysql_cond_destroy(&cond);
+  mysql_mutex_destroy(&output_lock);
+  mysql_mutex_destroy(&lock);
+  my_free(threads);
+  threads= NULL;
+  sort_workers_running-= n_threads;
+  n_threads= 0;
+}
+
+
+void Sort_workers::work()
+{
+  mysql_mutex_lock(&lock);
+  for (;;)
+  {
+    Job *job= first_job;
+    if (!job)
+    {
+      if (stopping)
+        break;
+      mysql_cond_wait(&cond, &lock);
+      continue;
+    }
+    if (!(first_job= job->next_job))
+      last_job= NULL;
+    mysql_mutex_unlock(&lock);
+
+    int err= 0;
+    if (job->run())
+      err= my_errno ? my_errno : EIO;
+
+    mysql_mutex_lock(&lock);
+    if (err && !error)
+      error= err;
+    job->finish();
+    n_pending--;
+    mysql_cond_broadcast(&cond);
+  }
+  mysql_mutex_unlock(&lock);
+}
+
+
+void Sort_workers::submit(Job *job)
+{
+  job->next_job= NULL;
+  mysql_mutex_lock(&lock);
+  if (last_job)
+    last_job->next_job= job;
+  else
+    first_job= job;
+  last_job= job;
+  n_pending++;
+  mysql_cond_broadcast(&cond);
+  mysql_mutex_unlock(&lock);
+}
+
+
+/**
+  Wait for all submitted jobs to finish.
+
+  @return my_errno of the first failed job, or 0
+*/
+
+int Sort_workers::wait_all()
+{
+  int err;
+  mysql_mutex_lock(&lock);
+  while (n_pending)
+    mysql_cond_wait(&cond, &lock);
+  err= error;
+  mysql_mutex_unlock(&lock);
+  return err;
+}
+
+
+/**
+  Raise the error of a failed job in the query thread. The helpers have
+  no THD, so their errors only went to the error log.
+
+  @return whether a job failed
+*/
+
+bool Sort_workers::report_error(int err, const IO_CACHE *file)
+{
+  if (!err)
+    return false;
+  if (!current_thd->is_error())
+    my_error(ER_ERROR_ON_WRITE, MYF(0), my_filename(file->file), err);
+  return true;
+}
+
+
+/**
+  Start the helpers and allocate a spare sort buffer for each of them.
+  If that is not possible, the sort goes on in the query thread only.
+
+  @param param_arg             Sort parameters
+  @param buffpek_pointers_arg  File for the Merge_chunk of each run
+  @param tempfile_arg          File for the sorted runs
+  @param n                     Number of helpers
+
+  @return whether the helpers could not be started
+*/
+
+bool Sort_workers::start_runs(Sort_param *param_arg,
+                              IO_CACHE *buffpek_pointers_arg,
+                              IO_CACHE *tempfile_arg, uint n)
+{
+  DBUG_ENTER("Sort_workers::start_runs");
+  if (start(n))
+    DBUG_RETURN(true);
+  /* One spare buffer for each helper that could be started */
+  n= n_threads;
+
+  param= param_arg;
+  buffpek_pointers= buffpek_pointers_arg;
+  tempfile= tempfile_arg;
+  if ((runs= new Run_job[n]))
+  {
+    n_runs= n;
+    for (uint i= 0; i < n; i++)
+    {
+      Run_job *run= &runs[i];
+      run->workers= this;
+      if (!run->buffer.alloc_sort_buffer(param->max_keys_per_buffer,
+                                         param->rec_length))
+        break;
+      run->next_idle= idle_runs;
+      idle_runs= run;
+    }
+  }
+  if (idle_runs)
+    DBUG_RETURN(false);
+
+  /* Not even one spare buffer: stay in the query thread */
+  stop();
+  DBUG_RETURN(true);
+}
+
+
+/**
+  Hand the full sort buffer to a helper, and go on with a spare one.
+  Waits for a spare buffer if all of them are being sorted.
+
+  @param fs_info  The sort buffer
+  @param count    Number of records in the sort buffer
+
+  @return whether an error occurred
+*/
+
+bool Sort_workers::write_run(SORT_INFO *fs_info, uint count)
+{
+  Run_job *run;
+  int err;
+
+  mysql_mutex_lock(&lock);
+  while (!(run= idle_runs) && !error)
+    mysql_cond_wait(&cond, &lock);
+  if (run)
+    idle_runs= run->next_idle;
+  err= error;
+  mysql_mutex_unlock(&lock);
+  if (err)
+    return report_error(err, tempfile);
+
+  fs_info->swap_sort_buffer(&run->buffer);
+  run->count= count;
+  submit(run);
+  return false;
+}
+
+
+/**
+  Wait until all runs are written, and free the spare sort buffers.
+
+  @return whether an error occurred
+*/
+
+bool Sort_workers::end_runs()
+{
+  int err= wait_all();
+  free_runs();
+  return report_error(err, tempfile);
+}
+
+
+void Sort_workers::free_runs()
+{
+  if (!runs)
+    return;
+  for (uint i= 0; i < n_runs; i++)
+    runs[i].buffer.free_sort_buffer();
+  delete [] runs;
+  runs= idle_runs= NULL;
+  n_runs= 0;
+}
+
+
+/**
+  Merge buffers to make < MERGEBUFF2 buffers, like ::merge_many_buff(),
+  but merge the groups of each pass in parallel.
+
+  The sort buffer is split between the helpers and the query thread, and
+  each of them merges a range of the groups. The runs are read with
+  my_b_pread(), and every job writes the file through its own IO_CACHE.
+*/
+
+int Sort_workers::merge_many_buff(Sort_param *param, Sort_buffer sort_buffer,
+                                  Merge_chunk *buffpek, uint *maxbuffer,
+                                  IO_CACHE *t_file)
+{
+  THD *thd= current_thd;
+  const uint max_groups= *maxbuffer / MERGEBUFF + 1;
+  const uint n_parts=
+    MY_MIN(n_threads + 1,
+           (uint) (sort_buffer.size() / (param->rec_length * MERGEBUFF2)));
+  IO_CACHE t_file2, *from_file, *to_file, *temp;
+  Merge_job *jobs= NULL, *own;
+  uint *group_start= NULL;
+  Merge_chunk *lastbuff= NULL;
+  size_t part_size;
+  int err;
+  bool res= true;
+  DBUG_ENTER("Sort_workers::merge_many_buff");
+
+  if (*maxbuffer < MERGEBUFF2)
+    DBUG_RETURN(0);
+  /* Encrypted temporary files can only be read through IO_CACHE */
+  if (n_parts < 2 || (t_file->myflags & MY_ENCRYPT))
+    DBUG_RETURN(::merge_many_buff(param, sort_buffer, buffpek, maxbuffer,
+                                  t_file));
+  if (flush_io_cache(t_file) ||
+      open_cached_file(&t_file2, mysql_tmpdir, TEMP_PREFIX, DISK_CHUNK_SIZE,
+                       MYF(MY_WME)))
+    DBUG_RETURN(1);
+
+  from_file= t_file; to_file= &t_file2;
+  if (!(jobs= new Merge_job[n_parts]) ||
+      !(group_start= (uint*) my_malloc(PSI_INSTRUMENT_ME,
+                                       (max_groups + 1) * sizeof(uint),
+                                       MYF(MY_WME))) ||
+      !(lastbuff= (Merge_chunk*) my_malloc(PSI_INSTRUMENT_ME,
+                                           max_groups * sizeof(Merge_chunk),
+                                           MYF(MY_WME))))
+    goto cleanup;
+
+  part_size= sort_buffer.size() / n_parts;
+  for (uint part= 0; part < n_parts; part++)
+  {
+    Merge_job *job= &jobs[part];
+    job->param= *param;
+    job->param.max_keys_per_buffer= (uint) (part_size / param->rec_length);
+    job->buffer= Sort_buffer(sort_buffer.array() + part * part_size,
+                             part_size);
+    job->buffpek= buffpek;
+    job->lastbuff= lastbuff;
+    job->group_start= group_start;
+  }
+  /* The last part is merged by the query thread, which can be killed */
+  own= &jobs[n_parts - 1];
+  for (uint part= 0; part + 1 < n_parts; part++)
+    jobs[part].param.not_killable= true;
+
+  while (*maxbuffer >= MERGEBUFF2)
+  {
+    uint i, n_groups= 0;
+    if (reinit_io_cache(from_file, READ_CACHE, 0L, 0, 0) ||
+        reinit_io_cache(to_file, WRITE_CACHE, 0L, 0, 0) ||
+        (to_file->file < 0 && real_open_cached_file(to_file)))
+      goto cleanup;
+
+    for (i= 0; i <= *maxbuffer - MERGEBUFF * 3 / 2; i+= MERGEBUFF)
+      group_start[n_groups++]= i;
+    group_start[n_groups++]= i;
+    group_start[n_groups]= *maxbuffer + 1;
+
+    for (uint part= 0; part < n_parts; part++)
+    {
+      Merge_job *job= &jobs[part];
+      job->from_file= from_file;
+      job->to_file= to_file->file;
+      job->first_group= n_groups * part / n_parts;
+      job->end_group= n_groups * (part + 1) / n_parts;
+      if (job != own && job->first_group < job->end_group)
+        submit(job);
+    }
+    DBUG_ASSERT(own->first_group < own->end_group);
+    bool own_failed= own->run();
+    err= wait_all();
+    if (own_failed || report_error(err, to_file))
+      goto cleanup;
+
+    /* merge_buffers() counted only the groups of the query thread */
+    for (uint g= 0; g < own->first_group; g++)
+    {
+      thd->inc_status_sort_merge_passes();
+      thd->query_plan_fsort_passes++;
+    }
+    for (uint g= 0; g < n_groups; g++)
+    {
+      buffpek[g].set_file_position(lastbuff[g].file_position());
+      buffpek[g].set_rowcount(lastbuff[g].rowcount());
+    }
+    /* The jobs wrote past to_file; move it to the end of the data */
+    if (reinit_io_cache(to_file, WRITE_CACHE, own->end_pos, 0, 0))
+      goto cleanup;
+    temp=from_file; from_file=to_file; to_file=temp;
+    *maxbuffer= n_groups - 1;
+  }
+  res= false;
+
+cleanup:
+  close_cached_file(to_file);			// This holds old result
+  if (to_file == t_file)
+  {
+    *t_file=t_file2;				// Copy result file
+  }
+  my_free(lastbuff);
+  my_free(group_start);
+  delete [] jobs;
+  DBUG_RETURN(res);
+}
 
 
 /**
@@ -1756,8 +2409,13 @@ bool merge_buffers(Sort_param *param, IO_CACHE *from_file,
   THD* const thd=current_thd;
   DBUG_ENTER("merge_buffers");
 
-  thd->inc_status_sort_merge_passes();
-  thd->query_plan_fsort_passes++;
+  /* Helper threads of a parallel filesort have no THD, see Sort_workers */
+  DBUG_ASSERT(thd || !killable);
+  if (thd)
+  {
+    thd->inc_status_sort_merge_passes();
+    thd->query_plan_fsort_passes++;
+  }
 
   rec_length= param->rec_length;
   res_length= param->res_length;
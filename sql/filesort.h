@@ -181,6 +181,9 @@ class SORT_INFO
 
   bool isfull() const
   { return filesort_buffer.isfull(); }
+  /** Exchange the sort buffer with one of the @@sort_threads buffers */
+  void swap_sort_buffer(Filesort_buffer *buffer)
+  { std::swap(filesort_buffer, *buffer); }
   void init_record_pointers()
   { filesort_buffer.init_record_pointers(); }
   void init_next_record_pointer()
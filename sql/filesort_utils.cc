@@ -399,7 +399,8 @@ void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
   if (!param->using_packed_sortkeys() &&
       radixsort_is_applicable(count, param->sort_length) &&
       (buffer= (uchar**) my_malloc(PSI_INSTRUMENT_ME, count*sizeof(char*),
-                                   MYF(MY_THREAD_SPECIFIC))))
+                                   /* @@sort_threads helpers have no THD */
+                                   MYF(current_thd ? MY_THREAD_SPECIFIC : 0))))
   {
     radixsort_for_str_ptr(m_sort_keys, count, param->sort_length, buffer);
     my_free(buffer);
@@ -7038,6 +7038,31 @@ check_result_t handler_rowid_filter_check(void *h_arg)
 }
 
 
+/**
+  Scan filter callback - to be called by an engine to check the row of
+  a table scan against the filter pushed into the scan
+*/
+
+extern "C"
+check_result_t handler_scan_filter_check(void *h_arg)
+{
+  handler *h= (handler*) h_arg;
+  THD *thd= h->table->in_use;
+
+  enum thd_kill_levels killed= thd_kill_level(thd);
+  if (unlikely(killed != THD_IS_NOT_KILLED))
+  {
+    enum thd_kill_levels abort_at= (h->has_transactions() ?
+                                    THD_ABORT_SOFTLY :
+                                    THD_ABORT_ASAP);
+    if (killed > abort_at)
+      return CHECK_ABORTED_BY_USER;
+  }
+
+  return h->pushed_scan_filter->check() ? CHECK_POS : CHECK_NEG;
+}
+
+
 /**
   Callback function for an engine to check whether the used rowid filter
   has been already built
@@ -7431,6 +7456,7 @@ int handler::ha_reset()
   cancel_pushed_idx_cond();
   /* Reset information about pushed index conditions */
   cancel_pushed_rowid_filter();
+  cancel_pushed_scan_filter();
   if (lookup_handler != this)
   {
     lookup_handler->ha_external_unlock(table->in_use);
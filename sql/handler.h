@@ -3085,6 +3085,24 @@ extern "C" check_result_t handler_index_cond_check(void* h_arg);
 
 extern "C" check_result_t handler_rowid_filter_check(void* h_arg);
 extern "C" int handler_rowid_filter_is_active(void* h_arg);
+extern "C" check_result_t handler_scan_filter_check(void* h_arg);
+
+/*
+  A filter that can be pushed into the table scans of a handler.
+  The engine checks a row against the filter as soon as it has stored
+  the fields of fields() in the record buffer, and skips the row if
+  check() returns false.
+*/
+
+class Scan_filter
+{
+public:
+  virtual ~Scan_filter() = default;
+  /* The fields of the table the filter refers to */
+  virtual const MY_BITMAP *fields() const= 0;
+  /* Return false if the row in the record buffer is to be skipped */
+  virtual bool check()= 0;
+};
 
 uint calculate_key_len(TABLE *, uint, const uchar *, key_part_map);
 /*
@@ -3149,6 +3167,31 @@ class Table_path_buffer: public CharBuffer<FN_REFLEN>
 };
 
 
+/**
+  Consumer of the rows that handler::parallel_scan() reads. The engine
+  calls the methods concurrently from several threads; each thread
+  passes its own number, from 0 to n_threads - 1, and thread 0 is the
+  thread that invoked parallel_scan().
+*/
+class Parallel_scan_visitor
+{
+public:
+  virtual ~Parallel_scan_visitor() = default;
+  /**
+    Start the scan in a thread.
+    @return the buffer in TableRecordFormat for the rows of the thread
+  */
+  virtual uchar *begin(uint thread)= 0;
+  /**
+    Process the row that was stored in the buffer of the thread.
+    @return true to stop the scan in all threads
+  */
+  virtual bool row(uint thread)= 0;
+  /** Finish the scan in a thread that called begin() */
+  virtual void end(uint thread)= 0;
+};
+
+
 /**
   The handler class is the interface for dynamically loadable
   storage engines. Do not add ifdefs and take care when adding or
@@ -3316,6 +3359,9 @@ class handler :public Sql_alloc
   Rowid_filter *save_pushed_rowid_filter;
   bool save_rowid_filter_is_active;
 
+  /* Filter pushed into table scans */
+  Scan_filter *pushed_scan_filter;
+
   Discrete_interval auto_inc_interval_for_cur_row;
   /**
      Number of reserved auto-increment intervals. Serves as a heuristic
@@ -3441,6 +3487,7 @@ class handler :public Sql_alloc
     rowid_filter_is_active(0),
     save_pushed_rowid_filter(NULL),
     save_rowid_filter_is_active(false),
+    pushed_scan_filter(NULL),
     auto_inc_intervals_count(0),
     m_psi(NULL),
     m_psi_batch_mode(PSI_BATCH_MODE_NONE),
@@ -4033,6 +4080,26 @@ class handler :public Sql_alloc
   virtual ha_rows estimate_rows_upper_bound()
   { return stats.records+EXTRA_RECORDS; }
 
+  /**
+    Whether parallel_scan() can be used for the table in its current
+    lock mode. It is called after the table has been locked.
+  */
+  virtual bool can_parallel_scan() { return false; }
+  /**
+    Read all rows of the table in several threads, each thread storing
+    the columns of table->read_set in its own record buffer. Called
+    between ha_rnd_init() and ha_rnd_end().
+    @param n_threads  maximum number of threads
+    @param visitor    consumer of the rows
+    @retval 0 on success
+    @retval HA_ERR_WRONG_COMMAND if the scan is not possible; the
+            visitor was not invoked and the caller should read the
+            rows with rnd_next()
+    @retval other error code
+  */
+  virtual int parallel_scan(uint n_threads, Parallel_scan_visitor *visitor)
+  { return HA_ERR_WRONG_COMMAND; }
+
   /**
     Get the row type from the storage engine.  If this method returns
     ROW_TYPE_NOT_USED, the information in HA_CREATE_INFO should be used.
@@ -4309,6 +4376,15 @@ class handler :public Sql_alloc
   virtual int pre_ft_end() { return 0; }
   virtual FT_INFO *ft_init_ext(uint flags, uint inx,String *key)
     { return NULL; }
+  /**
+    Initialize a full-text search of which only the most relevant
+    rows will be read.
+    @param limit  number of the most relevant rows that are needed,
+                  or HA_POS_ERROR if all matching rows will be read
+  */
+  virtual FT_INFO *ft_init_ext_with_limit(uint flags, uint inx, String *key,
+                                          ha_rows limit)
+    { return ft_init_ext(flags, inx, key); }
 public:
   virtual int ft_read(uchar *buf) { return HA_ERR_WRONG_COMMAND; }
   virtual int rnd_next(uchar *buf)=0;
@@ -4807,6 +4883,17 @@ class handler :public Sql_alloc
  }
 
  virtual bool rowid_filter_push(Rowid_filter *rowid_filter) { return true; }
+ /**
+   Push a filter into the table scans of the handler.
+
+   @param filter  the filter against which the rows are to be checked
+
+   @retval false  the filter is pushed; the rows that it rejects are
+                  not returned by rnd_next()
+   @retval true   the filter is not pushed
+ */
+ virtual bool scan_filter_push(Scan_filter *filter) { return true; }
+ virtual void cancel_pushed_scan_filter() { pushed_scan_filter= NULL; }
  /* Signal that rowid filter may have been enabled / disabled */
  virtual void rowid_filter_changed() {}
 
@@ -5439,6 +5526,7 @@ class handler :public Sql_alloc
   virtual void set_lock_type(enum thr_lock_type lock);
   friend check_result_t handler_index_cond_check(void* h_arg);
   friend check_result_t handler_rowid_filter_check(void *h_arg);
+  friend check_result_t handler_scan_filter_check(void *h_arg);
 
   /**
     Find unique record by index or unique constrain
@@ -3236,6 +3236,18 @@ bool Item_field::switch_to_nullable_fields_processor(void *arg)
   return 0;
 }
 
+/**
+  Bind the item to the fields of a copy of its table, which has its own
+  record buffer (see Parallel_aggregate)
+*/
+bool Item_field::switch_to_table_copy_processor(void *arg)
+{
+  TABLE *copy= (TABLE *) arg;
+  if (field && field->table != copy && field->table->s == copy->s)
+    field= copy->field[field->field_index];
+  return 0;
+}
+
 LEX_CSTRING Item_ident::full_name_cstring() const
 {
   char *tmp;
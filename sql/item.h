@@ -2248,6 +2248,7 @@ class Item :public Value_source,
   { return false; }
 
   virtual bool switch_to_nullable_fields_processor(void *arg) { return 0; }
+  virtual bool switch_to_table_copy_processor(void *arg) { return 0; }
   virtual bool find_function_processor (void *arg) { return 0; }
   /*
     Check if a partition function is allowed
@@ -3760,6 +3761,7 @@ class Item_field :public Item_ident,
   bool enumerate_field_refs_processor(void *arg) override;
   bool update_table_bitmaps_processor(void *arg) override;
   bool switch_to_nullable_fields_processor(void *arg) override;
+  bool switch_to_table_copy_processor(void *arg) override;
   bool update_vcol_processor(void *arg) override;
   bool rename_fields_processor(void *arg) override;
   bool check_vcol_func_processor(void *arg) override;
@@ -6205,7 +6205,9 @@ bool Item_func_match::init_search(THD *thd, bool no_order)
   if (key != NO_SUCH_KEY)
     THD_STAGE_INFO(table->in_use, stage_fulltext_initialization);
 
-  ft_handler= table->file->ft_init_ext(match_flags, key, ft_tmp);
+  ft_handler= table->file->ft_init_ext_with_limit(match_flags, key, ft_tmp,
+                                                  join_key ? ft_limit
+                                                  : HA_POS_ERROR);
 
   if (!ft_handler)
     DBUG_RETURN(1);
@@ -3677,10 +3677,15 @@ class Item_func_match :public Item_real_func
   Item *concat_ws;           // Item_func_concat_ws
   String value;              // value of concat_ws
   String search_value;       // key_item()'s value converted to cmp_collation
+  /*
+    Number of the most relevant rows that a full-text index scan
+    (join_key) must return, or HA_POS_ERROR. See get_ft_limit().
+  */
+  ha_rows ft_limit;
 
   Item_func_match(THD *thd, List<Item> &a, uint b):
     Item_real_func(thd, a), key(0), match_flags(b), join_key(0), ft_handler(0),
-    table(0), master(0), concat_ws(0) { }
+    table(0), master(0), concat_ws(0), ft_limit(HA_POS_ERROR) { }
   void cleanup() override
   {
     DBUG_ENTER("Item_func_match::cleanup");
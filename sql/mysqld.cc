@@ -495,6 +495,8 @@ ulong max_connections, max_connect_errors;
 uint max_password_errors;
 ulong extra_max_connections;
 uint max_digest_length= 0;
+ulong max_sort_threads;
+ulong max_parallel_query_threads;
 ulong slave_retried_transactions;
 ulong transactions_multi_engine;
 ulong rpl_transactions_multi_engine;
@@ -951,6 +953,7 @@ PSI_mutex_key key_LOCK_prepare_ordered, key_LOCK_commit_ordered;
 PSI_mutex_key key_TABLE_SHARE_LOCK_share;
 PSI_mutex_key key_TABLE_SHARE_LOCK_statistics;
 PSI_mutex_key key_LOCK_ack_receiver;
+PSI_mutex_key key_LOCK_sort_workers, key_LOCK_sort_output;
 
 PSI_mutex_key key_TABLE_SHARE_LOCK_rotation;
 PSI_cond_key key_TABLE_SHARE_COND_rotation;
@@ -1035,6 +1038,8 @@ static PSI_mutex_info all_server_mutexes[]=
   { &key_LOCK_rpl_thread_pool, "LOCK_rpl_thread_pool", 0},
   { &key_LOCK_parallel_entry, "LOCK_parallel_entry", 0},
   { &key_LOCK_ack_receiver, "Ack_receiver::mutex", 0},
+  { &key_LOCK_sort_workers, "Sort_workers::lock", 0},
+  { &key_LOCK_sort_output, "Sort_workers::output_lock", 0},
   { &key_LOCK_rpl_semi_sync_master_enabled, "LOCK_rpl_semi_sync_master_enabled", 0},
   { &key_LOCK_binlog, "LOCK_binlog", 0}
 };
@@ -1098,6 +1103,7 @@ PSI_cond_key key_COND_rpl_thread_queue, key_COND_rpl_thread,
   key_COND_prepare_ordered;
 PSI_cond_key key_COND_wait_gtid, key_COND_gtid_ignore_duplicates;
 PSI_cond_key key_COND_ack_receiver;
+PSI_cond_key key_COND_sort_workers;
 
 static PSI_cond_info all_server_conds[]=
 {
@@ -1145,6 +1151,7 @@ static PSI_cond_info all_server_conds[]=
   { &key_COND_wait_gtid, "COND_wait_gtid", 0},
   { &key_COND_gtid_ignore_duplicates, "COND_gtid_ignore_duplicates", 0},
   { &key_COND_ack_receiver, "Ack_receiver::cond", 0},
+  { &key_COND_sort_workers, "Sort_workers::cond", 0},
   { &key_COND_binlog_send, "COND_binlog_send", 0},
   { &key_TABLE_SHARE_COND_rotation, "TABLE_SHARE::COND_rotation", 0}
 };
@@ -1154,6 +1161,7 @@ PSI_thread_key key_thread_delayed_insert,
   key_thread_one_connection, key_thread_signal_hand,
   key_thread_slave_background, key_rpl_parallel_thread;
 PSI_thread_key key_thread_ack_receiver;
+PSI_thread_key key_thread_sort_worker;
 
 static PSI_thread_info all_server_threads[]=
 {
@@ -1164,6 +1172,7 @@ static PSI_thread_info all_server_threads[]=
   { &key_thread_signal_hand, "signal_handler", PSI_FLAG_GLOBAL},
   { &key_thread_slave_background, "slave_background", PSI_FLAG_GLOBAL},
   { &key_thread_ack_receiver, "Ack_receiver", PSI_FLAG_GLOBAL},
+  { &key_thread_sort_worker, "sort_worker", 0},
   { &key_rpl_parallel_thread, "rpl_parallel_thread", 0}
 };
 
@@ -7497,6 +7506,7 @@ SHOW_VAR status_vars[]= {
   {"Opened_table_definitions", (char*) offsetof(STATUS_VAR, opened_shares), SHOW_LONG_STATUS},
   {"Opened_tables",            (char*) offsetof(STATUS_VAR, opened_tables), SHOW_LONG_STATUS},
   {"Opened_views",             (char*) offsetof(STATUS_VAR, opened_views), SHOW_LONG_STATUS},
+  {"Parallel_query_helper_threads", (char*) offsetof(STATUS_VAR, parallel_query_helper_threads), SHOW_LONG_STATUS},
   {"Prepared_stmt_count",      (char*) &show_prepared_stmt_count, SHOW_SIMPLE_FUNC},
   {"Rows_sent",                (char*) offsetof(STATUS_VAR, rows_sent), SHOW_LONGLONG_STATUS},
   {"Rows_read",                (char*) offsetof(STATUS_VAR, rows_read), SHOW_LONGLONG_STATUS},
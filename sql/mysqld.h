@@ -229,6 +229,8 @@ extern ulong query_cache_min_res_unit;
 extern ulong slow_launch_threads, slow_launch_time;
 extern MYSQL_PLUGIN_IMPORT ulong max_connections;
 extern uint max_digest_length;
+extern ulong max_sort_threads;
+extern ulong max_parallel_query_threads;
 extern ulong max_connect_errors, connect_timeout;
 extern uint max_password_errors;
 extern my_bool slave_allow_batching;
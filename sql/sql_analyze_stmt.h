@@ -254,6 +254,30 @@ class Table_access_tracker
 };
 
 
+/*
+  A class for collecting statistics about a hash join that has spilled
+  the records of both its operands to partition files on disk.
+*/
+
+class Join_spill_tracker
+{
+public:
+  Join_spill_tracker() :
+    r_spills(0), r_partitions(0), r_outer_rows(0), r_inner_rows(0),
+    r_bytes(0), r_refills(0)
+  {}
+
+  ha_rows r_spills;     /* how many times the join was partitioned */
+  uint r_partitions;    /* the largest number of partitions used */
+  ha_rows r_outer_rows; /* partial join records written to the partitions */
+  ha_rows r_inner_rows; /* records of the joined table written */
+  ulonglong r_bytes;    /* total size of the data written */
+  ha_rows r_refills;    /* join buffer refills from the partitions */
+
+  bool has_spilled() const { return (r_spills != 0); }
+};
+
+
 class Json_writer;
 
 /*
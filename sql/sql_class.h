@@ -757,6 +757,8 @@ typedef struct system_variables
   ulong max_length_for_sort_data;
   ulong max_recursive_iterations;
   ulong max_sort_length;
+  ulong sort_threads;
+  ulong parallel_query_threads;
   ulong max_insert_delayed_threads;
   ulong min_examined_row_limit;
   ulong net_buffer_length;
@@ -986,6 +988,7 @@ typedef struct system_status_var
   ulong filesort_scan_count_;
   ulong filesort_pq_sorts_;
   ulong optimizer_join_prefixes_check_calls;
+  ulong parallel_query_helper_threads;
 
   /* Features used */
   ulong feature_custom_aggregate_functions; /* +1 when custom aggregate
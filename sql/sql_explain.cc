@@ -1895,6 +1895,9 @@ void Explain_table_access::tag_to_json(Json_writer *writer,
     case ET_TABLE_FUNCTION:
       writer->add_member("table_function").add_str("json_table");
       break;
+    case ET_PARALLEL_SCAN:
+      writer->add_member("parallel_threads").add_ll(parallel_threads);
+      break;
 
     default:
       DBUG_ASSERT(0);
@@ -2161,6 +2164,8 @@ void Explain_table_access::print_explain_json(Explain_query *query,
     writer->add_member("join_type").add_str(bka_type.join_alg);
     if (bka_type.mrr_type.length())
       writer->add_member("mrr_type").add_str(bka_type.mrr_type);
+    if (bka_type.spill)
+      writer->add_member("spill_to_disk").add_bool(true);
     if (where_cond)
     {
       writer->add_member("attached_condition");
@@ -2204,6 +2209,20 @@ void Explain_table_access::print_explain_json(Explain_query *query,
       else
         writer->add_null();
 
+      if (jbuf_spill_tracker.has_spilled())
+      {
+        writer->add_member("r_spill").start_object();
+        writer->add_member("r_spills").add_ll(jbuf_spill_tracker.r_spills);
+        writer->add_member("r_partitions").
+          add_ll(jbuf_spill_tracker.r_partitions);
+        writer->add_member("r_outer_rows").
+          add_ll(jbuf_spill_tracker.r_outer_rows);
+        writer->add_member("r_inner_rows").
+          add_ll(jbuf_spill_tracker.r_inner_rows);
+        writer->add_member("r_bytes").add_ull(jbuf_spill_tracker.r_bytes);
+        writer->add_member("r_refills").add_ll(jbuf_spill_tracker.r_refills);
+        writer->end_object(); // "r_spill"
+      }
     }
   }
 
@@ -2363,6 +2382,11 @@ void Explain_table_access::append_tag_name(String *str, enum explain_extra_tag t
       str->append(STRING_WITH_LEN("Table function: json_table"));
       break;
     }
+    case ET_PARALLEL_SCAN:
+      str->append(STRING_WITH_LEN("Parallel scan ("));
+      str->append_ulonglong(parallel_threads);
+      str->append(STRING_WITH_LEN(" threads)"));
+      break;
     default:
      str->append(extra_tag_text[tag]);
   }
@@ -592,6 +592,7 @@ enum explain_extra_tag
   ET_UNIQUE_ROW_NOT_FOUND,
   ET_IMPOSSIBLE_ON_CONDITION,
   ET_TABLE_FUNCTION,
+  ET_PARALLEL_SCAN,
 
   ET_total
 };
@@ -604,7 +605,7 @@ enum explain_extra_tag
 class EXPLAIN_BKA_TYPE
 {
 public:
-  EXPLAIN_BKA_TYPE() : join_alg(NULL) {}
+  EXPLAIN_BKA_TYPE() : join_alg(NULL), spill(false) {}
 
   size_t join_buffer_size;
 
@@ -618,6 +619,9 @@ class EXPLAIN_BKA_TYPE
 
   /* Information about MRR usage.  */
   StringBuffer<64> mrr_type;
+
+  /* TRUE if the hash join may partition its operands to disk */
+  bool spill;
   
   bool is_using_jbuf() { return (join_alg != NULL); }
 };
@@ -813,6 +817,8 @@ class Explain_table_access : public Sql_alloc
   bool filtered_set; /* not set means 'NULL' should be printed */
   // Valid if ET_USING_INDEX_FOR_GROUP_BY is present
   bool loose_scan_is_scanning;
+  // Valid if ET_PARALLEL_SCAN is present
+  uint parallel_threads;
   
   /*
     Index use: key name and length.
@@ -921,6 +927,9 @@ class Explain_table_access : public Sql_alloc
   /* When using join buffer: Track the number of incoming record combinations */
   Counter_tracker jbuf_loops_tracker;
 
+  /* When using join buffer: Track the partitioning of a hash join to disk */
+  Join_spill_tracker jbuf_spill_tracker;
+
   Explain_rowid_filter *rowid_filter;
 
   int print_explain(select_result_sink *output, uint8 explain_flags, 
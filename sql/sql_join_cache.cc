@@ -3513,7 +3513,10 @@ int JOIN_TAB_SCAN::open()
     match some records in the buffer of the join cache 'cache'. To do
     this the function calls the function that scans table records and
     looks for the next one that meets the condition pushed to the
-    joined table join_tab.
+    joined table join_tab. Records that are rejected by the key filter
+    of the join cache are skipped without evaluating this condition.
+    If the key filter has been pushed into the scan, such records are
+    skipped by the storage engine and never reach this function.
 
   NOTES
     The function catches the signal that kills the query.
@@ -3541,13 +3544,21 @@ int JOIN_TAB_SCAN::next()
     join_tab->tracker->r_rows++;
   }
 
-  while (!err && select && (skip_rc= select->skip_record(thd)) <= 0)
+  while (!err)
   {
-    if (unlikely(thd->check_killed()) || skip_rc < 0)
+    if (cache->check_key_filter())
+    {
+      if (!select || (skip_rc= select->skip_record(thd)) > 0)
+        break;
+      if (skip_rc < 0)
+        return 1;
+    }
+    if (unlikely(thd->check_killed()))
       return 1;
     /* 
-      Move to the next record if the last retrieved record does not
-      meet the condition pushed to the table join_tab.
+      Move to the next record if the last retrieved record cannot match
+      any record from the join buffer or does not meet the condition
+      pushed to the table join_tab.
     */
     err= info->read_record();
     if (!err)
@@ -3958,13 +3969,790 @@ int JOIN_CACHE_BNLH::init(bool for_explain)
 {
   DBUG_ENTER("JOIN_CACHE_BNLH::init");
 
-  if (!(join_tab_scan= new JOIN_TAB_SCAN(join, join_tab)))
+  if (!(join_tab_scan= new JOIN_TAB_SCAN(join, join_tab)) ||
+      !(spill_scan= new JOIN_TAB_SCAN_SPILL(join, join_tab)))
     DBUG_RETURN(1);
 
-  DBUG_RETURN(JOIN_CACHE_HASHED::init(for_explain));
+  if (JOIN_CACHE_HASHED::init(for_explain))
+    DBUG_RETURN(1);
+
+  if (for_explain)
+    DBUG_RETURN(0);
+
+  /* Mark the fields of join_tab the key filter is to be pushed with */
+  uint n_fields= join_tab->table->s->fields;
+  my_bitmap_map *bitmap_buff;
+  if (!(bitmap_buff= (my_bitmap_map *)
+                     join->thd->alloc(bitmap_buffer_size(n_fields))) ||
+      my_bitmap_init(&key_filter_fields, bitmap_buff, n_fields))
+    DBUG_RETURN(1);
+  KEY_PART_INFO *key_part= ref_key_info->key_part;
+  KEY_PART_INFO *key_part_end= key_part+ref_used_key_parts;
+  for ( ; key_part < key_part_end; key_part++)
+    bitmap_set_bit(&key_filter_fields, key_part->field->field_index);
+
+  DBUG_RETURN(0);
+}
+
+
+/* The maximum number of partitions of a BNLH join spilled to disk is 2^6 */
+#define JOIN_SPILL_MAX_PART_BITS 6
+/* The size of the buffer of a partition file */
+#define JOIN_SPILL_FILE_BUFF_SIZE (4*IO_SIZE)
+
+
+/* 
+  Check whether the operands of a BNLH join may be partitioned to disk
+
+  SYNOPSIS
+    can_spill()
+
+  DESCRIPTION
+    When the join buffer of a BNLH join cache gets full the records from
+    the buffer and the records of join_tab can be written to partition
+    files by the hash of their join keys, after which the partitions are
+    joined one by one (grace hash join). Then join_tab is scanned only
+    once instead of once per refill of the join buffer.
+    The function checks whether the optimizer has costed the join this way
+    (join_tab->spill_to_disk, set by best_access_path() when the optimizer
+    switch 'hash_join_spill' is on), and whether this is supported for the
+    cache: the cache must not be linked to other caches, and neither the
+    records from the buffer nor the records of join_tab may contain blob values
+    since these values are not stored in the record images written
+    to the partition files. The rowids of the records of join_tab cannot
+    be restored from the partition files either.
+    The optimizer sets join_tab->spill_to_disk only if these conditions
+    hold (see hash_join_spill_is_possible() and check_join_cache_usage()),
+    so a join costed as partitioned to disk is executed this way.
+
+  RETURN VALUE
+    TRUE    the operands may be partitioned to disk
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::can_spill()
+{
+  return get_join_alg() == BNLH_JOIN_ALG && join_tab->spill_to_disk &&
+         !prev_cache && !next_cache && !blobs &&
+         !join_tab->table->s->blob_fields &&
+         !join_tab->keep_current_rowid && !join_tab->bush_children;
+}
+
+
+/* 
+  Get the partition of a join key value
+
+  SYNOPSIS
+    get_spill_part()
+      key   the join key value
+
+  DESCRIPTION
+    The function returns the number of the partition for the records with
+    the join key value 'key'. The function key_hashnr returns the same hash
+    value for any two keys that are considered equal by the hash table of
+    the join buffer. As the index of an entry in this hash table is derived
+    from the low bits of the hash value, the partition number is taken
+    from the high bits of the hash value multiplied by the golden ratio.
+
+  RETURN VALUE
+    the number of the partition for the key
+*/
+
+uint JOIN_CACHE_BNLH::get_spill_part(const uchar *key)
+{
+  ulonglong nr= key_hashnr(ref_key_info, ref_used_key_parts, key);
+  return (uint) ((nr * 0x9E3779B97F4A7C15ULL) >> (64 - spill_part_bits));
+}
+
+
+/* 
+  Create the partition files for a BNLH join spilled to disk
+
+  SYNOPSIS
+    start_spill()
+
+  DESCRIPTION
+    The function is called when the join buffer gets full for the first
+    time. It chooses the number of partitions such that a partition of the
+    partial join records is expected to fit into the join buffer. The
+    expected number of the partial join records is taken from the plan,
+    while the number of the records that fit into the buffer is the number
+    of records that are currently in the buffer.
+    Then the function creates the files for the partial join records and
+    for the records of join_tab.
+
+  RETURN VALUE
+    FALSE   the partition files have been created 
+    TRUE    otherwise
+*/
+
+bool JOIN_CACHE_BNLH::start_spill()
+{
+  double parts= join_tab->join_loops / (double) MY_MAX(records, 1);
+  DBUG_ENTER("JOIN_CACHE_BNLH::start_spill");
+
+  for (spill_part_bits= 1;
+       spill_part_bits < JOIN_SPILL_MAX_PART_BITS &&
+       (double) (1U << spill_part_bits) < parts;
+       spill_part_bits++) ;
+  spill_parts= 1U << spill_part_bits;
+
+  if (!(spill_files= (IO_CACHE *) my_malloc(key_memory_JOIN_CACHE,
+                                            2*spill_parts*sizeof(IO_CACHE),
+                                            MYF(MY_THREAD_SPECIFIC |
+                                                MY_ZEROFILL | MY_WME))) ||
+      !(spill_rec_buff= (uchar *) my_malloc(key_memory_JOIN_CACHE,
+                                            pack_length+fields*sizeof(uint),
+                                            MYF(MY_THREAD_SPECIFIC |
+                                                MY_WME))))
+    DBUG_RETURN(TRUE);
+
+  for (uint i= 0; i < 2*spill_parts; i++)
+  {
+    if (open_cached_file(spill_files+i, mysql_tmpdir, TEMP_PREFIX,
+                         JOIN_SPILL_FILE_BUFF_SIZE, MYF(MY_WME)))
+      DBUG_RETURN(TRUE);
+  }
+
+  spill_state= SPILL_WRITING;
+  spill_inner_done= FALSE;
+  join_tab->jbuf_spill_tracker->r_spills++;
+  set_if_bigger(join_tab->jbuf_spill_tracker->r_partitions, spill_parts);
+  DBUG_PRINT("info", ("partitions: %u", spill_parts));
+  DBUG_RETURN(FALSE);
+}
+
+
+/* 
+  Remove the partition files of a BNLH join spilled to disk
+
+  SYNOPSIS
+    end_spill()
+
+  DESCRIPTION
+    The function closes the partition files, which deletes them, and frees
+    the memory allocated for the partitioning. After this the cache joins
+    the records in the join buffer only again.
+
+  RETURN VALUE
+    none
+*/
+
+void JOIN_CACHE_BNLH::end_spill()
+{
+  if (spill_files)
+  {
+    for (uint i= 0; i < 2*spill_parts; i++)
+      close_cached_file(spill_files+i);
+    my_free(spill_files);
+    spill_files= 0;
+  }
+  my_free(spill_rec_buff);
+  spill_rec_buff= 0;
+  spill_state= SPILL_NONE;
+  spill_failed= FALSE;
+}
+
+
+/* 
+  Write all records from the join buffer to the partition files
+
+  SYNOPSIS
+    spill_buffered_records()
+
+  DESCRIPTION
+    The function reads the records from the join buffer one by one and
+    writes the image of the fields of each record to the file of the
+    partition of its join key. The key is built in the same way as when the
+    record has been put into the hash table of the buffer. The image is
+    prepended by its length. After this the buffer is reset for writing.
+
+  RETURN VALUE
+    FALSE   all records have been written 
+    TRUE    otherwise
+*/
+
+bool JOIN_CACHE_BNLH::spill_buffered_records()
+{
+  Join_spill_tracker *tracker= join_tab->jbuf_spill_tracker;
+  TABLE_REF *ref= &join_tab->ref;
+  DBUG_ENTER("JOIN_CACHE_BNLH::spill_buffered_records");
+
+  reset(FALSE);
+  while (!get_record())
+  {
+    uchar *key;
+    uchar len_buff[4];
+    ulong len= (ulong) (pos-curr_rec_pos);
+
+    if (use_emb_key)
+      key= get_curr_emb_key();
+    else
+    {
+      cp_buffer_from_ref(join->thd, join_tab->table, ref);
+      key= ref->key_buff;
+    }
+
+    IO_CACHE *file= spill_files+get_spill_part(key);
+    int4store(len_buff, len);
+    if (my_b_write(file, len_buff, sizeof(len_buff)) ||
+        my_b_write(file, curr_rec_pos, len))
+      DBUG_RETURN(TRUE);
+
+    tracker->r_outer_rows++;
+    tracker->r_bytes+= sizeof(len_buff)+len;
+  }
+  restore_last_record();
+  reset(TRUE);
+  DBUG_RETURN(FALSE);
+}
+
+
+/* 
+  Write the current record of join_tab to its partition file
+
+  SYNOPSIS
+    spill_inner_record()
+      part  OUT the partition of the record
+
+  DESCRIPTION
+    The function builds the join key over the record of join_tab in the
+    record buffer in the same way as when the matching records are looked
+    up in the hash table of the join buffer, and writes the record to the
+    file of the partition of this key.
+
+  RETURN VALUE
+    0   the record has been written 
+    1   otherwise
+*/
+
+int JOIN_CACHE_BNLH::spill_inner_record(uint *part)
+{
+  TABLE *table= join_tab->table;
+  Join_spill_tracker *tracker= join_tab->jbuf_spill_tracker;
+
+  key_copy(key_buff, table->record[0], ref_key_info, key_length, TRUE);
+  *part= get_spill_part(key_buff);
+  if (my_b_write(spill_files+spill_parts+*part, table->record[0],
+                 table->s->reclength))
+    return 1;
+
+  tracker->r_inner_rows++;
+  tracker->r_bytes+= table->s->reclength;
+  return 0;
+}
+
+
+/* 
+  Refill the join buffer with records from a partition file
+
+  SYNOPSIS
+    load_spilled_records()
+      file  the partition file to read the partial join records from
+      eof   OUT set to TRUE if the end of the file has been reached
+
+  DESCRIPTION
+    The function reads the images of the partial join records from the
+    partition file 'file' starting from the current position, unpacks
+    the fields of each record into the record buffers and puts the record
+    into the join buffer until the buffer gets full or the file is
+    exhausted.
+
+  RETURN VALUE
+    FALSE   the buffer has been refilled 
+    TRUE    a read error has occurred
+*/
+
+bool JOIN_CACHE_BNLH::load_spilled_records(IO_CACHE *file, bool *eof)
+{
+  bool is_full= FALSE;
+  DBUG_ENTER("JOIN_CACHE_BNLH::load_spilled_records");
+
+  *eof= FALSE;
+  while (!is_full)
+  {
+    uchar len_buff[4];
+    if (my_b_read(file, len_buff, sizeof(len_buff)))
+    {
+      *eof= TRUE;
+      DBUG_RETURN(file->error == -1);
+    }
+    ulong len= uint4korr(len_buff);
+    if (len > pack_length+fields*sizeof(uint) ||
+        my_b_read(file, spill_rec_buff, len))
+      DBUG_RETURN(TRUE);
+
+    /* Unpack the fields of the record into the record buffers */
+    uchar *save_pos= pos;
+    pos= spill_rec_buff;
+    read_flag_fields();
+    CACHE_FIELD *copy= field_descr+flag_fields;
+    CACHE_FIELD *copy_end= field_descr+fields;
+    for ( ; copy < copy_end; copy++)
+      read_record_field(copy, FALSE);
+    pos= save_pos;
+
+    is_full= JOIN_CACHE_HASHED::put_record();
+  }
+  DBUG_RETURN(FALSE);
+}
+
+
+/* 
+  Add a record into the buffer of a BNLH join cache
+
+  SYNOPSIS
+    put_record()
+
+  DESCRIPTION
+    This implementation of the virtual function put_record adds the record
+    into the join buffer as the implementation for JOIN_CACHE_HASHED does.
+    If after this the buffer is full and the join operands may be partitioned
+    to disk, then the records from the buffer are written to the partition
+    files, which are created when the buffer gets full for the first time,
+    and the buffer is reset to accept new records. 
+    
+  RETURN VALUE
+    TRUE    if it has been decided that it should be the last record
+            in the join buffer, or if the records could not be written
+            to the partition files
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::put_record()
+{
+  bool is_full= JOIN_CACHE_HASHED::put_record();
+
+  if (!is_full || spill_state == SPILL_READING || !can_spill())
+    return is_full;
+
+  if ((spill_state == SPILL_NONE && start_spill()) ||
+      spill_buffered_records())
+  {
+    spill_failed= TRUE;
+    return TRUE;
+  }
+  return FALSE;
+}
+
+
+/* 
+  Join records from a BNLH join buffer with records from the next join table
+
+  SYNOPSIS
+    join_records()
+      skip_last    do not find matches for the last record from the buffer
+
+  DESCRIPTION
+    If the records from the join buffer have been partitioned to disk the
+    function joins the partitions one by one. Otherwise the function joins
+    the records from the join buffer as the default implementation does.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state, except NESTED_LOOP_NO_MORE_ROWS.
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::join_records(bool skip_last)
+{
+  if (spill_state == SPILL_NONE && !spill_failed)
+    return JOIN_CACHE::join_records(skip_last);
+  DBUG_ASSERT(!skip_last);
+  return join_spilled_records();
+}
+
+
+/* 
+  Join the partitions of the operands of a BNLH join one by one
+
+  SYNOPSIS
+    join_spilled_records()
+
+  DESCRIPTION
+    The function writes the records remaining in the join buffer to the
+    partition files. Then for each partition it refills the join buffer with
+    the partial join records of the partition, as many times as needed, and
+    joins them with the records of join_tab from the same partition. For
+    this the iterator over join_tab is replaced by an iterator of the class
+    JOIN_TAB_SCAN_SPILL. The first scan of this iterator over join_tab
+    writes the records of join_tab to the partition files. The following
+    scans read the records from the file of the current partition.
+    Empty partitions of the partial join records are skipped: there are
+    neither matches nor null complemented extensions to be generated
+    for them.
+    When all partitions have been joined the partition files are removed.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state, except NESTED_LOOP_NO_MORE_ROWS.
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::join_spilled_records()
+{
+  enum_nested_loop_state rc= NESTED_LOOP_ERROR;
+  JOIN_TAB_SCAN *save_join_tab_scan= join_tab_scan;
+  DBUG_ENTER("JOIN_CACHE_BNLH::join_spilled_records");
+
+  if (spill_failed || (records && spill_buffered_records()))
+    goto finish;
+
+  for (uint i= 0; i < spill_parts; i++)
+  {
+    if (reinit_io_cache(spill_files+i, READ_CACHE, 0L, 0, 0))
+      goto finish;
+  }
+
+  spill_state= SPILL_READING;
+  join_tab_scan= spill_scan;
+  rc= NESTED_LOOP_OK;
+
+  for (spill_curr_part= 0; spill_curr_part < spill_parts; spill_curr_part++)
+  {
+    bool eof= FALSE;
+    while (!eof)
+    {
+      if (load_spilled_records(spill_files+spill_curr_part, &eof))
+      {
+        rc= NESTED_LOOP_ERROR;
+        goto finish;
+      }
+      if (!records)
+        break;
+      join_tab->jbuf_spill_tracker->r_refills++;
+      rc= JOIN_CACHE::join_records(FALSE);
+      if (rc != NESTED_LOOP_OK && rc != NESTED_LOOP_NO_MORE_ROWS)
+        goto finish;
+    }
+  }
+
+finish:
+  join_tab_scan= save_join_tab_scan;
+  end_spill();
+  reset(TRUE);
+  DBUG_RETURN(rc);
+}
+
+
+/* 
+  Free the join buffer of a BNLH join cache
+
+  SYNOPSIS
+    free()
+
+  DESCRIPTION
+    Additionally to what the default implementation does this function
+    frees the memory of the key filter and removes the partition files
+    that might be left if the execution of the join has been interrupted.
+
+  RETURN VALUE
+    none
+*/
+
+void JOIN_CACHE_BNLH::free()
+{
+  end_spill();
+  my_free(key_filter);
+  key_filter= 0;
+  key_filter_size= 0;
+  key_filter_active= FALSE;
+  JOIN_CACHE::free();
+}
+
+
+/* 
+  Save data on the join algorithm employed by a BNLH join cache
+
+  SYNOPSIS
+    save_explain_data()
+      explain  the data structure to save the info to
+
+  DESCRIPTION
+    Additionally to what the default implementation does this function
+    notes whether the join operands may be partitioned to disk.
+
+  RETURN VALUE
+   0 ok
+   1 error
+*/
+
+bool JOIN_CACHE_BNLH::save_explain_data(EXPLAIN_BKA_TYPE *explain)
+{
+  if (JOIN_CACHE::save_explain_data(explain))
+    return 1;
+  explain->spill= can_spill();
+  return 0;
+}
+
+
+/* The number of bits set in the key filter of a BNLH cache for each key */
+#define JOIN_KEY_FILTER_BITS_PER_KEY 8
+/* The minimum number of checks before the key filter may be switched off */
+#define JOIN_KEY_FILTER_MIN_CHECKS 1024
+
+
+/* 
+  Build the Bloom filter over the join keys in the buffer of a BNLH cache
+
+  SYNOPSIS
+    build_key_filter()
+
+  DESCRIPTION
+    The function is called when the join buffer has been filled and the
+    records of join_tab are about to be matched against the records from
+    the buffer. If this is allowed by the optimizer switch
+    'hash_join_bloom_filter' the function builds a Bloom filter over the
+    hash values of all distinct join keys in the hash table of the buffer.
+    The filter has JOIN_KEY_FILTER_BITS_PER_KEY bits per key, rounded up
+    to a power of 2, and two bits are set for each key. The function
+    key_hashnr is used as it returns the same value for any two keys that
+    are considered equal by the hash table. 
+    The filter is not built while the records of join_tab are being
+    partitioned to disk, as then all records of join_tab must be written
+    to the partition files.
+
+  RETURN VALUE
+    none
+*/
+
+void JOIN_CACHE_BNLH::build_key_filter()
+{
+  uchar *key;
+  DBUG_ENTER("JOIN_CACHE_BNLH::build_key_filter");
+
+  key_filter_active= FALSE;
+  if (get_join_alg() != BNLH_JOIN_ALG || !key_entries ||
+      !optimizer_flag(join->thd, OPTIMIZER_SWITCH_HASH_JOIN_BLOOM_FILTER) ||
+      (spill_state == SPILL_READING && !spill_inner_done))
+    DBUG_VOID_RETURN;
+
+  size_t size= my_round_up_to_next_power((uint32) key_entries) *
+               JOIN_KEY_FILTER_BITS_PER_KEY / 8;
+  set_if_bigger(size, 64);
+  if (size > key_filter_size)
+  {
+    my_free(key_filter);
+    key_filter_size= 0;
+    if (!(key_filter= (uchar *) my_malloc(key_memory_JOIN_CACHE, size,
+                                          MYF(MY_THREAD_SPECIFIC))))
+      DBUG_VOID_RETURN;
+    key_filter_size= size;
+  }
+  bzero(key_filter, size);
+  key_filter_mask= size*8 - 1;
+
+  reset(FALSE);
+  while (get_next_key(&key))
+  {
+    ulonglong nr= key_hashnr(ref_key_info, ref_used_key_parts, key) *
+                  0x9E3779B97F4A7C15ULL;
+    ulonglong bit1= nr & key_filter_mask;
+    ulonglong bit2= (nr >> 32) & key_filter_mask;
+    key_filter[bit1 >> 3]|= (uchar) (1 << (bit1 & 7));
+    key_filter[bit2 >> 3]|= (uchar) (1 << (bit2 & 7));
+  }
+  reset(FALSE);
+
+  key_filter_checks= key_filter_rejects= 0;
+  key_filter_active= TRUE;
+  DBUG_VOID_RETURN;
+}
+
+
+/* 
+  Check the record of join_tab against the key filter of a BNLH cache
+
+  SYNOPSIS
+    check_key_filter()
+
+  DESCRIPTION
+    This implementation of the virtual function check_key_filter checks
+    the record of join_tab in the record buffer against the Bloom filter
+    over the join keys in the join buffer, unless the filter has been
+    pushed into the scan of join_tab and the storage engine has already
+    checked the record.
+
+  RETURN VALUE
+    TRUE    the record may have matches in the join buffer
+    FALSE   the record has no matches in the join buffer
+*/
+
+bool JOIN_CACHE_BNLH::check_key_filter()
+{
+  return key_filter_pushed || check_key_filter_record();
 }
 
 
+/* 
+  Check the record of join_tab against the Bloom filter of a BNLH cache
+
+  SYNOPSIS
+    check_key_filter_record()
+
+  DESCRIPTION
+    The function builds the join key over the record of join_tab in the
+    record buffer and checks its hash value against the Bloom filter over
+    the join keys in the join buffer. If the filter rejects less than one
+    record out of 8 after JOIN_KEY_FILTER_MIN_CHECKS checks, it is not
+    worth checking, and the filter is switched off until the buffer is
+    refilled.
+    When the filter is pushed into the scan of join_tab the function is
+    called by the storage engine through Scan_filter::check() as soon as
+    the fields of key_filter_fields are in the record buffer.
+
+  RETURN VALUE
+    TRUE    the record may have matches in the join buffer
+    FALSE   the record has no matches in the join buffer
+*/
+
+bool JOIN_CACHE_BNLH::check_key_filter_record()
+{
+  if (!key_filter_active)
+    return TRUE;
+
+  if (++key_filter_checks == JOIN_KEY_FILTER_MIN_CHECKS &&
+      key_filter_rejects < JOIN_KEY_FILTER_MIN_CHECKS / 8)
+  {
+    key_filter_active= FALSE;
+    return TRUE;
+  }
+
+  key_copy(key_buff, join_tab->table->record[0], ref_key_info, key_length,
+           TRUE);
+  ulonglong nr= key_hashnr(ref_key_info, ref_used_key_parts, key_buff) *
+                0x9E3779B97F4A7C15ULL;
+  ulonglong bit1= nr & key_filter_mask;
+  ulonglong bit2= (nr >> 32) & key_filter_mask;
+  if ((key_filter[bit1 >> 3] & (1 << (bit1 & 7))) &&
+      (key_filter[bit2 >> 3] & (1 << (bit2 & 7))))
+    return TRUE;
+
+  key_filter_rejects++;
+  return FALSE;
+}
+
+
+/* 
+  Find matches from the next table for records from a BNLH join buffer
+
+  SYNOPSIS
+    join_matching_records()
+      skip_last    do not look for matches for the last partial join record 
+
+  DESCRIPTION
+    This implementation of the virtual function join_matching_records
+    builds the key filter over the join keys in the buffer before it calls
+    the default implementation, and switches the filter off after this.
+    If join_tab is read by a table scan the filter is pushed into the
+    scan, so that the storage engine skips the records it rejects before
+    it converts them into the record format of the server.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::join_matching_records(bool skip_last)
+{
+  enum_nested_loop_state rc;
+  handler *file= join_tab->table->file;
+  build_key_filter();
+  key_filter_pushed= key_filter_active && spill_state != SPILL_READING &&
+                     join_tab->type == JT_HASH &&
+                     !(join_tab->select && join_tab->select->quick) &&
+                     !file->scan_filter_push(this);
+  rc= JOIN_CACHE::join_matching_records(skip_last);
+  if (key_filter_pushed)
+  {
+    file->cancel_pushed_scan_filter();
+    key_filter_pushed= FALSE;
+  }
+  key_filter_active= FALSE;
+  return rc;
+}
+
+
+/* 
+  Initiate an iteration over the records of the joined table partitioned
+  to disk
+
+  SYNOPSIS
+    open()
+
+  DESCRIPTION
+    If the records of the joined table have not been written to the
+    partition files yet the function starts a regular scan over the table.
+    Otherwise it positions the file of the current partition at its
+    beginning.
+
+  RETURN VALUE   
+    0            the initiation is a success 
+    error code   otherwise     
+*/
+
+int JOIN_TAB_SCAN_SPILL::open()
+{
+  JOIN_CACHE_BNLH *bnlh= (JOIN_CACHE_BNLH *) cache;
+
+  if (!bnlh->spill_inner_done)
+    return JOIN_TAB_SCAN::open();
+
+  save_or_restore_used_tabs(join_tab, FALSE);
+  join_tab->table->null_row= 0;
+  return MY_TEST(reinit_io_cache(bnlh->spill_files + bnlh->spill_parts +
+                                 bnlh->spill_curr_part,
+                                 READ_CACHE, 0L, 0, 0));
+}
+
+
+/* 
+  Read the next record of the joined table from the current partition
+
+  SYNOPSIS
+    next()
+
+  DESCRIPTION
+    During the first scan over the joined table the function writes each
+    record of the table that meets the condition pushed to the table to the
+    file of its partition, skipping the records that do not belong to the
+    current partition. During the following scans the function reads the
+    records of the current partition from its file.
+
+  RETURN VALUE   
+    0            the next record exists and has been successfully read 
+    -1           there are no more records
+    error code   otherwise     
+*/
+
+int JOIN_TAB_SCAN_SPILL::next()
+{
+  JOIN_CACHE_BNLH *bnlh= (JOIN_CACHE_BNLH *) cache;
+  int err;
+
+  if (bnlh->spill_inner_done)
+  {
+    IO_CACHE *file= bnlh->spill_files + bnlh->spill_parts +
+                    bnlh->spill_curr_part;
+    do
+    {
+      if (my_b_read(file, join_tab->table->record[0],
+                    join_tab->table->s->reclength))
+        return file->error == -1 ? 1 : -1;
+    } while (!bnlh->check_key_filter());
+    return 0;
+  }
+
+  while (!(err= JOIN_TAB_SCAN::next()))
+  {
+    uint part;
+    if (bnlh->spill_inner_record(&part))
+      return 1;
+    if (part == bnlh->spill_curr_part)
+      return 0;
+  }
+  if (err < 0)
+    bnlh->spill_inner_done= TRUE;
+  return err;
+}
+
+
+
 /* 
   Calculate the increment of the MRR buffer for a record write       
 
@@ -459,6 +459,12 @@ class JOIN_CACHE :public Sql_alloc
   */
   virtual bool skip_if_not_needed_match();
 
+  /*
+    Shall check whether the record of join_tab in the record buffer
+    may have matches in the join buffer
+  */
+  virtual bool check_key_filter() { return TRUE; }
+
   /* 
     True if rec_ptr points to the record whose blob data stay in
     record buffers
@@ -671,7 +677,7 @@ class JOIN_CACHE :public Sql_alloc
   }
      
   /* Join records from the join buffer with records from the next join table */ 
-  enum_nested_loop_state join_records(bool skip_last);
+  virtual enum_nested_loop_state join_records(bool skip_last);
 
   /* Add a comment on the join algorithm employed by the join cache */
   virtual bool save_explain_data(EXPLAIN_BKA_TYPE *explain);
@@ -680,7 +686,7 @@ class JOIN_CACHE :public Sql_alloc
 
   virtual ~JOIN_CACHE() = default;
   void reset_join(JOIN *j) { join= j; }
-  void free()
+  virtual void free()
   { 
     my_free(buff);
     buff= 0;
@@ -691,6 +697,7 @@ class JOIN_CACHE :public Sql_alloc
   friend class JOIN_CACHE_BKA;
   friend class JOIN_TAB_SCAN;
   friend class JOIN_TAB_SCAN_MRR;
+  friend class JOIN_TAB_SCAN_SPILL;
 
 };
 
@@ -1156,9 +1163,99 @@ class JOIN_CACHE_BNL :public JOIN_CACHE
   employed to perform a join operation   
 */
 
-class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
+class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED, public Scan_filter
 {
 
+private:
+
+  /* 
+    The states of a BNLH join cache with respect to the partitioning
+    of the join operands to disk: records are joined in the join buffer
+    only, partial join records are being written to partition files,
+    or the partitions are being joined one by one.
+  */ 
+  enum Spill_state { SPILL_NONE, SPILL_WRITING, SPILL_READING };
+
+  Spill_state spill_state;
+
+  /* Set if writing or reading a partition file has failed */
+  bool spill_failed;
+
+  /* Set when all records of join_tab have been written to the partitions */
+  bool spill_inner_done;
+
+  /* The number of partitions (a power of 2) and its binary logarithm */
+  uint spill_parts;
+  uint spill_part_bits;
+
+  /* The partition whose records are currently in the join buffer */
+  uint spill_curr_part;
+
+  /* 
+    The partition files: spill_parts files with the partial join records
+    from the join buffer, followed by spill_parts files with the records
+    of join_tab
+  */  
+  IO_CACHE *spill_files;
+
+  /* Buffer to read a partial join record from a partition file into */
+  uchar *spill_rec_buff;
+
+  /* The iterator over join_tab used when the partitions are joined */
+  JOIN_TAB_SCAN *spill_scan;
+
+  /* 
+    Bloom filter over the hash values of the join keys in the join buffer.
+    It is built when the buffer is full and it is checked for each record
+    of join_tab before the condition pushed to join_tab is evaluated.
+    If possible, the filter is pushed into the scan of join_tab, so that
+    the storage engine checks it before it returns the record.
+  */ 
+  uchar *key_filter;
+  /* Size of the memory allocated for key_filter */
+  size_t key_filter_size;
+  /* The number of bits in key_filter minus 1; the number is a power of 2 */
+  ulonglong key_filter_mask;
+  /* Set if key_filter is to be checked for the records of join_tab */
+  bool key_filter_active;
+  /* Set if key_filter is checked by the storage engine in the scan */
+  bool key_filter_pushed;
+  /* The fields of join_tab the join key is built from */
+  MY_BITMAP key_filter_fields;
+  /* The number of the records of join_tab checked and rejected by the filter */
+  ha_rows key_filter_checks;
+  ha_rows key_filter_rejects;
+
+  /* Build the Bloom filter over the join keys in the join buffer */
+  void build_key_filter();
+
+  /* Check the record of join_tab in the record buffer against key_filter */
+  bool check_key_filter_record();
+
+  /* Check whether the join operands may be partitioned to disk */
+  bool can_spill();
+
+  /* Get the partition of a join key value */
+  uint get_spill_part(const uchar *key);
+
+  /* Create the partition files */
+  bool start_spill();
+
+  /* Remove the partition files */
+  void end_spill();
+
+  /* Write all records from the join buffer to the partition files */
+  bool spill_buffered_records();
+
+  /* Write the current record of join_tab to its partition file */
+  int spill_inner_record(uint *part);
+
+  /* Refill the join buffer with records from a partition file */
+  bool load_spilled_records(IO_CACHE *file, bool *eof);
+
+  /* Join the partitions of the operands one by one */
+  enum_nested_loop_state join_spilled_records();
+
 protected:
 
   /* 
@@ -1190,6 +1287,15 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 
   void read_next_candidate_for_match(uchar *rec_ptr);
 
+  enum_nested_loop_state join_matching_records(bool skip_last);
+
+  bool check_key_filter();
+
+  /* The interface of the key filter pushed into the scan of join_tab */
+  const MY_BITMAP *fields() const { return &key_filter_fields; }
+
+  bool check() { return check_key_filter_record(); }
+
 public:
 
   /* 
@@ -1197,7 +1303,10 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     used to join table 'tab' to the result of joining the previous tables 
     specified by the 'j' parameter.
   */   
-  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab) : JOIN_CACHE_HASHED(j, tab) {}
+  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab)
+    : JOIN_CACHE_HASHED(j, tab), spill_state(SPILL_NONE), spill_failed(FALSE),
+      spill_files(0), spill_rec_buff(0), spill_scan(0), key_filter(0),
+      key_filter_size(0), key_filter_active(FALSE), key_filter_pushed(FALSE) {}
 
   /* 
     This constructor creates a linked BNLH join cache. The cache is to be 
@@ -1206,7 +1315,10 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     cache object to which this cache is linked.
   */   
   JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev) 
-    : JOIN_CACHE_HASHED(j, tab, prev) {}
+    : JOIN_CACHE_HASHED(j, tab, prev), spill_state(SPILL_NONE),
+      spill_failed(FALSE), spill_files(0), spill_rec_buff(0), spill_scan(0),
+      key_filter(0), key_filter_size(0), key_filter_active(FALSE),
+      key_filter_pushed(FALSE) {}
 
   /* Initialize the BNLH cache */       
   int init(bool for_explain);
@@ -1215,6 +1327,46 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 
   bool is_key_access() { return TRUE; }
 
+  /* 
+    Add a record into the join buffer, writing the buffered records
+    to the partition files if the buffer is full
+  */
+  bool put_record();
+
+  /* Join records from the join buffer or from the partition files */
+  enum_nested_loop_state join_records(bool skip_last);
+
+  /* Free the join buffer, the key filter and remove the partition files */
+  void free();
+
+  /* Add a comment on the partitioning of the join operands */
+  bool save_explain_data(EXPLAIN_BKA_TYPE *explain);
+
+  friend class JOIN_TAB_SCAN_SPILL;
+
+};
+
+
+/*
+  The class JOIN_TAB_SCAN_SPILL is a companion class for the class
+  JOIN_CACHE_BNLH that is used when the join operands have been partitioned
+  to disk. The first scan over the joined table writes each record of the
+  table to the file of its partition and returns only the records of the
+  partition that is in the join buffer. The following scans read the records
+  of the current partition from its file.
+*/
+
+class JOIN_TAB_SCAN_SPILL: public JOIN_TAB_SCAN
+{
+
+public:
+
+  JOIN_TAB_SCAN_SPILL(JOIN *j, JOIN_TAB *tab) :JOIN_TAB_SCAN(j, tab) {}
+
+  int open();
+
+  int next();
+
 };
 
 
@@ -175,6 +175,9 @@
 #define OPTIMIZER_SWITCH_HASH_JOIN_CARDINALITY     (1ULL << 35)
 #define OPTIMIZER_SWITCH_CSET_NARROWING            (1ULL << 36)
 #define OPTIMIZER_SWITCH_SARGABLE_CASEFOLD         (1ULL << 37)
+#define OPTIMIZER_SWITCH_HASH_JOIN_SPILL           (1ULL << 38)
+#define OPTIMIZER_SWITCH_HASH_JOIN_BLOOM_FILTER    (1ULL << 39)
+#define OPTIMIZER_SWITCH_HASH_GROUP_BY             (1ULL << 40)
 
 #define OPTIMIZER_SWITCH_DEFAULT (OPTIMIZER_SWITCH_INDEX_MERGE | \
                                   OPTIMIZER_SWITCH_INDEX_MERGE_UNION | \
@@ -170,6 +170,7 @@ static int join_tab_cmp_straight(const void *dummy, const void* ptr1, const void
 static int join_tab_cmp_embedded_first(const void *emb, const void* ptr1, const void *ptr2);
 C_MODE_END
 static uint cache_record_length(JOIN *join,uint index);
+static bool hash_join_spill_is_possible(JOIN *join, JOIN_TAB *s, uint idx);
 static store_key *get_store_key(THD *thd,
 				KEYUSE *keyuse, table_map used_tables,
 				KEY_PART_INFO *key_part, uchar *key_buff,
@@ -459,6 +460,7 @@ POSITION::POSITION()
   key= 0;
   forced_index= 0;
   use_join_buffer= 0;
+  spill_to_disk= false;
   firstmatch_with_join_buf= false;
   sj_strategy= SJ_OPT_NONE;
   n_sj_tables= 0;
@@ -2123,6 +2125,139 @@ JOIN::init_range_rowid_filters()
   DBUG_RETURN(0);
 }
 
+
+/**
+  @brief
+    Choose to scan the only table of the join in several threads
+
+  @details
+    If the query computes COUNT(), SUM(), MIN() or MAX() over all rows of
+    a table that is read with a full table scan, and the storage engine
+    supports parallel scans, then the rows are read and aggregated by
+    parallel_query_threads threads (see Parallel_aggregate). The query
+    must not have GROUP BY, DISTINCT, HAVING or window functions, and it
+    must not select columns outside the aggregate functions. Each thread
+    is to read at least PARALLEL_SCAN_MIN_ROWS rows, so a small table is
+    scanned by fewer threads or by the query thread only.
+
+  @retval false  Ok
+  @retval true   Error
+*/
+
+bool
+JOIN::init_parallel_aggregate()
+{
+  JOIN_TAB *tab= join_tab;
+  TABLE *table;
+  uint n_threads= (uint) thd->variables.parallel_query_threads;
+  DBUG_ENTER("init_parallel_aggregate");
+
+  if (n_threads <= 1 || !implicit_grouping || group_list ||
+      select_distinct || rollup.state != ROLLUP::STATE_NONE ||
+      having || tmp_having || aggr_tables || table_count != 1 ||
+      const_tables || select_lex->have_window_funcs() || procedure ||
+      pushdown_query || thd->lex->sql_command != SQLCOM_SELECT ||
+      select_lex->master_unit() != &thd->lex->unit ||
+      thd->lex->unit.is_unit_op() || thd->lex->limit_rows_examined)
+    DBUG_RETURN(false);
+
+  table= tab->table;
+  if (tab->type != JT_ALL || (tab->select && tab->select->quick) ||
+      tab->cache || tab->filesort || tab->rowid_filter ||
+      tab->next_select != end_send_group ||
+      !table->file->can_parallel_scan())
+    DBUG_RETURN(false);
+
+  for (Field **field= table->field; *field; field++)
+  {
+    if (bitmap_is_set(table->read_set, (*field)->field_index) &&
+        (((*field)->flags & BLOB_FLAG) || !(*field)->stored_in_db()))
+      DBUG_RETURN(false);
+  }
+
+  for (Item_sum **func= sum_funcs; *func; func++)
+  {
+    switch ((*func)->sum_func()) {
+    case Item_sum::COUNT_FUNC:
+    case Item_sum::MIN_FUNC:
+    case Item_sum::MAX_FUNC:
+      break;
+    case Item_sum::SUM_FUNC:
+      if ((*func)->result_type() == REAL_RESULT ||
+          (*func)->result_type() == DECIMAL_RESULT)
+        break;
+      /* fall through */
+    default:
+      DBUG_RETURN(false);
+    }
+  }
+
+  /* Columns outside the aggregate functions would need a row of the table */
+  List_iterator_fast<Item> it(all_fields);
+  Item *item;
+  while ((item= it++))
+  {
+    if (item->type() != Item::SUM_FUNC_ITEM && !item->with_sum_func() &&
+        (item->used_tables() & table->map))
+      DBUG_RETURN(false);
+  }
+
+  /* Starting a thread costs more than reading a few rows */
+  n_threads= (uint) MY_MIN(n_threads,
+                           table->stat_records() / PARALLEL_SCAN_MIN_ROWS);
+  if (n_threads <= 1)
+    DBUG_RETURN(false);
+
+  Parallel_aggregate *aggr;
+  if (!(aggr= new (thd->mem_root) Parallel_aggregate(tab, n_threads)))
+    DBUG_RETURN(true);
+  if (aggr->init())
+    DBUG_RETURN(thd->is_error());
+  tab->parallel_aggr= aggr;
+  DBUG_RETURN(false);
+}
+
+/**
+  Find out how many rows a full-text index scan has to return.
+
+  If the only table is read by a full-text index scan, the WHERE clause
+  consists of nothing but that MATCH, and the result is ordered by
+  relevance (implicitly or by ORDER BY MATCH(...) AGAINST(...) DESC) and
+  truncated by LIMIT, then only the most relevant rows are needed.
+  The storage engine can then avoid ranking and returning all matches.
+
+  @param join  the join that was optimized
+
+  @return number of the most relevant rows needed, or HA_POS_ERROR
+*/
+
+static ha_rows get_ft_limit(const JOIN *join)
+{
+  if (join->table_count != 1 || join->join_tab->type != JT_FT ||
+      join->select_limit == HA_POS_ERROR ||
+      join->unit->lim.is_with_ties() ||
+      join->group_list || join->select_distinct || join->having ||
+      join->select_lex->with_sum_func ||
+      join->select_lex->have_window_funcs() || !join->conds)
+    return HA_POS_ERROR;
+
+  Item *cond= join->conds->real_item();
+  if (cond->type() != Item::FUNC_ITEM ||
+      ((Item_func*) cond)->functype() != Item_func::FT_FUNC ||
+      !((Item_func_match*) cond)->join_key)
+    return HA_POS_ERROR;
+
+  if (const ORDER *order= join->order)
+  {
+    if (order->next || order->direction != ORDER::ORDER_DESC ||
+        !(*order->item)->real_item()->eq(cond, true))
+      return HA_POS_ERROR;
+  }
+
+  return join->select_limit;
+}
+
+
 /**
   global select optimisation.
 
@@ -3241,8 +3376,17 @@ int JOIN::optimize_stage2()
 
   /* Perform FULLTEXT search before all regular searches */
   if (!(select_options & SELECT_DESCRIBE))
+  {
+    if (select_lex->ftfunc_list->elements)
+    {
+      const ha_rows ft_limit= get_ft_limit(this);
+      List_iterator_fast<Item_func_match> li(*select_lex->ftfunc_list);
+      while (Item_func_match *ifm= li++)
+        ifm->ft_limit= ft_limit;
+    }
     if (init_ftfuncs(thd, select_lex, MY_TEST(order)))
       DBUG_RETURN(1);
+  }
 
   /*
     It's necessary to check const part of HAVING cond as
@@ -3454,6 +3598,9 @@ int JOIN::optimize_stage2()
   if (init_range_rowid_filters())
     DBUG_RETURN(1);
 
+  if (init_parallel_aggregate())
+    DBUG_RETURN(1);
+
   error= 0;
 
   if (select_options & SELECT_DESCRIBE)
@@ -5025,6 +5172,8 @@ JOIN::destroy()
     {
       if (tab->aggr)
       {
+        if (tab->aggr->hash_group)
+          tab->aggr->hash_group->free();
         free_tmp_table(thd, tab->table);
         delete tab->tmp_table_param;
         tab->tmp_table_param= NULL;
@@ -7973,6 +8122,7 @@ void set_position(JOIN *join,uint idx,JOIN_TAB *table,KEYUSE *key)
 //  join->positions[idx].loosescan_key= MAX_KEY; /* Not a LooseScan */
   join->positions[idx].sj_strategy= SJ_OPT_NONE;
   join->positions[idx].use_join_buffer= FALSE;
+  join->positions[idx].spill_to_disk= FALSE;
   join->positions[idx].range_rowid_filter_info= 0;
 
   /* Move the const table as down as possible in best_ref */
@@ -8464,6 +8614,7 @@ struct best_plan
   uint max_key_part;
   table_map found_ref;
   bool use_join_buffer;
+  bool spill_to_disk;                    // Hash join partitioned to disk
 };
 
 
@@ -8527,6 +8678,7 @@ best_access_path(JOIN      *join,
   best.ref_depends_map= 0;
   best.refills= 0;
   best.use_join_buffer= FALSE;
+  best.spill_to_disk= FALSE;
   best.spl_plan= 0;
 
   disable_jbuf= disable_jbuf || idx == join->const_tables;
@@ -9348,8 +9500,32 @@ best_access_path(JOIN      *join,
     refills= (1.0 + floor((double) cache_record_length(join,idx) *
                           record_count /
                           (double) thd->variables.join_buff_size));
+    double scan_cost= cur_cost;
     cur_cost= COST_MULT(cur_cost, refills);
 
+    bool spill= false;
+    if (refills > 1.0 && hash_join_spill_is_possible(join, s, idx))
+    {
+      /*
+        Instead of refilling the join buffer the records of the join prefix
+        and the rows of the table can be partitioned to disk by the hash of
+        the join key. Then the table is read once, and all records are
+        written to disk and read back once: 2 -> 1 write + 1 read.
+      */
+      double spill_bytes= ((double) cache_record_length(join,idx) *
+                           record_count +
+                           rows2double(s->records) * table->s->reclength);
+      double spill_cost= COST_ADD(scan_cost,
+                                  2.0 * spill_bytes / DISK_CHUNK_SIZE *
+                                  DISK_READ_COST_THD(thd));
+      if (spill_cost < cur_cost)
+      {
+        cur_cost= spill_cost;
+        refills= 1.0;
+        spill= true;
+      }
+    }
+
 
     /*
       Cost of doing the hash lookup and check all matching rows with the
@@ -9375,15 +9551,21 @@ best_access_path(JOIN      *join,
     best.filter= 0;
     best.type= JT_HASH;
     best.refills= double_to_ulonglong(ceil(refills));
+    best.spill_to_disk= spill;
     if (unlikely(trace_access_hash.trace_started()))
+    {
       trace_access_hash.
         add("rows", rnd_records).
         add("rows_after_hash", fanout * join_sel).
-        add("refills", refills).
+        add("refills", refills);
+      if (spill)
+        trace_access_hash.add("spill_to_disk", true);
+      trace_access_hash.
         add("jbuf_use_cost", copy_cost).
         add("extra_cond_check_cost", where_cost).
         add("total_cost", best.cost).
         add("chosen", true);
+    }
   }
 
   /*
@@ -9752,6 +9934,7 @@ best_access_path(JOIN      *join,
                                 (join->allowed_outer_join_with_cache ||
                                  !(s->table->map & join->outer_join)));
       best.refills= refills;
+      best.spill_to_disk= FALSE;
       best.spl_plan= 0;
       best.type= type;
       trace_access_scan.add("chosen", true);
@@ -9794,6 +9977,7 @@ best_access_path(JOIN      *join,
   pos->key_dependent= (best.type == JT_EQ_REF ? (table_map) 0 :
                        key_dependent & remaining_tables);
   pos->refills=  best.refills;
+  pos->spill_to_disk= best.spill_to_disk;
 
   loose_scan_opt.save_to_position(s, record_count, pos->records_out,
                                   loose_scan_pos);
@@ -12059,6 +12243,64 @@ bool JOIN_TAB::keyuse_is_valid_for_access_in_chosen_plan(JOIN *join,
 }
 
 
+/*
+  Check whether a hash join of table s may be partitioned to disk
+
+  SYNOPSIS
+    hash_join_spill_is_possible()
+      join  the join being optimized
+      s     the table joined through the join buffer
+      idx   the number of tables in the join prefix
+
+  DESCRIPTION
+    The function checks the conditions of JOIN_CACHE_BNLH::can_spill()
+    that can be checked before the join caches are created, so that
+    best_access_path() costs a join as partitioned to disk only if it
+    will be executed this way:
+    - neither the records of s nor the records of the join prefix may
+      contain blob values (JOIN_CACHE::blobs);
+    - the rowids of the records must not be kept (keep_current_rowid),
+      as it happens for multi-table UPDATE and DELETE and for the
+      DuplicateWeedout semi-join strategy;
+    - the join must not contain semi-join materialization nests
+      (bush_children).
+    A cache that is partitioned to disk is never linked to other caches,
+    see check_join_cache_usage().
+
+  RETURN VALUE
+    TRUE    the join may be partitioned to disk
+    FALSE   otherwise
+*/
+
+static bool hash_join_spill_is_possible(JOIN *join, JOIN_TAB *s, uint idx)
+{
+  THD *thd= join->thd;
+  if (!optimizer_flag(thd, OPTIMIZER_SWITCH_HASH_JOIN_SPILL) ||
+      s->table->s->blob_fields || join->select_lex->sj_nests.elements)
+    return FALSE;
+
+  switch (thd->lex->sql_command) {
+  case SQLCOM_UPDATE:
+  case SQLCOM_UPDATE_MULTI:
+  case SQLCOM_DELETE:
+  case SQLCOM_DELETE_MULTI:
+    return FALSE;
+  default:
+    break;
+  }
+
+  for (JOIN_TAB **pos= join->best_ref + join->const_tables,
+                **end= join->best_ref + idx;
+       pos != end; pos++)
+  {
+    (*pos)->get_used_fieldlength();
+    if ((*pos)->used_blobs)
+      return FALSE;
+  }
+  return TRUE;
+}
+
+
 static uint
 cache_record_length(JOIN *join,uint idx)
 {
@@ -12802,6 +13044,7 @@ bool JOIN::get_best_combination()
     j->records_out=  cur_pos->records_out;
     j->join_read_time= cur_pos->read_time;
     j->join_loops=     cur_pos->loops;
+    j->spill_to_disk=  cur_pos->spill_to_disk;
 
   loop_end:
     j->cond_selectivity= cur_pos->cond_selectivity;
@@ -15222,6 +15465,9 @@ uint check_join_cache_usage(JOIN_TAB *tab,
   }       
 
   prev_cache= prev_tab->cache;
+  /* A cache partitioned to disk is not linked, see can_spill() */
+  if (tab->spill_to_disk || prev_tab->spill_to_disk)
+    prev_cache= 0;
 
   switch (tab->type) {
   case JT_NEXT:
@@ -16500,6 +16746,8 @@ void JOIN::cleanup(bool full)
         {
           if (curr_tab->aggr)
           {
+            if (curr_tab->aggr->hash_group)
+              curr_tab->aggr->hash_group->free();
             free_tmp_table(thd, curr_tab->table);
             curr_tab->table= NULL;
             delete curr_tab->tmp_table_param;
@@ -22903,6 +23151,9 @@ void set_postjoin_aggr_write_func(JOIN_TAB *tab)
     {
       DBUG_PRINT("info",("Using end_update"));
       aggr->set_write_func(end_update);
+      if (optimizer_flag(join->thd, OPTIMIZER_SWITCH_HASH_GROUP_BY) &&
+          !aggr->hash_group)
+        aggr->hash_group= new (join->thd->mem_root) Hash_group_table(tab);
     }
     else
     {
@@ -23589,6 +23840,11 @@ sub_select(JOIN *join,JOIN_TAB *join_tab,bool end_of_records)
       (rc= join_tab_execution_startup(join_tab)) < 0)
     DBUG_RETURN(rc);
   
+  /* Aggregate the rows in several threads, unless the engine refuses */
+  if (rc != NESTED_LOOP_NO_MORE_ROWS && join_tab->parallel_aggr &&
+      (rc= join_tab->parallel_aggr->run()) < 0)
+    DBUG_RETURN(rc);
+
   if (join_tab->loosescan_match_tab)
     join_tab->loosescan_match_tab->found_match= FALSE;
 
@@ -25218,6 +25474,33 @@ end_write(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
 }
 
 
+/**
+  Make the key of the group of the current row in
+  TMP_TABLE_PARAM::group_buff, for a lookup in the tmp table index.
+*/
+
+static void make_group_key(TABLE *table)
+{
+  for (ORDER *group=table->group ; group ; group=group->next)
+  {
+    Item *item= *group->item;
+    if (group->fast_field_copier_setup != group->field)
+    {
+      DBUG_PRINT("info", ("new setup %p -> %p",
+                          group->fast_field_copier_setup,
+                          group->field));
+      group->fast_field_copier_setup= group->field;
+      group->fast_field_copier_func=
+        item->setup_fast_field_copier(group->field);
+    }
+    item->save_org_in_field(group->field, group->fast_field_copier_func);
+    /* Store in the used key if the field was 0 */
+    if (item->maybe_null())
+      group->buff[-1]= (char) group->field->is_null();
+  }
+}
+
+
 /*
   @brief
     Perform GROUP BY operation over rows coming in arbitrary order: use
@@ -25247,7 +25530,6 @@ end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
 	   bool end_of_records)
 {
   TABLE *const table= join_tab->table;
-  ORDER   *group;
   int	  error;
   DBUG_ENTER("end_update");
 
@@ -25257,23 +25539,7 @@ end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
   join->found_records++;
   copy_fields(join_tab->tmp_table_param);	// Groups are copied twice.
   /* Make a key of group index */
-  for (group=table->group ; group ; group=group->next)
-  {
-    Item *item= *group->item;
-    if (group->fast_field_copier_setup != group->field)
-    {
-      DBUG_PRINT("info", ("new setup %p -> %p",
-                          group->fast_field_copier_setup,
-                          group->field));
-      group->fast_field_copier_setup= group->field;
-      group->fast_field_copier_func=
-        item->setup_fast_field_copier(group->field);
-    }
-    item->save_org_in_field(group->field, group->fast_field_copier_func);
-    /* Store in the used key if the field was 0 */
-    if (item->maybe_null())
-      group->buff[-1]= (char) group->field->is_null();
-  }
+  make_group_key(table);
   if (!table->file->ha_index_read_map(table->record[1],
                                       join_tab->tmp_table_param->group_buff,
                                       HA_WHOLE_KEY,
@@ -25390,6 +25656,286 @@ end_unique_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
 }
 
 
+/****************************************************************************
+  Hash_group_table implementation
+****************************************************************************/
+
+/**
+  @brief
+    Start an execution of GROUP BY with the in-memory hash table
+
+  @details
+    The hash table is used only if the state of all aggregate functions is
+    kept in the tmp table record, and if the record has no blobs, whose
+    values are not stored in the record.
+*/
+
+void Hash_group_table::start()
+{
+  JOIN *join= join_tab->join;
+  TABLE *table= join_tab->table;
+  THD *thd= join->thd;
+
+  free();
+  if (table->s->blob_fields || !table->s->keys)
+    return;
+  for (Item_sum **func= join->sum_funcs; *func; func++)
+  {
+    switch ((*func)->sum_func()) {
+    case Item_sum::COUNT_FUNC:
+    case Item_sum::SUM_FUNC:
+    case Item_sum::AVG_FUNC:
+    case Item_sum::MIN_FUNC:
+    case Item_sum::MAX_FUNC:
+    case Item_sum::STD_FUNC:
+    case Item_sum::VARIANCE_FUNC:
+    case Item_sum::SUM_BIT_FUNC:
+      break;
+    default:
+      return;
+    }
+  }
+
+  key_info= table->key_info;
+  key_parts= key_info->user_defined_key_parts;
+  key_length= join_tab->tmp_table_param->group_length;
+  group_size= ALIGN_SIZE(key_length) + table->s->reclength;
+  memory_used= 0;
+  /* The same limit as for the HEAP tmp table */
+  memory_limit= (size_t) MY_MIN(thd->variables.tmp_memory_table_size,
+                                thd->variables.max_heap_table_size);
+  for (Partition *part= partitions; part < partitions + n_partitions; part++)
+  {
+    init_alloc_root(PSI_INSTRUMENT_ME, &part->mem_root, 16384, 0,
+                    MYF(MY_THREAD_SPECIFIC));
+    part->slots= NULL;
+    part->capacity= part->n_groups= part->memory= 0;
+    part->spilled= false;
+  }
+  active= true;
+}
+
+
+/**
+  @brief
+    Aggregate the current row into its group in the hash table
+
+  @param[out] aggregated  false if the row must be passed to the write_func
+                          of the AGGR_OP, because its group is in a
+                          partition that was written to the tmp table
+
+  @return
+    true   error
+    false  ok
+*/
+
+bool Hash_group_table::put_row(bool *aggregated)
+{
+  JOIN *join= join_tab->join;
+  TABLE *table= join_tab->table;
+  const uchar *key= join_tab->tmp_table_param->group_buff;
+
+  *aggregated= false;
+  if (!active)
+    return false;
+
+  copy_fields(join_tab->tmp_table_param);
+  make_group_key(table);
+  ulonglong hash= key_hashnr(key_info, key_parts, key) *
+                  0x9E3779B97F4A7C15ULL;
+  Partition *part= &partitions[hash >> (64 - partition_bits)];
+  if (part->spilled)
+    return false;
+
+  if (part->n_groups)
+  {
+    const size_t mask= part->capacity - 1;
+    for (size_t i= (size_t) (hash >> 24) & mask; part->slots[i].group;
+         i= (i + 1) & mask)
+    {
+      const Slot &slot= part->slots[i];
+      if (slot.hash == hash &&
+          !key_buf_cmp(key_info, key_parts, slot.group, key))
+      {
+        uchar *record= slot.group + ALIGN_SIZE(key_length);
+        memcpy(table->record[0], record, table->s->reclength);
+        update_tmptable_sum_func(join->sum_funcs, table);
+        memcpy(record, table->record[0], table->s->reclength);
+        *aggregated= true;
+        return false;
+      }
+    }
+  }
+
+  /* A new group. Make room for it by spilling the largest partitions. */
+  while (memory_used + group_size > memory_limit)
+  {
+    Partition *victim= part;
+    for (Partition *p= partitions; p < partitions + n_partitions; p++)
+      if (!p->spilled && p->memory > victim->memory)
+        victim= p;
+    if (spill(victim))
+      return true;
+    if (victim == part)
+      return false;
+  }
+
+  if (insert(part, hash))
+    return true;
+  join_tab->send_records++;
+  *aggregated= true;
+  return false;
+}
+
+
+/** Add the group of the current row to a partition */
+
+bool Hash_group_table::insert(Partition *part, ulonglong hash)
+{
+  JOIN *join= join_tab->join;
+  TABLE *table= join_tab->table;
+  uchar *group;
+
+  if ((part->n_groups + 1) * 2 > part->capacity && grow(part))
+    return true;
+  if (!(group= (uchar*) alloc_root(&part->mem_root, group_size)))
+    return true;
+
+  init_tmptable_sum_functions(join->sum_funcs);
+  if (unlikely(copy_funcs(join_tab->tmp_table_param->items_to_copy,
+                          join->thd)))
+    return true;
+  memcpy(group, join_tab->tmp_table_param->group_buff, key_length);
+  memcpy(group + ALIGN_SIZE(key_length), table->record[0],
+         table->s->reclength);
+
+  const size_t mask= part->capacity - 1;
+  size_t i= (size_t) (hash >> 24) & mask;
+  while (part->slots[i].group)
+    i= (i + 1) & mask;
+  part->slots[i].hash= hash;
+  part->slots[i].group= group;
+  part->n_groups++;
+  part->memory+= group_size;
+  memory_used+= group_size;
+  return false;
+}
+
+
+/** Double the number of slots of a partition */
+
+bool Hash_group_table::grow(Partition *part)
+{
+  const size_t capacity= part->capacity ? part->capacity * 2 : 64;
+  const size_t mask= capacity - 1;
+  Slot *slots;
+
+  if (!(slots= (Slot*) my_malloc(PSI_INSTRUMENT_ME, capacity * sizeof(Slot),
+                                 MYF(MY_WME | MY_ZEROFILL |
+                                     MY_THREAD_SPECIFIC))))
+    return true;
+  for (size_t j= 0; j < part->capacity; j++)
+  {
+    const Slot &slot= part->slots[j];
+    if (!slot.group)
+      continue;
+    size_t i= (size_t) (slot.hash >> 24) & mask;
+    while (slots[i].group)
+      i= (i + 1) & mask;
+    slots[i]= slot;
+  }
+  my_free(part->slots);
+
+  const size_t added= (capacity - part->capacity) * sizeof(Slot);
+  part->memory+= added;
+  memory_used+= added;
+  part->slots= slots;
+  part->capacity= capacity;
+  return false;
+}
+
+
+/**
+  Write the groups of a partition to the tmp table and free them. The
+  rows of these groups will be aggregated by the write_func.
+*/
+
+bool Hash_group_table::spill(Partition *part)
+{
+  DBUG_PRINT("info", ("Spilling %zu groups", part->n_groups));
+  for (size_t i= 0; i < part->capacity; i++)
+    if (part->slots[i].group && write_group(part->slots[i].group))
+      return true;
+  memory_used-= part->memory;
+  free_partition(part);
+  part->spilled= true;
+  return false;
+}
+
+
+/** Write all groups to the tmp table at the end of the input */
+
+bool Hash_group_table::flush()
+{
+  if (!active)
+    return false;
+  for (Partition *part= partitions; part < partitions + n_partitions; part++)
+    for (size_t i= 0; i < part->capacity; i++)
+      if (part->slots[i].group && write_group(part->slots[i].group))
+        return true;
+  free();
+  return false;
+}
+
+
+/**
+  Write a group to the tmp table. Like end_update(), convert a full HEAP
+  table to disk, and then update the rows with end_unique_update().
+*/
+
+bool Hash_group_table::write_group(const uchar *group)
+{
+  TABLE *table= join_tab->table;
+  int error;
+
+  memcpy(table->record[0], group + ALIGN_SIZE(key_length),
+         table->s->reclength);
+  if (likely(!(error= table->file->ha_write_tmp_row(table->record[0]))))
+    return false;
+  if (create_internal_tmp_table_from_heap(join_tab->join->thd, table,
+                                       join_tab->tmp_table_param->start_recinfo,
+                                          &join_tab->tmp_table_param->recinfo,
+                                          error, 0, NULL))
+    return true;                                // Not a table_is_full error
+  if (unlikely((error= table->file->ha_index_init(0, 0))))
+  {
+    table->file->print_error(error, MYF(0));
+    return true;
+  }
+  join_tab->aggr->set_write_func(end_unique_update);
+  return false;
+}
+
+
+void Hash_group_table::free_partition(Partition *part)
+{
+  free_root(&part->mem_root, MYF(0));
+  my_free(part->slots);
+  part->slots= NULL;
+  part->capacity= part->n_groups= part->memory= 0;
+}
+
+
+void Hash_group_table::free()
+{
+  if (!active)
+    return;
+  for (Partition *part= partitions; part < partitions + n_partitions; part++)
+    free_partition(part);
+  active= false;
+}
+
+
 /*
   @brief
     Perform OrderedGroupBy operation and write the output into the temporary
@@ -29816,6 +30362,7 @@ bool JOIN_TAB::save_explain_data(Explain_table_access *eta,
   tracker= &eta->tracker;
   jbuf_tracker= &eta->jbuf_tracker;
   jbuf_loops_tracker= &eta->jbuf_loops_tracker;
+  jbuf_spill_tracker= &eta->jbuf_spill_tracker;
   jbuf_unpack_tracker= &eta->jbuf_unpack_tracker;
 
   /* Enable the table access time tracker only for "ANALYZE stmt" */
@@ -30256,6 +30803,12 @@ bool JOIN_TAB::save_explain_data(Explain_table_access *eta,
       if (cache->save_explain_data(&eta->bka_type))
         return 1;
     }
+
+    if (parallel_aggr)
+    {
+      eta->push_extra(ET_PARALLEL_SCAN);
+      eta->parallel_threads= parallel_aggr->threads();
+    }
   }
 
   /* 
@@ -32469,6 +33022,8 @@ AGGR_OP::prepare_tmp_table()
     table->file->print_error(rc, MYF(0));
     return true;
   }
+  if (hash_group)
+    hash_group->start();
   return false;
 }
 
@@ -32488,6 +33043,22 @@ AGGR_OP::put_record(bool end_of_records)
   if (!join_tab->table->file->inited)
     if (prepare_tmp_table())
       return NESTED_LOOP_ERROR;
+  if (hash_group)
+  {
+    JOIN *join= join_tab->join;
+    bool aggregated= false;
+    if (end_of_records ? hash_group->flush() :
+        hash_group->put_row(&aggregated))
+      return NESTED_LOOP_ERROR;
+    if (aggregated)
+    {
+      join->found_records++;
+      join->accepted_rows++;                    // For rownum()
+      if (unlikely(join->thd->check_killed()))
+        return NESTED_LOOP_KILLED;
+      return NESTED_LOOP_OK;
+    }
+  }
   enum_nested_loop_state rc= (*write_func)(join_tab->join, join_tab,
                                            end_of_records);
   return rc;
@@ -32587,6 +33158,339 @@ AGGR_OP::end_send()
 }
 
 
+/**
+  Number of running helpers of all parallel scans,
+  see @@max_parallel_query_threads
+*/
+static Atomic_counter<ulong> parallel_scan_helpers_running;
+
+/* See sql_class.cc */
+MYSQL_THD create_background_thd();
+void destroy_background_thd(MYSQL_THD thd);
+void *thd_attach_thd(MYSQL_THD thd);
+void thd_detach_thd(void *mysysvar);
+
+/**
+  Copy an expression over the table for the use of a parallel scan thread.
+
+  @param thd   the query thread
+  @param item  the expression
+  @param copy  the copy of the table that the clone will read
+
+  @return the fixed copy of the expression
+  @retval NULL  if the expression cannot be evaluated in another thread
+*/
+
+Item *Parallel_aggregate::clone_item(THD *thd, Item *item, TABLE *copy)
+{
+  Item::vcol_func_processor_result res;
+  Item *clone= item->build_clone(thd);
+  if (!clone)
+    return NULL;
+  /*
+    The same test as for generated columns excludes references, caches,
+    subqueries, stored functions and functions of the session state.
+    It resets the name resolution context of Item_field, so only walk it
+    over the clone.
+  */
+  clone->walk(&Item::check_vcol_func_processor, 0, &res);
+  if (res.errors & (VCOL_IMPOSSIBLE | VCOL_NOT_STRICTLY_DETERMINISTIC |
+                    VCOL_NEXTVAL))
+    return NULL;
+  clone->walk(&Item::switch_to_table_copy_processor, 0, copy);
+  clone->walk(&Item::cleanup_excluding_fields_processor, 0, 0);
+  if (clone->fix_fields_if_needed(thd, &clone))
+    return NULL;
+  return clone;
+}
+
+
+/**
+  @brief Create the copies of the table, condition and aggregate functions
+         for each thread
+
+  @retval false  Ok
+  @retval true   the query cannot be executed in parallel, or out of memory
+*/
+
+bool Parallel_aggregate::init()
+{
+  JOIN *join= join_tab->join;
+  THD *thd= join->thd;
+  TABLE *table= join_tab->table;
+  TABLE_SHARE *share= table->s;
+  DBUG_ENTER("Parallel_aggregate::init");
+
+  for (Item_sum **func= join->sum_funcs; *func; func++)
+    n_sums++;
+
+  if (!(workers= (Worker*) thd->calloc(sizeof(Worker) * n_threads)))
+    DBUG_RETURN(true);
+
+  for (uint i= 0; i < n_threads; i++)
+  {
+    Worker *w= &workers[i];
+    char *copy_tmp;
+    Field **field;
+    uchar *record;
+
+    if (!multi_alloc_root(thd->mem_root,
+                          &copy_tmp, sizeof(*table),
+                          &field, (share->fields + 1) * sizeof(Field*),
+                          &w->sums, (n_sums + 1) * sizeof(Item_sum*),
+                          &record, (size_t) share->reclength,
+                          NullS))
+      DBUG_RETURN(true);
+
+    /* Like Delayed_insert::get_local_table(), but without the handler */
+    w->table= new (copy_tmp) TABLE;
+    *w->table= *table;
+    w->table->field= field;
+    w->table->record[0]= record;
+    w->table->null_row= 0;
+    my_ptrdiff_t diff= PTR_BYTE_DIFF(record, table->record[0]);
+    for (Field **org_field= table->field; *org_field; org_field++, field++)
+    {
+      if (!(*field= (*org_field)->clone(thd->mem_root, w->table, diff)))
+        DBUG_RETURN(true);
+    }
+    *field= 0;
+
+    if (join_tab->select_cond &&
+        !(w->cond= clone_item(thd, join_tab->select_cond, w->table)))
+      DBUG_RETURN(true);
+
+    for (uint j= 0; j < n_sums; j++)
+    {
+      Item_sum *sum= join->sum_funcs[j];
+      Item_sum *partial= (Item_sum*) sum->copy_or_same(thd);
+      if (!partial)
+        DBUG_RETURN(true);
+      for (uint k= 0; k < sum->get_arg_count(); k++)
+      {
+        Item *arg= clone_item(thd, sum->get_arg(k), w->table);
+        if (!arg)
+          DBUG_RETURN(true);
+        partial->set_arg(k, thd, arg);
+      }
+      partial->setup_caches(thd);
+      w->sums[j]= partial;
+    }
+    w->sums[n_sums]= 0;
+  }
+  DBUG_RETURN(false);
+}
+
+
+/**
+  Copy the warnings and the error of a parallel scan thread to the query
+  thread.
+*/
+
+void Parallel_aggregate::harvest_diagnostics(Worker *w)
+{
+  THD *thd= join_tab->join->thd;
+  Diagnostics_area *da= w->thd->get_stmt_da();
+  Diagnostics_area::Sql_condition_iterator it= da->sql_conditions();
+  const Sql_condition *cond;
+
+  while ((cond= it++))
+  {
+    if (cond->get_level() != Sql_condition::WARN_LEVEL_ERROR)
+      push_warning(thd, cond->get_level(), cond->get_sql_errno(),
+                   cond->get_message_text());
+  }
+  if (da->is_error() && !thd->is_error())
+    my_message(da->sql_errno(), da->message(), MYF(0));
+}
+
+
+/**
+  Reserve helper threads for a parallel scan. Fewer threads are reserved
+  if the server would have more than @@max_parallel_query_threads helpers.
+
+  @param n  Number of helper threads
+
+  @return the number of helper threads reserved
+*/
+
+static uint reserve_parallel_scan_helpers(uint n)
+{
+  ulong max_threads= max_parallel_query_threads;
+  ulong running= (parallel_scan_helpers_running+= n);
+  if (running > max_threads)
+  {
+    uint excess= (uint) std::min<ulong>(n, running - max_threads);
+    parallel_scan_helpers_running-= excess;
+    n-= excess;
+  }
+  return n;
+}
+
+
+enum_nested_loop_state Parallel_aggregate::run()
+{
+  JOIN *join= join_tab->join;
+  THD *thd= join->thd;
+  handler *file= join_tab->table->file;
+  enum_nested_loop_state rc= NESTED_LOOP_NO_MORE_ROWS;
+  int error;
+  DBUG_ENTER("Parallel_aggregate::run");
+
+  uint helpers= reserve_parallel_scan_helpers(n_threads - 1);
+  if (!helpers)
+    DBUG_RETURN(NESTED_LOOP_OK);
+
+  if (file->ha_rnd_init_with_error(true))
+  {
+    parallel_scan_helpers_running-= helpers;
+    DBUG_RETURN(NESTED_LOOP_ERROR);
+  }
+
+  /* The threads that are started get a THD in begin() */
+  for (uint i= 0; i < n_threads; i++)
+  {
+    Worker *w= &workers[i];
+    w->thd= NULL;
+    w->examined= w->found= 0;
+  }
+
+  error= file->parallel_scan(helpers + 1, this);
+  file->ha_rnd_end();
+  parallel_scan_helpers_running-= helpers;
+
+  for (uint i= 1; i < n_threads; i++)
+  {
+    Worker *w= &workers[i];
+    if (!w->thd)
+      continue;
+    status_var_increment(thd->status_var.parallel_query_helper_threads);
+    harvest_diagnostics(w);
+    set_current_thd(nullptr);
+    destroy_background_thd(w->thd);
+    set_current_thd(thd);
+  }
+
+  if (error == HA_ERR_WRONG_COMMAND)
+    DBUG_RETURN(NESTED_LOOP_OK);
+  if (thd->is_error())
+    DBUG_RETURN(NESTED_LOOP_ERROR);
+  if (error)
+  {
+    if (thd->killed)
+    {
+      thd->send_kill_message();
+      DBUG_RETURN(NESTED_LOOP_KILLED);
+    }
+    file->print_error(error, MYF(0));
+    DBUG_RETURN(NESTED_LOOP_ERROR);
+  }
+
+  for (uint i= 0; i < n_threads; i++)
+  {
+    Worker *w= &workers[i];
+    join_tab->tracker->r_rows+= w->examined;
+    join_tab->tracker->r_rows_after_where+= w->found;
+    thd->m_examined_row_count+= w->examined;
+    thd->examined_row_count_for_statement+= w->examined;
+    if (!w->found)
+      continue;
+
+    /* Pass the partial results to end_send_group() like a row */
+    for (uint j= 0; j < n_sums; j++)
+    {
+      Item_sum *sum= join->sum_funcs[j], *partial= w->sums[j];
+      switch (sum->sum_func()) {
+      case Item_sum::COUNT_FUNC:
+        ((Item_sum_count*) sum)->direct_add(partial->val_int());
+        break;
+      case Item_sum::SUM_FUNC:
+        if (sum->result_type() == DECIMAL_RESULT)
+        {
+          my_decimal value;
+          ((Item_sum_sum*) sum)->direct_add(partial->val_decimal(&value));
+        }
+        else
+        {
+          double value= partial->val_real();
+          ((Item_sum_sum*) sum)->direct_add(value, partial->null_value);
+        }
+        break;
+      default:
+        ((Item_sum_min_max*) sum)->direct_add(partial);
+        break;
+      }
+    }
+    if ((rc= (*join_tab->next_select)(join, join_tab + 1, 0)) < 0)
+      DBUG_RETURN(rc);
+  }
+  DBUG_RETURN(NESTED_LOOP_NO_MORE_ROWS);
+}
+
+
+uchar *Parallel_aggregate::begin(uint thread)
+{
+  Worker *w= &workers[thread];
+  TABLE *table= w->table;
+  THD *thd= join_tab->join->thd;
+
+  if (!thread)
+    w->thd= thd;
+  else
+  {
+    w->thd= create_background_thd();
+    /* The session variables that affect the evaluation of expressions */
+    system_variables *vars= &w->thd->variables;
+    vars->sql_mode= thd->variables.sql_mode;
+    vars->time_zone= thd->variables.time_zone;
+    vars->lc_time_names= thd->variables.lc_time_names;
+    vars->character_set_client= thd->variables.character_set_client;
+    vars->collation_connection= thd->variables.collation_connection;
+    vars->div_precincrement= thd->variables.div_precincrement;
+    vars->max_allowed_packet= thd->variables.max_allowed_packet;
+    vars->max_error_count= thd->variables.max_error_count;
+    vars->default_week_format= thd->variables.default_week_format;
+    vars->old_behavior= thd->variables.old_behavior;
+    w->mysys_var= thd_attach_thd(w->thd);
+  }
+  table->in_use= w->thd;
+  memcpy(table->record[0], table->s->default_values, table->s->reclength);
+  for (Item_sum **func= w->sums; *func; func++)
+    (*func)->aggregator_clear();
+  return table->record[0];
+}
+
+
+bool Parallel_aggregate::row(uint thread)
+{
+  Worker *w= &workers[thread];
+
+  w->examined++;
+  if (w->cond)
+  {
+    bool match= w->cond->val_int() != 0;
+    if (unlikely(w->thd->is_error()))
+      return true;
+    if (!match)
+      return false;
+  }
+  w->found++;
+  for (Item_sum **func= w->sums; *func; func++)
+  {
+    if ((*func)->aggregator_add())
+      return true;
+  }
+  return w->thd->is_error();
+}
+
+
+void Parallel_aggregate::end(uint thread)
+{
+  if (thread)
+    thd_detach_thd(workers[thread].mysys_var);
+}
+
+
 /**
   @brief
   Remove marked top conjuncts of a condition
@@ -248,6 +248,7 @@ class JOIN_CACHE;
 class SJ_TMP_TABLE;
 class JOIN_TAB_RANGE;
 class AGGR_OP;
+class Parallel_aggregate;
 class Filesort;
 struct SplM_plan_info;
 class SplM_opt_info;
@@ -313,6 +314,7 @@ typedef struct st_join_table {
   Table_access_tracker *jbuf_tracker;
   Time_and_counter_tracker *jbuf_unpack_tracker;
   Counter_tracker  *jbuf_loops_tracker;
+  Join_spill_tracker *jbuf_spill_tracker;
 
   //  READ_RECORD::Setup_func materialize_table;
   READ_RECORD::Setup_func read_first_record;
@@ -445,6 +447,11 @@ typedef struct st_join_table {
   */
   bool          idx_cond_fact_out;
   bool          use_join_cache;
+  /*
+    TRUE <=> the optimizer has costed the hash join of this table as
+    partitioned to disk when the join buffer is full (hash_join_spill)
+  */
+  bool          spill_to_disk;
   /* TRUE <=> it is prohibited to join this table using join buffer */
   bool          no_forced_join_cache;
   uint          used_join_cache_level;
@@ -455,6 +462,8 @@ typedef struct st_join_table {
   Item          *cache_idx_cond;
   SQL_SELECT    *cache_select;
   AGGR_OP       *aggr;
+  /* Parallel scan of the table for implicit grouping, or NULL */
+  Parallel_aggregate *parallel_aggr;
   JOIN		*join;
   /*
     Embedding SJ-nest (may be not the direct parent), or NULL if none.
@@ -1100,6 +1109,8 @@ class POSITION
   Sj_materialization_picker sjmat_picker;
 
   ulonglong refills;
+  /* TRUE <=> the hash join is costed as partitioned to disk, see refills */
+  bool spill_to_disk;
   /*
     Current optimization state: Semi-join strategy to be used for this
     and preceding join tables.
@@ -1155,6 +1166,75 @@ class JOIN_TAB_RANGE: public Sql_alloc
 
 class Pushdown_query;
 
+/**
+  @brief
+    In-memory hash table of the groups of GROUP BY, see
+    optimizer_switch='hash_group_by'
+
+  @details
+    Each group is the group key followed by a copy of the tmp table
+    record, in which the Item_sum objects keep their state, as in
+    end_update(). The groups are split into partitions by their hash
+    value. Each partition has its own MEM_ROOT and open addressing table.
+    When the groups take more memory than the tmp table could, the largest
+    partition is written to the tmp table and freed, and the rows of its
+    groups are from then on passed to the write_func of the AGGR_OP.
+*/
+
+class Hash_group_table :public Sql_alloc
+{
+public:
+  Hash_group_table(JOIN_TAB *tab) : join_tab(tab), active(false) {}
+
+  void start();
+  bool put_row(bool *aggregated);
+  bool flush();
+  void free();
+
+private:
+  /** The partition of a group is given by the top bits of its hash value */
+  static constexpr uint partition_bits= 4;
+  static constexpr uint n_partitions= 1U << partition_bits;
+
+  struct Slot
+  {
+    ulonglong hash;
+    /** The group key followed by the tmp table record; NULL if empty */
+    uchar *group;
+  };
+
+  struct Partition
+  {
+    MEM_ROOT mem_root;
+    /** Open addressing table with linear probing */
+    Slot *slots;
+    size_t capacity;
+    size_t n_groups;
+    /** Bytes used by the groups and the slots */
+    size_t memory;
+    /** Whether the groups were written to the tmp table */
+    bool spilled;
+  };
+
+  bool insert(Partition *part, ulonglong hash);
+  bool grow(Partition *part);
+  bool spill(Partition *part);
+  bool write_group(const uchar *group);
+  void free_partition(Partition *part);
+
+  JOIN_TAB *join_tab;
+  Partition partitions[n_partitions];
+  /** The group key of the tmp table when the execution started */
+  KEY *key_info;
+  uint key_parts;
+  uint key_length;
+  size_t group_size;
+  size_t memory_used;
+  size_t memory_limit;
+  bool active;
+};
+
+
 /**
   @brief
     Class to perform postjoin aggregation operations
@@ -1170,6 +1250,10 @@ class Pushdown_query;
                          Tmp table uses the heap engine
       end_update_unique  Same as above, but the engine is myisam.
 
+    With end_update, the groups may be kept in an in-memory hash table
+    (see Hash_group_table), and only the groups that do not fit in it
+    are passed to the write_func.
+
     Lazy table initialization is used - the table will be instantiated and
     rnd/index scan started on the first put_record() call.
 
@@ -1179,8 +1263,10 @@ class AGGR_OP :public Sql_alloc
 {
 public:
   JOIN_TAB *join_tab;
+  /** In-memory hash table for end_update(), or NULL */
+  Hash_group_table *hash_group;
 
-  AGGR_OP(JOIN_TAB *tab) : join_tab(tab), write_func(NULL)
+  AGGR_OP(JOIN_TAB *tab) : join_tab(tab), hash_group(NULL), write_func(NULL)
   {};
 
   enum_nested_loop_state put_record() { return put_record(false); };
@@ -1205,6 +1291,80 @@ class AGGR_OP :public Sql_alloc
 };
 
 
+/* The minimum number of rows for each thread of a Parallel_aggregate */
+#define PARALLEL_SCAN_MIN_ROWS 1000
+
+
+/**
+  @brief
+    Parallel scan of the only table of a query with implicit grouping
+
+  @details
+    The table is read by the storage engine in several threads (see
+    handler::parallel_scan()). Each thread has a copy of the TABLE with
+    its own record buffer, and its own copies of the WHERE condition and
+    of the aggregate functions, which it evaluates on the rows it reads.
+    Thread 0 is the query thread; the other threads run with a background
+    THD of their own, which is created when the thread starts the scan.
+    The helper threads of all queries are limited by
+    @@max_parallel_query_threads.
+
+    After the scan, the partial COUNT(), SUM(), MIN() and MAX() values
+    of each thread are added to the aggregate functions of the JOIN with
+    direct_add(), and passed to end_send_group() like a row would be.
+*/
+
+class Parallel_aggregate :public Sql_alloc, public Parallel_scan_visitor
+{
+public:
+  Parallel_aggregate(JOIN_TAB *tab, uint threads)
+    : join_tab(tab), n_threads(threads), n_sums(0), workers(NULL) {}
+
+  bool init();
+  uint threads() const { return n_threads; }
+  /**
+    Read the table and aggregate the rows.
+
+    @retval NESTED_LOOP_NO_MORE_ROWS  the rows were read and aggregated
+    @retval NESTED_LOOP_OK            the engine refused to scan the table
+                                      in parallel; read it as usual
+    @retval <0                        error or kill
+  */
+  enum_nested_loop_state run();
+
+  uchar *begin(uint thread) override;
+  bool row(uint thread) override;
+  void end(uint thread) override;
+
+private:
+  struct Worker
+  {
+    /**
+      The query THD for thread 0, otherwise a background THD;
+      NULL if the thread has not started
+    */
+    THD *thd;
+    TABLE *table;
+    /** Copy of the condition attached to the table, or NULL */
+    Item *cond;
+    /** Copies of join->sum_funcs */
+    Item_sum **sums;
+    /** mysys_var of the thread before thd was attached */
+    void *mysys_var;
+    ha_rows examined;
+    ha_rows found;
+  };
+
+  Item *clone_item(THD *thd, Item *item, TABLE *copy);
+  void harvest_diagnostics(Worker *w);
+
+  JOIN_TAB *join_tab;
+  uint n_threads;
+  uint n_sums;
+  Worker *workers;
+};
+
+
 class JOIN :public Sql_alloc
 {
 private:
@@ -1767,6 +1927,7 @@ class JOIN :public Sql_alloc
   bool optimize_constant_subqueries();
   bool make_range_rowid_filters();
   bool init_range_rowid_filters();
+  bool init_parallel_aggregate();
   bool make_sum_func_list(List<Item> &all_fields, List<Item> &send_fields,
 			  bool before_group_by);
 
@@ -2767,7 +2767,13 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
 
   if (thd->variables.sample_percentage == 0)
   {
-    if (file->records() < MIN_THRESHOLD_FOR_SAMPLING)
+    /*
+      The estimate from info() suffices. With HA_HAS_RECORDS, records()
+      would count the rows in an extra scan of the table.
+    */
+    ha_rows records= file->stats.records;
+
+    if (records < MIN_THRESHOLD_FOR_SAMPLING)
     {
       sample_fraction= 1;
     }
@@ -2775,7 +2781,7 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
     {
       sample_fraction= std::fmin(
                   (MIN_THRESHOLD_FOR_SAMPLING + 4096 *
-                   log(200 * file->records())) / file->records(), 1);
+                   log(200 * records)) / records, 1);
     }
   }
 
@@ -12105,7 +12105,7 @@ copy_data_between_tables(THD *thd, TABLE *from, TABLE *to,
   restore_record(to, s->default_values);        // Create empty record
   to->reset_default_fields();
 
-  thd->progress.max_counter= from->file->records();
+  thd->progress.max_counter= from->file->stats.records;
   time_to_report_progress= MY_HOW_OFTEN_TO_WRITE/10;
   if (!ignore) /* for now, InnoDB needs the undo log for ALTER IGNORE */
     to->file->extra(HA_EXTRA_BEGIN_ALTER_COPY);
@@ -2887,6 +2887,9 @@ export const char *optimizer_switch_names[]=
   "hash_join_cardinality",
   "cset_narrowing",
   "sargable_casefold",
+  "hash_join_spill",
+  "hash_join_bloom_filter",
+  "hash_group_by",
   "default",
   NullS
 };
@@ -3754,6 +3757,46 @@ static Sys_var_ulonglong Sys_sort_buffer(
        VALID_RANGE(MIN_SORT_MEMORY, SIZE_T_MAX), DEFAULT(MAX_SORT_MEMORY),
        BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_sort_threads(
+       "sort_threads",
+       "Maximum number of threads a filesort may use. When the rows to sort "
+       "do not fit in the sort buffer, full sort buffers are sorted and "
+       "written to disk by helper threads while the query thread reads "
+       "more rows, and the merge passes are run in parallel. Each helper "
+       "thread may allocate another sort buffer of sort_buffer_size bytes. "
+       "Set to 1 to sort on the query thread only",
+       SESSION_VAR(sort_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 256), DEFAULT(1), BLOCK_SIZE(1));
+
+static Sys_var_ulong Sys_max_sort_threads(
+       "max_sort_threads",
+       "Maximum number of filesort helper threads (see sort_threads) that "
+       "may run in the server at the same time. When the limit is reached, "
+       "a filesort starts fewer helper threads, or sorts on the query "
+       "thread only",
+       GLOBAL_VAR(max_sort_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 65536), DEFAULT(64), BLOCK_SIZE(1));
+
+static Sys_var_ulong Sys_max_parallel_query_threads(
+       "max_parallel_query_threads",
+       "Maximum number of helper threads of parallel scans (see "
+       "parallel_query_threads) that may run in the server at the same "
+       "time. When the limit is reached, a query starts fewer helper "
+       "threads, or reads the table on the query thread only",
+       GLOBAL_VAR(max_parallel_query_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 65536), DEFAULT(64), BLOCK_SIZE(1));
+
+static Sys_var_ulong Sys_parallel_query_threads(
+       "parallel_query_threads",
+       "Maximum number of threads that scan a table for a single-table "
+       "query with aggregate functions and no GROUP BY. Each thread "
+       "evaluates the WHERE condition and partial COUNT, SUM, MIN and MAX "
+       "values, which the query thread combines. Only used for engines "
+       "that support parallel scans, such as InnoDB. Set to 1 to scan on "
+       "the query thread only",
+       SESSION_VAR(parallel_query_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 256), DEFAULT(1), BLOCK_SIZE(1));
+
 export sql_mode_t expand_sql_mode(sql_mode_t sql_mode)
 {
   if (sql_mode & MODE_ANSI)
@@ -30,6 +30,9 @@ Created 03/11/2014 Shaohua Wang
 #include "btr0pcur.h"
 #include "page0page.h"
 #include "trx0trx.h"
+#include "gis0rtree.h"
+
+#include <algorithm>
 
 /** Innodb B-tree index fill factor for bulk load. */
 uint	innobase_fill_factor;
@@ -95,9 +98,19 @@ PageBulk::init()
 			page_create_zip(new_block, m_index, m_level, 0,
 					&m_mtr);
 		} else {
-			ut_ad(!m_index->is_spatial());
 			page_create(new_block, &m_mtr,
 				    m_index->table->not_redundant());
+			if (m_index->is_spatial()) {
+				m_mtr.write<1>(*new_block,
+					       FIL_PAGE_TYPE + 1 + new_page,
+					       byte(FIL_PAGE_RTREE));
+				if (mach_read_from_8(new_page
+						     + FIL_RTREE_SPLIT_SEQ_NUM)) {
+					m_mtr.memset(new_block,
+						     FIL_RTREE_SPLIT_SEQ_NUM,
+						     8, 0);
+				}
+			}
 			m_mtr.memset(*new_block, FIL_PAGE_PREV, 8, 0xff);
 			m_mtr.write<2,mtr_t::MAYBE_NOP>(*new_block, PAGE_HEADER
 							+ PAGE_LEVEL
@@ -527,8 +540,6 @@ and set page header members.
 @tparam compressed  whether the page is in ROW_FORMAT=COMPRESSED */
 inline void PageBulk::finish()
 {
-  ut_ad(!m_index->is_spatial());
-
   if (!needs_finish());
   else if (UNIV_LIKELY_NULL(m_page_zip))
     finishPage<COMPRESSED>();
@@ -587,8 +598,18 @@ PageBulk::getNodePtr()
 	/* Create node pointer */
 	first_rec = page_rec_get_next(page_get_infimum_rec(m_page));
 	ut_a(page_rec_is_user_rec(first_rec));
-	node_ptr = dict_index_build_node_ptr(m_index, first_rec, m_page_no,
-					     m_heap, m_level);
+
+	if (m_index->is_spatial()) {
+		rtr_mbr_t	mbr;
+
+		rtr_page_cal_mbr(m_index, m_block, &mbr, m_heap);
+		node_ptr = rtr_index_build_node_ptr(m_index, &mbr, first_rec,
+						    m_page_no, m_heap);
+	} else {
+		node_ptr = dict_index_build_node_ptr(m_index, first_rec,
+						     m_page_no, m_heap,
+						     m_level);
+	}
 
 	return(node_ptr);
 }
@@ -762,7 +783,22 @@ bool
 PageBulk::isSpaceAvailable(
 	ulint		rec_size)
 {
-	if (m_rec_no >= 8190) {
+	return isSpaceAvailable(m_rec_no, m_free_space, rec_size);
+}
+
+/** Check if required space would be available in the page for a record
+to be inserted after some records. We check fill factor & padding here.
+@param[in]	rec_no		number of records in the page
+@param[in]	free_space	free space left in the page
+@param[in]	rec_size	required length
+@return true	if space is available */
+bool
+PageBulk::isSpaceAvailable(
+	ulint		rec_no,
+	ulint		free_space,
+	ulint		rec_size) const
+{
+	if (rec_no >= 8190) {
 		ut_ad(srv_page_size == 65536);
 		return false;
 	}
@@ -770,23 +806,23 @@ PageBulk::isSpaceAvailable(
 	ulint	slot_size;
 	ulint	required_space;
 
-	slot_size = page_dir_calc_reserved_space(m_rec_no + 1)
-		- page_dir_calc_reserved_space(m_rec_no);
+	slot_size = page_dir_calc_reserved_space(rec_no + 1)
+		- page_dir_calc_reserved_space(rec_no);
 
 	required_space = rec_size + slot_size;
 
-	if (required_space > m_free_space) {
-		ut_ad(m_rec_no > 0);
+	if (required_space > free_space) {
+		ut_ad(rec_no > 0);
 		return false;
 	}
 
 	/* Fillfactor & Padding apply to both leaf and non-leaf pages.
 	Note: we keep at least 2 records in a page to avoid B-tree level
 	growing too high. */
-	if (m_rec_no >= 2
-	    && ((m_page_zip == NULL && m_free_space - required_space
+	if (rec_no >= 2
+	    && ((m_page_zip == NULL && free_space - required_space
 		 < m_reserved_space)
-		|| (m_page_zip != NULL && m_free_space - required_space
+		|| (m_page_zip != NULL && free_space - required_space
 		    < m_padding_space))) {
 		return(false);
 	}
@@ -1031,6 +1067,28 @@ BtrBulk::insert(
 
 	ut_ad(m_page_bulks.size() > level);
 
+	if (m_index->is_spatial()) {
+		return(rtrInsert(tuple, level));
+	}
+
+	return(insertTuple(tuple, level, is_left_most, false));
+}
+
+/** Insert a tuple to the current page in a level
+@param[in]	tuple		tuple to insert
+@param[in]	level		B-tree level
+@param[in]	is_left_most	whether the tuple is the first one of the level
+@param[in]	new_page	whether to start a new page unless the current
+				page is empty
+@return error code */
+dberr_t
+BtrBulk::insertTuple(
+	dtuple_t*	tuple,
+	ulint		level,
+	bool		is_left_most,
+	bool		new_page)
+{
+	dberr_t		err = DB_SUCCESS;
 	PageBulk*	page_bulk = m_page_bulks.at(level);
 
 	if (is_left_most && level > 0 && page_bulk->getRecNo() == 0) {
@@ -1065,7 +1123,8 @@ BtrBulk::insert(
 		goto func_exit;
 	}
 
-	if (!page_bulk->isSpaceAvailable(rec_size)) {
+	if ((new_page && page_bulk->getRecNo())
+	    || !page_bulk->isSpaceAvailable(rec_size)) {
 		/* Create a sibling page_bulk. */
 		PageBulk*	sibling_page_bulk;
 		sibling_page_bulk = UT_NEW_NOKEY(PageBulk(m_index, m_trx->id,
@@ -1139,6 +1198,133 @@ BtrBulk::insert(
 	return(err);
 }
 
+/** Compare two SPATIAL INDEX tuples in the order of an R-tree page:
+the predefined minimum record first, then by MBR, then by the PRIMARY KEY
+or the child page number.
+@param[in]	a	tuple
+@param[in]	b	tuple
+@return whether a is less than b */
+static bool rtr_bulk_tuple_less(const dtuple_t* a, const dtuple_t* b)
+{
+	if (dtuple_get_info_bits(b) & REC_INFO_MIN_REC_FLAG) {
+		return(false);
+	}
+
+	if (dtuple_get_info_bits(a) & REC_INFO_MIN_REC_FLAG) {
+		return(true);
+	}
+
+	ut_ad(dtuple_get_n_fields(a) == dtuple_get_n_fields(b));
+
+	if (int cmp = cmp_geometry_field(a->fields[0].data,
+					 b->fields[0].data)) {
+		return(cmp < 0);
+	}
+
+	for (ulint i = 1; i < dtuple_get_n_fields(a); i++) {
+		if (int cmp = cmp_dfield_dfield(&a->fields[i],
+						&b->fields[i])) {
+			return(cmp < 0);
+		}
+	}
+
+	return(false);
+}
+
+/** Buffer a tuple of a SPATIAL INDEX.
+@param[in]	tuple	tuple to insert
+@param[in]	level	R-tree level
+@return error code */
+dberr_t
+BtrBulk::rtrInsert(
+	dtuple_t*	tuple,
+	ulint		level)
+{
+	ut_ad(m_index->is_spatial());
+	ut_ad(m_page_bulks.size() > level);
+
+	const ulint	free_space = page_get_free_space_of_empty(
+		m_index->table->not_redundant());
+
+	while (m_rtr_batches.size() <= level) {
+		m_rtr_batches.push_back(
+			rtr_batch{mem_heap_create(1024), {}, free_space});
+	}
+
+	const ulint	rec_size = rec_get_converted_size(m_index, tuple, 0);
+	ulint		n = m_rtr_batches[level].tuples.size();
+
+	if (n && !m_page_bulks.at(level)->isSpaceAvailable(
+		    n, m_rtr_batches[level].free_space, rec_size)) {
+		if (dberr_t err = rtrFlush(level)) {
+			return(err);
+		}
+
+		n = 0;
+	}
+
+	/* The tuple may be allocated from a heap that will be emptied
+	before the batch is written. */
+	rtr_batch&	batch = m_rtr_batches[level];
+	dtuple_t*	copy = dtuple_copy(tuple, batch.heap);
+
+	for (ulint i = 0; i < dtuple_get_n_fields(copy); i++) {
+		dfield_dup(dtuple_get_nth_field(copy, i), batch.heap);
+	}
+
+	dtuple_set_info_bits(copy, dtuple_get_info_bits(tuple));
+	dtuple_set_n_fields_cmp(copy, dtuple_get_n_fields_cmp(tuple));
+
+	batch.free_space -= rec_size + page_dir_calc_reserved_space(n + 1)
+		- page_dir_calc_reserved_space(n);
+	batch.tuples.push_back(copy);
+
+	return(DB_SUCCESS);
+}
+
+/** Sort the buffered tuples of a SPATIAL INDEX level and write them
+to a new page.
+@param[in]	level	R-tree level
+@return error code */
+dberr_t
+BtrBulk::rtrFlush(
+	ulint		level)
+{
+	std::vector<dtuple_t*>	tuples;
+
+	/* Inserting the tuples may buffer node pointers in upper levels,
+	which may grow m_rtr_batches. */
+	tuples.swap(m_rtr_batches[level].tuples);
+	m_rtr_batches[level].free_space = page_get_free_space_of_empty(
+		m_index->table->not_redundant());
+
+	std::sort(tuples.begin(), tuples.end(), rtr_bulk_tuple_less);
+
+	PageBulk*	page_bulk = m_page_bulks.at(level);
+	bool		is_left_most = !page_bulk->getRecNo()
+		&& !page_has_prev(page_bulk->getPage());
+	bool		new_page = true;
+	dberr_t		err = DB_SUCCESS;
+
+	DBUG_EXECUTE_IF("row_merge_instrument_log_check_flush",
+			log_sys.set_check_for_checkpoint(););
+	DBUG_EXECUTE_IF("row_merge_ins_spatial_fail", return(DB_FAIL););
+
+	for (dtuple_t* tuple : tuples) {
+		err = insertTuple(tuple, level, is_left_most, new_page);
+
+		if (err != DB_SUCCESS) {
+			break;
+		}
+
+		is_left_most = new_page = false;
+	}
+
+	mem_heap_empty(m_rtr_batches[level].heap);
+
+	return(err);
+}
+
 /** Btree bulk load finish. We commit the last page in each level
 and copy the last page in top level to the root page of the index
 if no error occurs.
@@ -1161,6 +1347,12 @@ BtrBulk::finish(dberr_t	err)
 
 	/* Finish all page bulks */
 	for (ulint level = 0; level <= m_root_level; level++) {
+		if (err == DB_SUCCESS && level < m_rtr_batches.size()
+		    && !m_rtr_batches[level].tuples.empty()) {
+			/* This may add levels to the R-tree. */
+			err = rtrFlush(level);
+		}
+
 		PageBulk*	page_bulk = m_page_bulks.at(level);
 
 		last_page_no = page_bulk->getPageNo();
@@ -233,6 +233,11 @@ void btr_search_disable()
 		return;
 	}
 
+	/* Make btr_search_guess_on_hash() acquire the partition latches. */
+	for (ulong i = 0; i < btr_ahi_parts; ++i) {
+		btr_search_sys.parts[i].write_begin();
+	}
+
 	btr_search_enabled = false;
 
 	/* Clear the index->search_info->ref_count of every index in
@@ -251,6 +256,9 @@ void btr_search_disable()
 
 	dict_sys.unfreeze();
 
+	/* Wait for any lookups that were not holding a partition latch. */
+	btr_search_sys.wait_for_readers();
+
 	/* Set all block->index = NULL. */
 	buf_pool.clear_hash_index();
 
@@ -456,14 +464,13 @@ __attribute__((nonnull))
 Insert an entry into the hash table. If an entry with the same fold number
 is found, its node is updated to point to the new data, and no new node
 is inserted.
-@param table hash table
-@param heap  memory heap
+@param part  adaptive hash index partition
 @param fold  folded value of the record
 @param block buffer block containing the record
 @param data  the record
 @retval true on success
 @retval false if no more memory could be allocated */
-static bool ha_insert_for_fold(hash_table_t *table, mem_heap_t* heap,
+static bool ha_insert_for_fold(btr_search_sys_t::partition &part,
                                ulint fold,
 #if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
                                buf_block_t *block, /*!< buffer block of data */
@@ -475,13 +482,14 @@ static bool ha_insert_for_fold(hash_table_t *table, mem_heap_t* heap,
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
   ut_ad(btr_search_enabled);
 
-  hash_cell_t *cell= &table->array[table->calc_hash(fold)];
+  hash_cell_t *cell= &part.table.array[part.table.calc_hash(fold)];
 
   for (ha_node_t *prev= static_cast<ha_node_t*>(cell->node); prev;
        prev= prev->next)
   {
     if (prev->fold == fold)
     {
+      part.write_begin();
 #if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
       buf_block_t *prev_block= prev->block;
       ut_a(prev_block->page.frame == page_align(prev->data));
@@ -491,16 +499,24 @@ static bool ha_insert_for_fold(hash_table_t *table, mem_heap_t* heap,
       prev->block= block;
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
       prev->data= data;
+      part.write_end();
       return true;
     }
   }
 
   /* We have to allocate a new chain node */
-  ha_node_t *node= static_cast<ha_node_t*>(mem_heap_alloc(heap, sizeof *node));
+  ha_node_t *node= part.free_nodes;
 
-  if (!node)
+  if (node)
+  {
+    part.free_nodes= node->next;
+    part.n_free--;
+  }
+  else if (!(node= static_cast<ha_node_t*>(mem_heap_alloc(part.heap,
+                                                          sizeof *node))))
     return false;
 
+  part.write_begin();
   ha_node_set_data(node, block, data);
 
 #if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
@@ -509,106 +525,176 @@ static bool ha_insert_for_fold(hash_table_t *table, mem_heap_t* heap,
 
   node->fold= fold;
   node->next= nullptr;
+  /* Lookups that do not hold part.latch may follow the pointer to
+  node before validating part.seq. Initialize the node first. */
+  std::atomic_thread_fence(std::memory_order_release);
 
   ha_node_t *prev= static_cast<ha_node_t*>(cell->node);
   if (!prev)
-    cell->node= node;
+    my_atomic_storeptr_explicit(&cell->node, static_cast<void*>(node),
+                                MY_MEMORY_ORDER_RELAXED);
   else
   {
     while (prev->next)
       prev= prev->next;
     prev->next= node;
   }
+  part.write_end();
   return true;
 }
 
+/** Minimum length of btr_search_sys_t::partition::free_nodes
+for ha_free_nodes() to check btr_search_sys_t::readers */
+static constexpr ulint HA_FREE_NODES_MIN= 64;
+
+/** Free the memory of the nodes that were removed from the hash table,
+if no lookups that do not hold part.latch are in progress. Like
+ha_delete_hash_node() used to do for each node, the top of the heap
+is moved in the place of a removed node. The caller must have invoked
+part.write_begin(), so that no lookups can start to access the nodes.
+@param part      adaptive hash index partition */
+static void ha_free_nodes(btr_search_sys_t::partition &part)
+{
+  ut_ad(part.seq & 1);
+
+  if (part.n_free < HA_FREE_NODES_MIN || !btr_search_sys.readers_idle())
+    return;
+
+  /* Link the list in both directions. The fold of a free node is unused;
+  let it point to the preceding free node. */
+  ha_node_t *prev= nullptr;
+  for (ha_node_t *node= part.free_nodes; node; node= node->next)
+  {
+    ut_ad(!node->data);
+    node->fold= reinterpret_cast<ulint>(prev);
+    prev= node;
+  }
+
+  auto unlink= [&part](ha_node_t *node)
+  {
+    ha_node_t *prev= reinterpret_cast<ha_node_t*>(ulint{node->fold});
+    ha_node_t *next= node->next;
+    if (prev)
+      prev->next= next;
+    else
+      part.free_nodes= next;
+    if (next)
+      next->fold= reinterpret_cast<ulint>(prev);
+  };
+
+  while (ha_node_t *node= part.free_nodes)
+  {
+    ha_node_t *top= static_cast<ha_node_t*>
+      (mem_heap_get_top(part.heap, sizeof *top));
+
+    if (!top->data)
+      unlink(top);
+    else
+    {
+      /* Move the top in the place of a free node. */
+      unlink(node);
+      node->fold= ulint{top->fold};
+      node->next= top->next;
+      node->data= top->data;
+#if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
+      node->block= top->block;
+#endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
+      hash_cell_t *cell= &part.table.array[part.table.calc_hash(node->fold)];
+
+      if (cell->node == top)
+        cell->node= node;
+      else
+      {
+        ha_node_t *n= static_cast<ha_node_t*>(cell->node);
+        while (n->next != top)
+          n= n->next;
+        n->next= node;
+      }
+    }
+
+    mem_heap_free_top(part.heap, sizeof *top);
+  }
+
+  part.n_free= 0;
+}
+
 __attribute__((nonnull))
-/** Delete a record.
-@param table     hash table
-@param heap      memory heap
+/** Delete a record. The caller must invoke part.write_begin().
+The node will be reused by ha_insert_for_fold() or freed by
+ha_free_nodes(), because lookups that do not hold part.latch
+may be traversing it.
+@param part      adaptive hash index partition
 @param del_node  record to be deleted */
-static void ha_delete_hash_node(hash_table_t *table, mem_heap_t *heap,
+static void ha_delete_hash_node(btr_search_sys_t::partition &part,
                                 ha_node_t *del_node)
 {
   ut_ad(btr_search_enabled);
+  ut_ad(part.seq & 1);
 #if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
   ut_a(del_node->block->page.frame == page_align(del_node->data));
   ut_a(del_node->block->n_pointers-- < MAX_N_POINTERS);
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
 
-  const ulint fold= del_node->fold;
+  hash_cell_t *cell= &part.table.array[part.table.calc_hash(del_node->fold)];
 
-  HASH_DELETE(ha_node_t, next, table, fold, del_node);
-
-  ha_node_t *top= static_cast<ha_node_t*>(mem_heap_get_top(heap, sizeof *top));
-
-  if (del_node != top)
+  if (cell->node == del_node)
+    my_atomic_storeptr_explicit(&cell->node,
+                                static_cast<void*>(del_node->next),
+                                MY_MEMORY_ORDER_RELAXED);
+  else
   {
-    /* Compact the heap of nodes by moving the top in the place of del_node. */
-    *del_node= *top;
-    hash_cell_t *cell= &table->array[table->calc_hash(top->fold)];
-
-    /* Look for the pointer to the top node, to update it */
-    if (cell->node == top)
-      /* The top node is the first in the chain */
-      cell->node= del_node;
-    else
-    {
-      /* We have to look for the predecessor */
-      ha_node_t *node= static_cast<ha_node_t*>(cell->node);
-
-      while (top != HASH_GET_NEXT(next, node))
-        node= static_cast<ha_node_t*>(HASH_GET_NEXT(next, node));
-
-      /* Now we have the predecessor node */
-      node->next= del_node;
-    }
+    ha_node_t *node= static_cast<ha_node_t*>(cell->node);
+    while (node->next != del_node)
+      node= node->next;
+    node->next= del_node->next;
   }
 
-  /* Free the occupied space */
-  mem_heap_free_top(heap, sizeof *top);
+  del_node->data= nullptr;
+  del_node->next= part.free_nodes;
+  part.free_nodes= del_node;
+  part.n_free++;
 }
 
 __attribute__((nonnull))
 /** Delete all pointers to a page.
-@param table     hash table
-@param heap      memory heap
+@param part      adaptive hash index partition
+@param fold      folded value
 @param page      record to be deleted */
-static void ha_remove_all_nodes_to_page(hash_table_t *table, mem_heap_t *heap,
+static void ha_remove_all_nodes_to_page(btr_search_sys_t::partition &part,
                                         ulint fold, const page_t *page)
 {
-  for (ha_node_t *node= ha_chain_get_first(table, fold); node; )
+  part.write_begin();
+  for (ha_node_t *node= ha_chain_get_first(&part.table, fold); node; )
   {
+    ha_node_t *next= ha_chain_get_next(node);
     if (page_align(ha_node_get_data(node)) == page)
-    {
-      ha_delete_hash_node(table, heap, node);
-      /* The deletion may compact the heap of nodes and move other nodes! */
-      node= ha_chain_get_first(table, fold);
-    }
-    else
-      node= ha_chain_get_next(node);
+      ha_delete_hash_node(part, node);
+    node= next;
   }
+  ha_free_nodes(part);
+  part.write_end();
 #ifdef UNIV_DEBUG
   /* Check that all nodes really got deleted */
-  for (ha_node_t *node= ha_chain_get_first(table, fold); node;
+  for (ha_node_t *node= ha_chain_get_first(&part.table, fold); node;
        node= ha_chain_get_next(node))
     ut_ad(page_align(ha_node_get_data(node)) != page);
 #endif /* UNIV_DEBUG */
 }
 
 /** Delete a record if found.
-@param table     hash table
-@param heap      memory heap for the hash bucket chain
+@param part      adaptive hash index partition
 @param fold      folded value of the searched data
 @param data      pointer to the record
 @return whether the record was found */
-static bool ha_search_and_delete_if_found(hash_table_t *table,
-                                          mem_heap_t *heap,
+static bool ha_search_and_delete_if_found(btr_search_sys_t::partition &part,
                                           ulint fold, const rec_t *data)
 {
-  if (ha_node_t *node= ha_search_with_data(table, fold, data))
+  if (ha_node_t *node= ha_search_with_data(&part.table, fold, data))
   {
-    ha_delete_hash_node(table, heap, node);
+    part.write_begin();
+    ha_delete_hash_node(part, node);
+    ha_free_nodes(part);
+    part.write_end();
     return true;
   }
 
@@ -618,13 +704,13 @@ static bool ha_search_and_delete_if_found(hash_table_t *table,
 __attribute__((nonnull))
 /** Looks for an element when we know the pointer to the data and
 updates the pointer to data if found.
-@param table     hash table
+@param part      adaptive hash index partition
 @param fold      folded value of the searched data
 @param data      pointer to the data
 @param new_data  new pointer to the data
 @return whether the element was found */
-static bool ha_search_and_update_if_found(hash_table_t *table, ulint fold,
-                                          const rec_t *data,
+static bool ha_search_and_update_if_found(btr_search_sys_t::partition &part,
+                                          ulint fold, const rec_t *data,
 #if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
                                           /** block containing new_data */
                                           buf_block_t *new_block,
@@ -638,14 +724,16 @@ static bool ha_search_and_update_if_found(hash_table_t *table, ulint fold,
   if (!btr_search_enabled)
     return false;
 
-  if (ha_node_t *node= ha_search_with_data(table, fold, data))
+  if (ha_node_t *node= ha_search_with_data(&part.table, fold, data))
   {
+    part.write_begin();
 #if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
     ut_a(node->block->n_pointers-- < MAX_N_POINTERS);
     ut_a(new_block->n_pointers++ < MAX_N_POINTERS);
     node->block= new_block;
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
     node->data= new_data;
+    part.write_end();
 
     return true;
   }
@@ -655,9 +743,9 @@ static bool ha_search_and_update_if_found(hash_table_t *table, ulint fold,
 
 #if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
 #else
-# define ha_insert_for_fold(t,h,f,b,d) ha_insert_for_fold(t,h,f,d)
-# define ha_search_and_update_if_found(table,fold,data,new_block,new_data) \
-	ha_search_and_update_if_found(table,fold,data,new_data)
+# define ha_insert_for_fold(p,f,b,d) ha_insert_for_fold(p,f,d)
+# define ha_search_and_update_if_found(part,fold,data,new_block,new_data) \
+	ha_search_and_update_if_found(part,fold,data,new_data)
 #endif
 
 /** Updates a hash node reference when it has been unsuccessfully used in a
@@ -728,7 +816,7 @@ btr_search_update_hash_ref(
 			mem_heap_free(heap);
 		}
 
-		ha_insert_for_fold(&part->table, part->heap, fold, block, rec);
+		ha_insert_for_fold(*part, fold, block, rec);
 
 		MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_ADDED);
 	}
@@ -1015,6 +1103,132 @@ inline buf_block_t* buf_pool_t::block_from_ahi(const byte *ptr) const
   return block;
 }
 
+/** @return the btr_search_sys_t::readers[] slot of the current thread */
+static btr_search_sys_t::reader_slot &btr_search_reader_slot()
+{
+	static std::atomic<size_t> n_threads;
+	static thread_local const size_t slot = n_threads.fetch_add(
+		1, std::memory_order_relaxed)
+		% btr_search_sys_t::N_READER_SLOTS;
+	return btr_search_sys.readers[slot];
+}
+
+/** Maximum number of hash chain nodes to traverse without holding
+the partition latch */
+static constexpr ulint BTR_SEARCH_LOCK_FREE_MAX_CHAIN = 256;
+
+/** Outcome of btr_search_guess_lock_free() */
+enum btr_search_lock_free_t {
+	/** the block was latched and buffer-fixed */
+	BTR_SEARCH_LOCK_FREE_FOUND,
+	/** the lookup failed */
+	BTR_SEARCH_LOCK_FREE_FAIL,
+	/** the lookup must be retried while holding the partition latch */
+	BTR_SEARCH_LOCK_FREE_RETRY
+};
+
+/** Look up the adaptive hash index without acquiring the partition latch.
+The hash chain is read optimistically, and the result is validated by
+btr_search_sys_t::partition::seq. Because ha_delete_hash_node() does
+not free any memory, a concurrent modification can only make us read
+a stale node, which the validation will detect. Memory is only freed
+by ha_free_nodes() or btr_search_disable() while we are not registered
+in btr_search_sys_t::readers.
+@param part        adaptive hash index partition
+@param index       index tree
+@param fold        folded value of the search tuple
+@param latch_mode  BTR_SEARCH_LEAF or BTR_MODIFY_LEAF
+@param block       the block that contains rec
+@param rec         the record that was found
+@return outcome of the lookup */
+static btr_search_lock_free_t
+btr_search_guess_lock_free(
+	const btr_search_sys_t::partition*	part,
+	const dict_index_t*			index,
+	ulint					fold,
+	ulint					latch_mode,
+	buf_block_t**				block,
+	const rec_t**				rec)
+{
+	btr_search_sys_t::reader_guard	reader{btr_search_reader_slot()};
+	const uint32_t			seq = part->seq.load();
+
+	if (seq & 1) {
+		/* The partition is being modified or it is disabled. */
+		return BTR_SEARCH_LOCK_FREE_RETRY;
+	}
+
+	*rec = nullptr;
+	ulint	n = 0;
+
+	for (const ha_node_t* node = static_cast<const ha_node_t*>(
+		     my_atomic_loadptr_explicit(
+			     &part->table.array[part->table.calc_hash(fold)]
+			     .node, MY_MEMORY_ORDER_RELAXED));
+	     node; node = node->next) {
+		if (++n > BTR_SEARCH_LOCK_FREE_MAX_CHAIN) {
+			return BTR_SEARCH_LOCK_FREE_RETRY;
+		}
+		if (node->fold == fold) {
+			*rec = node->data;
+			break;
+		}
+	}
+
+	if (!part->validate(seq)) {
+		return BTR_SEARCH_LOCK_FREE_RETRY;
+	}
+
+	if (!*rec) {
+		return BTR_SEARCH_LOCK_FREE_FAIL;
+	}
+
+	buf_block_t* b = *block = buf_pool.block_from_ahi(*rec);
+
+	buf_pool_t::hash_chain& chain = buf_pool.page_hash.cell_get(
+		b->page.id().fold());
+	bool got_latch;
+	{
+		transactional_shared_lock_guard<page_hash_latch> g{
+			buf_pool.page_hash.lock_get(chain)};
+		got_latch = (latch_mode == BTR_SEARCH_LEAF)
+			? b->page.lock.s_lock_try()
+			: b->page.lock.x_lock_try();
+	}
+
+	if (!got_latch) {
+		return BTR_SEARCH_LOCK_FREE_FAIL;
+	}
+
+	const auto state = b->page.state();
+	btr_search_lock_free_t result = BTR_SEARCH_LOCK_FREE_FAIL;
+
+	/* Another thread that is holding b->page.lock in shared mode
+	may concurrently invoke btr_search_drop_page_hash_index() and
+	free b->index. Do not dereference b->index. If it differs from
+	index, the guess would fail in btr_page_get_index_id() anyway,
+	or it would point to an index that is being freed. */
+	if (UNIV_LIKELY(state >= buf_page_t::UNFIXED) && b->index == index) {
+		if (part->validate(seq)) {
+			ut_ad(state < buf_page_t::READ_FIX
+			      || state >= buf_page_t::WRITE_FIX);
+			ut_ad(state < buf_page_t::READ_FIX
+			      || latch_mode == BTR_SEARCH_LEAF);
+			b->page.fix();
+			return BTR_SEARCH_LOCK_FREE_FOUND;
+		}
+		result = BTR_SEARCH_LOCK_FREE_RETRY;
+	}
+
+	if (latch_mode == BTR_SEARCH_LEAF) {
+		b->page.lock.s_unlock();
+	} else {
+		b->page.lock.x_unlock();
+	}
+
+	return result;
+}
+
 /** Tries to guess the right search position based on the hash search info
 of the index. Note that if mode is PAGE_CUR_LE, which is used in inserts,
 and the function returns TRUE, then cursor->up_match and cursor->low_match
@@ -1079,6 +1293,17 @@ btr_search_guess_on_hash(
 
 	auto part = btr_search_sys.get_part(*index);
 	const rec_t* rec;
+	buf_block_t* block;
+
+	switch (btr_search_guess_lock_free(part, index, fold, latch_mode,
+					   &block, &rec)) {
+	case BTR_SEARCH_LOCK_FREE_FOUND:
+		goto block_fixed;
+	case BTR_SEARCH_LOCK_FREE_FAIL:
+		goto fail;
+	case BTR_SEARCH_LOCK_FREE_RETRY:
+		break;
+	}
 
 	part->latch.rd_lock(SRW_LOCK_CALL);
 
@@ -1097,52 +1322,57 @@ btr_search_guess_on_hash(
 		return false;
 	}
 
-	buf_block_t* block = buf_pool.block_from_ahi(rec);
-
-	buf_pool_t::hash_chain& chain = buf_pool.page_hash.cell_get(
-		block->page.id().fold());
-	bool got_latch;
 	{
-		transactional_shared_lock_guard<page_hash_latch> g{
-			buf_pool.page_hash.lock_get(chain)};
-		got_latch = (latch_mode == BTR_SEARCH_LEAF)
-			? block->page.lock.s_lock_try()
-			: block->page.lock.x_lock_try();
-	}
+		block = buf_pool.block_from_ahi(rec);
+
+		buf_pool_t::hash_chain& chain = buf_pool.page_hash.cell_get(
+			block->page.id().fold());
+		bool got_latch;
+		{
+			transactional_shared_lock_guard<page_hash_latch> g{
+				buf_pool.page_hash.lock_get(chain)};
+			got_latch = (latch_mode == BTR_SEARCH_LEAF)
+				? block->page.lock.s_lock_try()
+				: block->page.lock.x_lock_try();
+		}
 
-	if (!got_latch) {
-		goto ahi_release_and_fail;
-	}
+		if (!got_latch) {
+			goto ahi_release_and_fail;
+		}
 
-	const auto state = block->page.state();
-	if (UNIV_UNLIKELY(state < buf_page_t::UNFIXED)) {
-		ut_ad(state == buf_page_t::REMOVE_HASH);
+		const auto state = block->page.state();
+		if (UNIV_UNLIKELY(state < buf_page_t::UNFIXED)) {
+			ut_ad(state == buf_page_t::REMOVE_HASH);
 block_and_ahi_release_and_fail:
-		if (latch_mode == BTR_SEARCH_LEAF) {
-			block->page.lock.s_unlock();
-		} else {
-			block->page.lock.x_unlock();
+			if (latch_mode == BTR_SEARCH_LEAF) {
+				block->page.lock.s_unlock();
+			} else {
+				block->page.lock.x_unlock();
+			}
+			goto ahi_release_and_fail;
 		}
-		goto ahi_release_and_fail;
-	}
 
-	ut_ad(state < buf_page_t::READ_FIX || state >= buf_page_t::WRITE_FIX);
-	ut_ad(state < buf_page_t::READ_FIX || latch_mode == BTR_SEARCH_LEAF);
+		ut_ad(state < buf_page_t::READ_FIX
+		      || state >= buf_page_t::WRITE_FIX);
+		ut_ad(state < buf_page_t::READ_FIX
+		      || latch_mode == BTR_SEARCH_LEAF);
+
+		if (index != block->index && index_id == block->index->id) {
+			ut_a(block->index->freed());
+			goto block_and_ahi_release_and_fail;
+		}
 
-	if (index != block->index && index_id == block->index->id) {
-		ut_a(block->index->freed());
-		goto block_and_ahi_release_and_fail;
+		block->page.fix();
+		part->latch.rd_unlock();
 	}
 
-	block->page.fix();
+block_fixed:
 	buf_page_make_young_if_needed(&block->page);
 	static_assert(ulint{MTR_MEMO_PAGE_S_FIX} == ulint{BTR_SEARCH_LEAF},
 		      "");
 	static_assert(ulint{MTR_MEMO_PAGE_X_FIX} == ulint{BTR_MODIFY_LEAF},
 		      "");
 
-	part->latch.rd_unlock();
-
 	++buf_pool.stat.n_page_gets;
 
 	mtr->memo_push(block, mtr_memo_type_t(latch_mode));
@@ -1356,8 +1586,7 @@ void btr_search_drop_page_hash_index(buf_block_t* block,
 	}
 
 	for (ulint i = 0; i < n_cached; i++) {
-		ha_remove_all_nodes_to_page(&part->table, part->heap,
-					    folds[i], page);
+		ha_remove_all_nodes_to_page(*part, folds[i], page);
 	}
 
 	switch (index->search_info->ref_count--) {
@@ -1601,8 +1830,7 @@ btr_search_build_page_hash_index(
 	{
 		auto part = btr_search_sys.get_part(*index);
 		for (ulint i = 0; i < n_cached; i++) {
-			ha_insert_for_fold(&part->table, part->heap,
-					   folds[i], block, recs[i]);
+			ha_insert_for_fold(*part, folds[i], block, recs[i]);
 		}
 	}
 
@@ -1797,7 +2025,7 @@ void btr_search_update_hash_on_delete(btr_cur_t *cursor)
 	if (block->index && btr_search_enabled) {
 		ut_a(block->index == index);
 
-		if (ha_search_and_delete_if_found(&part->table, part->heap,
+		if (ha_search_and_delete_if_found(*part,
 						  fold, rec)) {
 			MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_REMOVED);
 		} else {
@@ -1865,8 +2093,7 @@ void btr_search_update_hash_node_on_insert(btr_cur_t *cursor,
 	    && !block->curr_left_side) {
 		if (const rec_t *new_rec = page_rec_get_next_const(rec)) {
 			if (ha_search_and_update_if_found(
-				&btr_search_sys.get_part(*cursor->index())
-				->table,
+				*btr_search_sys.get_part(*cursor->index()),
 				cursor->fold, rec, block, new_rec)) {
 				MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_UPDATED);
 			}
@@ -1984,8 +2211,7 @@ void btr_search_update_hash_on_insert(btr_cur_t *cursor,
 			}
 
 			part = btr_search_sys.get_part(*index);
-			ha_insert_for_fold(&part->table, part->heap,
-					   ins_fold, block, ins_rec);
+			ha_insert_for_fold(*part, ins_fold, block, ins_rec);
 			MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_ADDED);
 		}
 
@@ -2006,11 +2232,9 @@ void btr_search_update_hash_on_insert(btr_cur_t *cursor,
 		}
 
 		if (!left_side) {
-			ha_insert_for_fold(&part->table, part->heap,
-					   fold, block, rec);
+			ha_insert_for_fold(*part, fold, block, rec);
 		} else {
-			ha_insert_for_fold(&part->table, part->heap,
-					   ins_fold, block, ins_rec);
+			ha_insert_for_fold(*part, ins_fold, block, ins_rec);
 		}
 		MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_ADDED);
 	}
@@ -2030,8 +2254,7 @@ void btr_search_update_hash_on_insert(btr_cur_t *cursor,
 				part = btr_search_sys.get_part(*index);
 			}
 
-			ha_insert_for_fold(&part->table, part->heap,
-					   ins_fold, block, ins_rec);
+			ha_insert_for_fold(*part, ins_fold, block, ins_rec);
 			MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_ADDED);
 		}
 
@@ -2051,11 +2274,9 @@ void btr_search_update_hash_on_insert(btr_cur_t *cursor,
 		}
 
 		if (!left_side) {
-			ha_insert_for_fold(&part->table, part->heap,
-					   ins_fold, block, ins_rec);
+			ha_insert_for_fold(*part, ins_fold, block, ins_rec);
 		} else {
-			ha_insert_for_fold(&part->table, part->heap,
-					   next_fold, block, next_rec);
+			ha_insert_for_fold(*part, next_fold, block, next_rec);
 		}
 		MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_ADDED);
 	}
@@ -2169,7 +2390,8 @@ static bool btr_search_hash_table_validate(THD *thd, ulint hash_table_id)
 
 		for (; node != NULL; node = node->next) {
 			const buf_block_t*	block
-				= buf_pool.block_from_ahi((byte*) node->data);
+				= buf_pool.block_from_ahi(
+					ha_node_get_data(node));
 			index_id_t		page_index_id;
 
 			if (UNIV_LIKELY(block->page.in_file())) {
@@ -2223,7 +2445,7 @@ static bool btr_search_hash_table_validate(THD *thd, ulint hash_table_id)
 					<< block->page.id()
 					<< ", ptr mem address "
 					<< reinterpret_cast<const void*>(
-						node->data)
+						ha_node_get_data(node))
 					<< ", index id " << page_index_id
 					<< ", node fold " << node->fold
 					<< ", rec fold " << fold;
@@ -44,6 +44,7 @@ Created 11/5/1995 Heikki Tuuri
 #include "buf0flu.h"
 #include "buf0buddy.h"
 #include "buf0dblwr.h"
+#include "buf0l2.h"
 #include "lock0lock.h"
 #include "btr0sea.h"
 #include "trx0undo.h"
@@ -1059,7 +1060,35 @@ inline bool buf_pool_t::chunk_t::create(size_t bytes)
   MEM_UNDEFINED(mem, mem_size());
 
 #ifdef HAVE_LIBNUMA
-  if (srv_numa_interleave)
+  if (srv_numa_local_chunks && numa_available() != -1)
+  {
+    /* Bind the chunks to the allowed NUMA nodes in turn. Chunks are
+    only created by buf_pool_t::create() and buf_pool_t::resize(). */
+    static int next_node= -1;
+    struct bitmask *numa_mems_allowed= numa_get_mems_allowed();
+    const int max_node= numa_max_node();
+    int node= next_node;
+    for (int i= 0; i <= max_node; i++)
+    {
+      node= node >= max_node ? 0 : node + 1;
+      if (numa_bitmask_isbitset(numa_mems_allowed, node))
+        break;
+    }
+    numa_bitmask_free(numa_mems_allowed);
+    next_node= node;
+
+    struct bitmask *node_mask= numa_allocate_nodemask();
+    numa_bitmask_setbit(node_mask, node);
+    if (mbind(mem, mem_size(), MPOL_PREFERRED, node_mask->maskp,
+              node_mask->size, MPOL_MF_MOVE))
+    {
+      ib::warn() << "Failed to set NUMA memory policy of"
+              " buffer pool page frames to MPOL_PREFERRED"
+              " (error: " << strerror(errno) << ").";
+    }
+    numa_bitmask_free(node_mask);
+  }
+  else if (srv_numa_interleave)
   {
     struct bitmask *numa_mems_allowed= numa_get_mems_allowed();
     if (mbind(mem, mem_size(), MPOL_INTERLEAVE,
@@ -3191,6 +3220,10 @@ static buf_block_t *buf_page_create_low(page_id_t page_id, ulint zip_size,
   DBUG_PRINT("ib_buf", ("create page %u:%u",
                         page_id.space(), page_id.page_no()));
 
+  /* A freed page may have been discarded from buf_pool without
+  buf_l2_t::evict(). Discard any older copy of the page. */
+  buf_l2.invalidate(page_id);
+
   bpage= &free_block->page;
 
   ut_ad(bpage->state() == buf_page_t::MEMORY);
@@ -3259,7 +3292,12 @@ buf_page_create(fil_space_t *space, uint32_t offset,
                 ulint zip_size, mtr_t *mtr, buf_block_t *free_block)
 {
   space->free_page(offset, false);
-  return buf_page_create_low({space->id, offset}, zip_size, mtr, free_block);
+  buf_block_t *block=
+    buf_page_create_low({space->id, offset}, zip_size, mtr, free_block);
+  if (UNIV_UNLIKELY(recv_sys.online))
+    /* Any buffered log for the previous contents must be discarded. */
+    recv_sys.discard(block->page.id());
+  return block;
 }
 
 /** Initialize a page in buffer pool while initializing the
@@ -3527,7 +3565,7 @@ dberr_t buf_page_t::read_complete(const fil_node_t &node)
     }
   }
 
-  const bool recovery= frame && recv_recovery_is_on();
+  const bool recovery= frame && recv_recovery_is_pending();
 
   if (recovery && !recv_recover_page(node.space, this))
     return DB_PAGE_CORRUPTED;
@@ -50,6 +50,9 @@ void buf_dblwr_t::init()
 {
   if (!active_slot)
   {
+    n_batches= srv_doublewrite_batches;
+    ut_ad(n_batches >= 1);
+    ut_ad(n_batches <= MAX_BATCHES);
     active_slot= &slots[0];
     mysql_mutex_init(buf_dblwr_mutex_key, &mutex, nullptr);
     pthread_cond_init(&cond, nullptr);
@@ -62,18 +65,26 @@ inline void buf_dblwr_t::init(const byte *header)
 {
   ut_ad(!active_slot->first_free);
   ut_ad(!active_slot->reserved);
-  ut_ad(!batch_running);
+  ut_ad(!n_running);
 
   block1= page_id_t(0, mach_read_from_4(header + TRX_SYS_DOUBLEWRITE_BLOCK1));
   block2= page_id_t(0, mach_read_from_4(header + TRX_SYS_DOUBLEWRITE_BLOCK2));
 
-  const uint32_t buf_size= 2 * block_size();
-  for (int i= 0; i < 2; i++)
+  /* The buffers of all slots are allocated contiguously, so that
+  init_or_load_pages() can read both doublewrite blocks to slots[0]. */
+  const ulint buf_size= batch_size();
+  const ulint n_slots= n_batches + 1;
+  ut_ad(n_slots * buf_size >= 2 * block_size());
+  byte *write_buf= static_cast<byte*>
+    (aligned_malloc((n_slots * buf_size) << srv_page_size_shift,
+                    srv_page_size));
+  element *arr= static_cast<element*>
+    (ut_zalloc_nokey(n_slots * buf_size * sizeof(element)));
+  for (ulint i= 0; i < n_slots; i++)
   {
-    slots[i].write_buf= static_cast<byte*>
-      (aligned_malloc(buf_size << srv_page_size_shift, srv_page_size));
-    slots[i].buf_block_arr= static_cast<element*>
-      (ut_zalloc_nokey(buf_size * sizeof(element)));
+    slots[i].write_buf= write_buf + ((i * buf_size) << srv_page_size_shift);
+    slots[i].buf_block_arr= arr + i * buf_size;
+    slots[i].area= NOT_RUNNING;
   }
   active_slot= &slots[0];
 }
@@ -463,31 +474,30 @@ void buf_dblwr_t::close()
 
   ut_ad(!active_slot->reserved);
   ut_ad(!active_slot->first_free);
-  ut_ad(!batch_running);
+  ut_ad(!n_running);
 
   pthread_cond_destroy(&cond);
-  for (int i= 0; i < 2; i++)
-  {
-    aligned_free(slots[i].write_buf);
-    ut_free(slots[i].buf_block_arr);
-  }
+  aligned_free(slots[0].write_buf);
+  ut_free(slots[0].buf_block_arr);
   mysql_mutex_destroy(&mutex);
 
   memset((void*) this, 0, sizeof *this);
 }
 
 /** Update the doublewrite buffer on write completion. */
-void buf_dblwr_t::write_completed()
+void buf_dblwr_t::write_completed(const IORequest &request)
 {
   ut_ad(this == &buf_dblwr);
   ut_ad(!srv_read_only_mode);
+  ut_ad(request.dblwr_batch);
 
   mysql_mutex_lock(&mutex);
 
   ut_ad(is_created());
   ut_ad(srv_use_doublewrite_buf);
-  ut_ad(batch_running);
-  slot *flush_slot= active_slot == &slots[0] ? &slots[1] : &slots[0];
+  ut_ad(request.dblwr_batch <= n_batches + 1);
+  slot *flush_slot= &slots[request.dblwr_batch - 1];
+  ut_ad(flush_slot->area != NOT_RUNNING);
   ut_ad(flush_slot->reserved);
   ut_ad(flush_slot->reserved <= flush_slot->first_free);
 
@@ -498,9 +508,10 @@ void buf_dblwr_t::write_completed()
     fil_flush_file_spaces();
     mysql_mutex_lock(&mutex);
 
-    /* We can now reuse the doublewrite memory buffer: */
+    /* We can now reuse the doublewrite memory buffer and area: */
     flush_slot->first_free= 0;
-    batch_running= false;
+    flush_slot->area= NOT_RUNNING;
+    n_running--;
     pthread_cond_broadcast(&cond);
   }
 
@@ -568,38 +579,91 @@ static void buf_dblwr_check_block(const buf_page_t *bpage)
 }
 #endif /* UNIV_DEBUG */
 
-bool buf_dblwr_t::flush_buffered_writes(const ulint size)
+inline void buf_dblwr_t::write_batch(slot *s, ulint area)
+{
+  const uint32_t size= block_size();
+  const IORequest request{nullptr, nullptr,
+                          fil_system.sys_space->chain.start,
+                          IORequest::DBLWR_BATCH, uint8_t(s - slots + 1)};
+  /* The pages of the area, counted from the start of block1 */
+  const ulint start= area * batch_size(), end= start + s->first_free;
+  ut_ad(end <= 2 * size);
+  ut_a(fil_system.sys_space->acquire());
+
+  if (s->flushing_buffered_writes == 1)
+  {
+    const uint32_t page_no= start < size
+      ? block1.page_no() + uint32_t(start)
+      : block2.page_no() + uint32_t(start - size);
+    os_aio(request, s->write_buf, os_offset_t{page_no} << srv_page_size_shift,
+           s->first_free << srv_page_size_shift);
+  }
+  else
+  {
+    /* The area spans the end of block1 and the start of block2. */
+    fil_system.sys_space->reacquire();
+    const ulint n= size - start;
+    os_aio(request, s->write_buf,
+           os_offset_t{block1.page_no() + start} << srv_page_size_shift,
+           n << srv_page_size_shift);
+    os_aio(request, s->write_buf + (n << srv_page_size_shift),
+           os_offset_t{block2.page_no()} << srv_page_size_shift,
+           (end - size) << srv_page_size_shift);
+  }
+}
+
+bool buf_dblwr_t::flush_buffered_writes_low()
 {
   mysql_mutex_assert_owner(&mutex);
-  ut_ad(size == block_size());
 
   for (;;)
   {
     if (!active_slot->first_free)
       return false;
-    if (!batch_running)
+    if (n_running < n_batches)
       break;
     my_cond_wait(&cond, &mutex.m_mutex);
   }
 
   ut_ad(active_slot->reserved == active_slot->first_free);
-  ut_ad(!flushing_buffered_writes);
-
-  /* Disallow anyone else to start another batch of flushing. */
+  ut_ad(active_slot->area == NOT_RUNNING);
+
+  /* Pick an idle doublewrite area. */
+  ulint busy= 0;
+  for (ulint i= 0; i <= n_batches; i++)
+    if (slots[i].area != NOT_RUNNING)
+      busy|= ulint{1} << slots[i].area;
+  ulint area= 0;
+  while (busy & (ulint{1} << area))
+    area++;
+  DBUG_EXECUTE_IF("ib_dblwr_rotate_area",
+                  /* Use all areas even if the writes complete quickly */
+                  static ulint next_area;
+                  for (ulint i= 0; i < n_batches; i++)
+                    if (!(busy & (ulint{1} << (++next_area % n_batches))))
+                    {
+                      area= next_area % n_batches;
+                      break;
+                    });
+  ut_ad(area < n_batches);
+
+  /* Disallow anyone else to add to this batch. */
   slot *flush_slot= active_slot;
+  flush_slot->area= area;
+  n_running++;
   /* Switch the active slot */
-  active_slot= active_slot == &slots[0] ? &slots[1] : &slots[0];
+  for (active_slot= slots; active_slot->area != NOT_RUNNING; active_slot++);
+  ut_ad(active_slot < slots + n_batches + 1);
   ut_a(active_slot->first_free == 0);
-  batch_running= true;
-  const ulint old_first_free= flush_slot->first_free;
-  auto write_buf= flush_slot->write_buf;
+  const ulint start= area * batch_size(), size= block_size();
   const bool multi_batch= block1 + static_cast<uint32_t>(size) != block2 &&
-    old_first_free > size;
-  flushing_buffered_writes= 1 + multi_batch;
+    start < size && start + flush_slot->first_free > size;
+  flush_slot->flushing_buffered_writes= 1 + multi_batch;
   /* Now safe to release the mutex. */
   mysql_mutex_unlock(&mutex);
 #ifdef UNIV_DEBUG
-  for (ulint len2= 0, i= 0; i < old_first_free; len2 += srv_page_size, i++)
+  for (ulint len2= 0, i= 0; i < flush_slot->first_free;
+       len2 += srv_page_size, i++)
   {
     buf_page_t *bpage= flush_slot->buf_block_arr[i].request.bpage;
 
@@ -610,26 +674,10 @@ bool buf_dblwr_t::flush_buffered_writes(const ulint size)
     /* Check that the actual page in the buffer pool is not corrupt
     and the LSN values are sane. */
     buf_dblwr_check_block(bpage);
-    ut_d(buf_dblwr_check_page_lsn(*bpage, write_buf + len2));
+    ut_d(buf_dblwr_check_page_lsn(*bpage, flush_slot->write_buf + len2));
   }
 #endif /* UNIV_DEBUG */
-  const IORequest request{nullptr, nullptr, fil_system.sys_space->chain.start,
-                          IORequest::DBLWR_BATCH};
-  ut_a(fil_system.sys_space->acquire());
-  if (multi_batch)
-  {
-    fil_system.sys_space->reacquire();
-    os_aio(request, write_buf,
-           os_offset_t{block1.page_no()} << srv_page_size_shift,
-           size << srv_page_size_shift);
-    os_aio(request, write_buf + (size << srv_page_size_shift),
-           os_offset_t{block2.page_no()} << srv_page_size_shift,
-           (old_first_free - size) << srv_page_size_shift);
-  }
-  else
-    os_aio(request, write_buf,
-           os_offset_t{block1.page_no()} << srv_page_size_shift,
-           old_first_free << srv_page_size_shift);
+  write_batch(flush_slot, area);
   return true;
 }
 
@@ -650,18 +698,20 @@ void buf_dblwr_t::flush_buffered_writes_completed(const IORequest &request)
   ut_ad(!request.bpage);
   ut_ad(request.node == fil_system.sys_space->chain.start);
   ut_ad(request.type == IORequest::DBLWR_BATCH);
+  ut_ad(request.dblwr_batch);
+  ut_ad(request.dblwr_batch <= n_batches + 1);
+  slot *const flush_slot= &slots[request.dblwr_batch - 1];
   mysql_mutex_lock(&mutex);
-  ut_ad(batch_running);
-  ut_ad(flushing_buffered_writes);
-  ut_ad(flushing_buffered_writes <= 2);
+  ut_ad(flush_slot->area != NOT_RUNNING);
+  ut_ad(flush_slot->flushing_buffered_writes);
+  ut_ad(flush_slot->flushing_buffered_writes <= 2);
   writes_completed++;
-  if (UNIV_UNLIKELY(--flushing_buffered_writes))
+  if (UNIV_UNLIKELY(--flush_slot->flushing_buffered_writes))
   {
     mysql_mutex_unlock(&mutex);
     return;
   }
 
-  slot *const flush_slot= active_slot == &slots[0] ? &slots[1] : &slots[0];
   ut_ad(flush_slot->reserved == flush_slot->first_free);
   /* increment the doublewrite flushed pages counter */
   pages_written+= flush_slot->first_free;
@@ -674,7 +724,7 @@ void buf_dblwr_t::flush_buffered_writes_completed(const IORequest &request)
   find them in the doublewrite buffer blocks. Next, write the data pages. */
   for (ulint i= 0, first_free= flush_slot->first_free; i < first_free; i++)
   {
-    auto e= flush_slot->buf_block_arr[i];
+    const element &e= flush_slot->buf_block_arr[i];
     buf_page_t* bpage= e.request.bpage;
     ut_ad(bpage->in_file());
 
@@ -700,8 +750,10 @@ void buf_dblwr_t::flush_buffered_writes_completed(const IORequest &request)
     ut_ad(lsn);
     ut_ad(lsn >= bpage->oldest_modification());
     log_write_up_to(lsn, true);
-    e.request.node->space->io(e.request, bpage->physical_offset(), e_size,
-                              frame, bpage);
+    e.request.node->space->io(IORequest{bpage, e.request.slot,
+                                        e.request.node, e.request.type,
+                                        request.dblwr_batch},
+                              bpage->physical_offset(), e_size, frame, bpage);
   }
 }
 
@@ -718,10 +770,9 @@ void buf_dblwr_t::flush_buffered_writes()
   }
 
   ut_ad(!srv_read_only_mode);
-  const ulint size= block_size();
 
   mysql_mutex_lock(&mutex);
-  if (!flush_buffered_writes(size))
+  if (!flush_buffered_writes_low())
     mysql_mutex_unlock(&mutex);
 }
 
@@ -741,17 +792,17 @@ void buf_dblwr_t::add_to_batch(const IORequest &request, size_t size)
   ut_ad(request.node->space->referenced());
   ut_ad(!srv_read_only_mode);
 
-  const ulint buf_size= 2 * block_size();
-
   mysql_mutex_lock(&mutex);
 
+  const ulint buf_size= batch_size();
+
   for (;;)
   {
     ut_ad(active_slot->first_free <= buf_size);
     if (active_slot->first_free != buf_size)
       break;
 
-    if (flush_buffered_writes(buf_size / 2))
+    if (flush_buffered_writes_low())
       mysql_mutex_lock(&mutex);
   }
 
@@ -773,7 +824,6 @@ void buf_dblwr_t::add_to_batch(const IORequest &request, size_t size)
     element{request, size};
   active_slot->reserved= active_slot->first_free;
 
-  if (active_slot->first_free != buf_size ||
-      !flush_buffered_writes(buf_size / 2))
+  if (active_slot->first_free != buf_size || !flush_buffered_writes_low())
     mysql_mutex_unlock(&mutex);
 }
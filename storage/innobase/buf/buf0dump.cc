@@ -40,6 +40,9 @@ Created April 08, 2011 Vasil Dimov
 #include "ut0byte.h"
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
 
 #include "mysql/service_wsrep.h" /* wsrep_recovery */
 #include <my_service_manager.h>
@@ -47,6 +50,7 @@ Created April 08, 2011 Vasil Dimov
 static void buf_do_load_dump();
 
 enum status_severity {
+	STATUS_VERBOSE,
 	STATUS_INFO,
 	STATUS_ERR
 };
@@ -60,6 +64,14 @@ static volatile bool	buf_load_should_start;
 
 static bool	buf_load_abort_flag;
 
+/** Number of recency tiers of a buffer pool load. Each line of the dump
+file is "space,page_no", in the LRU order. buf_load() splits the lines
+into tiers by the line number. Tier 0 contains the most recently used
+pages, which will be loaded first. Within a tier, the pages are loaded in
+the order of page identifiers, so that adjacent pages can be read with a
+single request. */
+static constexpr uint32_t BUF_DUMP_TIERS = 16;
+
 /** Start the buffer pool dump/load task and instructs it to start a dump. */
 void buf_dump_start()
 {
@@ -102,6 +114,9 @@ buf_dump_status(
 		fmt, ap);
 
 	switch (severity) {
+	case STATUS_VERBOSE:
+		break;
+
 	case STATUS_INFO:
 		ib::info() << export_vars.innodb_buffer_pool_dump_status;
 		break;
@@ -141,6 +156,9 @@ buf_load_status(
 		fmt, ap);
 
 	switch (severity) {
+	case STATUS_VERBOSE:
+		break;
+
 	case STATUS_INFO:
 		ib::info() << export_vars.innodb_buffer_pool_load_status;
 		break;
@@ -350,6 +368,8 @@ buf_dump(
 	n_pages = j;
 
 	for (j = 0; j < n_pages && !SHOULD_QUIT(); j++) {
+		/* The file is in LRU order, and buf_load() derives
+		the recency tier from the line number. */
 		ret = fprintf(f, "%u,%u\n",
 			      dump[j].space(), dump[j].page_no());
 		if (ret < 0) {
@@ -415,6 +435,169 @@ buf_dump(
 	export_vars.innodb_buffer_pool_load_incomplete = 0;
 }
 
+/** Parse a line of the buffer pool dump file.
+@param f         dump file
+@param space_id  tablespace identifier
+@param page_no   page number
+@return number of parsed fields (2), or EOF at the end of file
+@retval 0 or 1 on parse error */
+static int buf_load_parse(FILE *f, uint32_t &space_id, uint32_t &page_no)
+{
+	char	line[64];
+
+	while (fgets(line, sizeof line, f)) {
+		int n = sscanf(line, "%u,%u", &space_id, &page_no);
+		/* Skip empty lines */
+		if (n != EOF) {
+			return n;
+		}
+	}
+
+	return EOF;
+}
+
+/** State of a buffer pool load that is shared by the load threads */
+struct buf_load_t
+{
+	/** pages to load, in the order of loading */
+	const page_id_t*	dump;
+	/** number of elements in dump[] */
+	ulint			n;
+	/** the next element of dump[] to process */
+	std::atomic<ulint>	next;
+	/** number of processed elements of dump[] */
+	std::atomic<ulint>	n_done;
+	/** number of pages whose read was initiated */
+	std::atomic<ulint>	n_read;
+	/** progress of the stage event of the main load thread */
+	PSI_stage_progress*	progress;
+
+	/** Number of elements that a thread processes at a time */
+	static constexpr ulint	CHUNK = 256;
+};
+
+/** Submit the reads for chunks of a buffer pool load until all
+have been processed or the load is aborted.
+@param load   buffer pool load
+@param main   whether this is the main load thread, which reports
+              the progress */
+static void buf_load_chunks(buf_load_t& load, bool main)
+{
+	const ulonglong	start = my_interval_timer();
+	ulonglong	last_status = start;
+	fil_space_t*	space = nullptr;
+
+	for (ulint first; (first = load.next.fetch_add(buf_load_t::CHUNK))
+		     < load.n; ) {
+		const ulint end = std::min(first + buf_load_t::CHUNK, load.n);
+
+		for (ulint i = first; i < end; ) {
+			if (SHUTTING_DOWN() || buf_load_abort_flag) {
+				goto func_exit;
+			}
+
+			/* Find a run of adjacent pages. */
+			const page_id_t	low = load.dump[i];
+			uint32_t	n = 1;
+
+			while (i + n < end
+			       && n < buf_pool_t::READ_AHEAD_PAGES
+			       && load.dump[i + n]
+			       == page_id_t(low.space(), low.page_no() + n)) {
+				n++;
+			}
+
+			i += n;
+
+			ut_d(const ulint n_done =)
+			load.n_done.fetch_add(n);
+#ifdef UNIV_DEBUG
+			if (n_done + n >= srv_buf_pool_load_pages_abort) {
+				buf_load_abort_flag = true;
+			}
+#endif
+
+			if (low.space() >= SRV_SPACE_ID_UPPER_BOUND) {
+				continue;
+			}
+
+			if (!space || space->id != low.space()) {
+				if (space) {
+					space->release();
+				}
+
+				space = fil_space_t::get(low.space());
+
+				if (!space) {
+					continue;
+				}
+			}
+
+			if (space->is_stopping()) {
+				space->release();
+				space = nullptr;
+				continue;
+			}
+
+			if (space->crypt_data
+			    && space->crypt_data->encryption
+			    != FIL_ENCRYPTION_OFF
+			    && space->crypt_data->type
+			    != CRYPT_SCHEME_UNENCRYPTED) {
+				continue;
+			}
+
+			const uint32_t	size = space->get_size();
+
+			if (low.page_no() >= size) {
+				continue;
+			}
+
+			/* Limit the number of pending reads, so that
+			the load will not starve other I/O. */
+			os_aio_wait_until_pending_reads_below(
+				srv_buf_pool_load_io_depth);
+
+			space->reacquire();
+			load.n_read += buf_read_pages_background(
+				space, low,
+				page_id_t(low.space(),
+					  std::min(low.page_no() + n, size)));
+		}
+
+		if (!main) {
+			continue;
+		}
+
+		const ulint	n_done = load.n_done;
+		mysql_stage_set_work_completed(load.progress, n_done);
+
+		const ulonglong	now = my_interval_timer();
+
+		if (now - last_status >= 1000000000ULL) {
+			last_status = now;
+			buf_load_status(
+				STATUS_VERBOSE,
+				"Loaded " ULINTPF "/" ULINTPF " pages, %.1f MB/s",
+				n_done, load.n,
+				double(load.n_read << srv_page_size_shift)
+				* 1000.0 / double(now - start));
+		}
+	}
+
+func_exit:
+	if (space) {
+		space->release();
+	}
+}
+
+/** Execute buf_load_chunks() in an additional thread.
+@param load   buffer pool load */
+static void buf_load_task(void* load)
+{
+	buf_load_chunks(*static_cast<buf_load_t*>(load), false);
+}
+
 /*****************************************************************//**
 Perform a buffer pool load from the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
@@ -434,7 +617,7 @@ buf_load()
 	ulint		i;
 	uint32_t	space_id;
 	uint32_t	page_no;
-	int		fscanf_ret;
+	int		parse_ret;
 
 	/* Ignore any leftovers from before */
 	buf_load_abort_flag = false;
@@ -457,13 +640,12 @@ buf_load()
 	This file is tiny (approx 500KB per 1GB buffer pool), reading it
 	two times is fine. */
 	dump_n = 0;
-	while (fscanf(f, "%u,%u", &space_id, &page_no) == 2
+	while ((parse_ret = buf_load_parse(f, space_id, page_no)) == 2
 	       && !SHUTTING_DOWN()) {
 		dump_n++;
 	}
 
-	if (!SHUTTING_DOWN() && !feof(f)) {
-		/* fscanf() returned != 2 */
+	if (!SHUTTING_DOWN() && (parse_ret != EOF || ferror(f))) {
 		const char*	what;
 		if (ferror(f)) {
 			what = "reading";
@@ -477,6 +659,9 @@ buf_load()
 		return;
 	}
 
+	/* The tiers are determined by the line number. */
+	const ulint	n_lines = dump_n;
+
 	/* If dump is larger than the buffer pool(s), then we ignore the
 	extra trailing. This could happen if a dump is made, then buffer
 	pool is shrunk and then load is attempted. */
@@ -510,11 +695,16 @@ buf_load()
 
 	export_vars.innodb_buffer_pool_load_incomplete = 1;
 
+	/* The start of each tier in dump[] */
+	ulint		tier_start[BUF_DUMP_TIERS + 1];
+	uint32_t	cur_tier = 0;
+	tier_start[0] = 0;
+
 	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
-		fscanf_ret = fscanf(f, "%u,%u", &space_id, &page_no);
+		parse_ret = buf_load_parse(f, space_id, page_no);
 
-		if (fscanf_ret != 2) {
-			if (feof(f)) {
+		if (parse_ret != 2) {
+			if (parse_ret == EOF) {
 				break;
 			}
 			/* else */
@@ -528,17 +718,10 @@ buf_load()
 			return;
 		}
 
-		if (space_id > ULINT32_MASK || page_no > ULINT32_MASK) {
-			ut_free(dump);
-			fclose(f);
-			buf_load_status(STATUS_ERR,
-					"Error parsing '%s': bogus"
-					" space,page %u,%u at line " ULINTPF
-					", unable to load buffer pool",
-					full_filename,
-					space_id, page_no,
-					i);
-			return;
+		const uint32_t	tier = uint32_t(i * BUF_DUMP_TIERS / n_lines);
+
+		while (cur_tier < tier) {
+			tier_start[++cur_tier] = i;
 		}
 
 		dump[i] = page_id_t(space_id, page_no);
@@ -549,6 +732,10 @@ buf_load()
 	we read it the first time. */
 	dump_n = i;
 
+	while (cur_tier < BUF_DUMP_TIERS) {
+		tier_start[++cur_tier] = dump_n;
+	}
+
 	fclose(f);
 
 	if (dump_n == 0) {
@@ -561,7 +748,10 @@ buf_load()
 	}
 
 	if (!SHUTTING_DOWN()) {
-		std::sort(dump, dump + dump_n);
+		for (uint32_t t = 0; t < BUF_DUMP_TIERS; t++) {
+			std::sort(dump + tier_start[t],
+				  dump + tier_start[t + 1]);
+		}
 		std::set<uint32_t> missing;
 		for (const page_id_t id : st_::span<const page_id_t>
 		       (dump, dump_n)) {
@@ -580,108 +770,58 @@ buf_load()
 		}
 	}
 
-	/* Avoid calling the expensive fil_space_t::get() for each
-	page within the same tablespace. dump[] is sorted by (space, page),
-	so all pages from a given tablespace are consecutive. */
-	uint32_t	cur_space_id = dump[0].space();
-	fil_space_t*	space = fil_space_t::get(cur_space_id);
-	ulint		zip_size = space ? space->zip_size() : 0;
-
 	PSI_stage_progress*	pfs_stage_progress __attribute__((unused))
 		= mysql_set_stage(srv_stage_buffer_pool_load.m_key);
 	mysql_stage_set_work_estimated(pfs_stage_progress, dump_n);
 	mysql_stage_set_work_completed(pfs_stage_progress, 0);
 
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
-
-		/* space_id for this iteration of the loop */
-		const uint32_t this_space_id = dump[i].space();
-
-		if (this_space_id >= SRV_SPACE_ID_UPPER_BOUND) {
-			continue;
-		}
-
-		if (this_space_id != cur_space_id) {
-			if (space) {
-				space->release();
-			}
-
-			cur_space_id = this_space_id;
-			space = fil_space_t::get(cur_space_id);
-
-			if (!space) {
-				continue;
-			}
+	buf_load_t	load{dump, dump_n, {0}, {0}, {0}, pfs_stage_progress};
+	const ulint	n_threads = std::min<ulint>(
+		srv_buf_pool_load_threads,
+		1 + (dump_n - 1) / buf_load_t::CHUNK);
+	std::vector<std::unique_ptr<tpool::waitable_task>> tasks;
 
-			zip_size = space->zip_size();
-		}
-
-		/* JAN: TODO: As we use background page read below,
-		if tablespace is encrypted we cant use it. */
-		if (!space || dump[i].page_no() >= space->get_size() ||
-		    (space->crypt_data &&
-		     space->crypt_data->encryption != FIL_ENCRYPTION_OFF &&
-		     space->crypt_data->type != CRYPT_SCHEME_UNENCRYPTED)) {
-			continue;
-		}
-
-		if (space->is_stopping()) {
-			space->release();
-			space = nullptr;
-			continue;
-		}
-
-		space->reacquire();
-		buf_read_page_background(space, dump[i], zip_size);
-
-		if (buf_load_abort_flag) {
-			if (space) {
-				space->release();
-			}
-			buf_load_abort_flag = false;
-			ut_free(dump);
-			buf_load_status(
-				STATUS_INFO,
-				"Buffer pool(s) load aborted on request");
-			/* Premature end, set estimated = completed = i and
-			end the current stage event. */
+	for (i = 1; i < n_threads; i++) {
+		tasks.emplace_back(new tpool::waitable_task(buf_load_task,
+							    &load));
+		srv_thread_pool->submit_task(tasks.back().get());
+	}
 
-			mysql_stage_set_work_estimated(pfs_stage_progress, i);
-			mysql_stage_set_work_completed(pfs_stage_progress, i);
+	buf_load_chunks(load, true);
 
-			mysql_end_stage();
-			return;
-		}
-
-#ifdef UNIV_DEBUG
-		if ((i+1) >= srv_buf_pool_load_pages_abort) {
-			buf_load_abort_flag = true;
-		}
-#endif
+	for (auto& task : tasks) {
+		task->wait();
 	}
 
-	if (space) {
-		space->release();
+	ut_free(dump);
+
+	if (buf_load_abort_flag) {
+		buf_load_abort_flag = false;
+		buf_load_status(
+			STATUS_INFO,
+			"Buffer pool(s) load aborted on request");
+		/* Premature end, set estimated = completed and
+		end the current stage event. */
+		const ulint n_done = load.n_done;
+		mysql_stage_set_work_estimated(pfs_stage_progress, n_done);
+		mysql_stage_set_work_completed(pfs_stage_progress, n_done);
+
+		mysql_end_stage();
+		return;
 	}
 
-	ut_free(dump);
+	const bool	complete = load.n_done == dump_n;
 
-	if (i == dump_n) {
+	if (complete) {
 		os_aio_wait_until_no_pending_reads(true);
 	}
 
 	ut_sprintf_timestamp(now);
 
-	if (i == dump_n) {
+	if (complete) {
 		buf_load_status(STATUS_INFO,
 			"Buffer pool(s) load completed at %s", now);
 		export_vars.innodb_buffer_pool_load_incomplete = 0;
-	} else if (!buf_load_abort_flag) {
-		buf_load_status(STATUS_INFO,
-			"Buffer pool(s) load aborted due to user instigated abort at %s",
-			now);
-		/* intentionally don't reset innodb_buffer_pool_load_incomplete
-                   as we don't want a shutdown to save the buffer pool */
 	} else {
 		buf_load_status(STATUS_INFO,
 			"Buffer pool(s) load aborted due to shutdown at %s",
@@ -42,6 +42,9 @@ Created 11/11/1995 Heikki Tuuri
 #include "fil0pagecompress.h"
 #include "lzo/lzo1x.h"
 #include "snappy-c.h"
+#include <condition_variable>
+#include <deque>
+#include <thread>
 
 /** Number of pages flushed via LRU. Protected by buf_pool.mutex.
 Also included in buf_pool.stat.n_pages_written. */
@@ -357,7 +360,7 @@ void buf_page_write_complete(const IORequest &request, bool error)
     const bool temp= bpage->oldest_modification() == 2;
     if (!temp && state < buf_page_t::WRITE_FIX_REINIT &&
         request.node->space->use_doublewrite())
-      buf_dblwr.write_completed();
+      buf_dblwr.write_completed(request);
     /* We must hold buf_pool.mutex while releasing the block, so that
     no other thread can access it before we have freed it. */
     mysql_mutex_lock(&buf_pool.mutex);
@@ -372,7 +375,7 @@ void buf_page_write_complete(const IORequest &request, bool error)
   {
     if (state < buf_page_t::WRITE_FIX_REINIT &&
         request.node->space->use_doublewrite())
-      buf_dblwr.write_completed();
+      buf_dblwr.write_completed(request);
     bpage->write_complete(false, error);
   }
 }
@@ -739,6 +742,243 @@ ATTRIBUTE_COLD void buf_pool_t::release_freed_page(buf_page_t *bpage) noexcept
   buf_LRU_free_page(bpage, true);
 }
 
+/** Prepare a write-fixed page for writing and submit the write.
+@param bpage  write-fixed page
+@param space  tablespace
+@param type   type of the write request
+@param s      state of the page before it was write-fixed */
+static void buf_flush_write(buf_page_t *bpage, fil_space_t *space,
+                            IORequest::Type type, uint32_t s)
+{
+  buf_block_t *block= reinterpret_cast<buf_block_t*>(bpage);
+  page_t *write_frame= bpage->zip.data;
+
+  size_t size;
+#if defined HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE || defined _WIN32
+  size_t orig_size;
+#endif
+  buf_tmp_buffer_t *slot= nullptr;
+
+  if (UNIV_UNLIKELY(!bpage->frame)) /* ROW_FORMAT=COMPRESSED */
+  {
+    ut_ad(!space->full_crc32());
+    ut_ad(!space->is_compressed()); /* not page_compressed */
+    size= bpage->zip_size();
+#if defined HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE || defined _WIN32
+    orig_size= size;
+#endif
+    buf_flush_update_zip_checksum(write_frame, size);
+    write_frame= buf_page_encrypt(space, bpage, write_frame, &slot, &size);
+    ut_ad(size == bpage->zip_size());
+  }
+  else
+  {
+    byte *page= bpage->frame;
+    size= block->physical_size();
+#if defined HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE || defined _WIN32
+    orig_size= size;
+#endif
+
+    if (space->full_crc32())
+    {
+      /* innodb_checksum_algorithm=full_crc32 is not implemented for
+      ROW_FORMAT=COMPRESSED pages. */
+      ut_ad(!write_frame);
+      page= buf_page_encrypt(space, bpage, page, &slot, &size);
+      buf_flush_init_for_writing(block, page, nullptr, true);
+    }
+    else
+    {
+      buf_flush_init_for_writing(block, page,
+                                 write_frame ? &bpage->zip : nullptr,
+                                 false);
+      page= buf_page_encrypt(space, bpage, write_frame ? write_frame : page,
+                             &slot, &size);
+    }
+
+#if defined HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE || defined _WIN32
+    if (size != orig_size)
+    {
+      switch (space->chain.start->punch_hole) {
+      case 1:
+        static_assert(IORequest::PUNCH_LRU - IORequest::PUNCH ==
+                      IORequest::WRITE_LRU - IORequest::WRITE_ASYNC, "");
+        type=
+          IORequest::Type(type + (IORequest::PUNCH - IORequest::WRITE_ASYNC));
+        break;
+      case 2:
+        size= orig_size;
+      }
+    }
+#endif
+    write_frame= page;
+  }
+
+  if ((s & buf_page_t::LRU_MASK) == buf_page_t::REINIT ||
+      !space->use_doublewrite())
+  {
+    if (UNIV_LIKELY(space->purpose == FIL_TYPE_TABLESPACE))
+    {
+      const lsn_t lsn=
+        mach_read_from_8(my_assume_aligned<8>(FIL_PAGE_LSN +
+                                              (write_frame ? write_frame
+                                               : bpage->frame)));
+      ut_ad(lsn >= bpage->oldest_modification());
+      log_write_up_to(lsn, true);
+    }
+    space->io(IORequest{type, bpage, slot}, bpage->physical_offset(), size,
+              write_frame, bpage);
+  }
+  else
+    buf_dblwr.add_to_batch(IORequest{bpage, slot, space->chain.start, type},
+                           size);
+}
+
+/** Threads that prepare and submit the writes of buf_pool.flush_list
+batches. Computing the checksums and encrypting or compressing pages
+can keep a single page cleaner thread busy. While a batch is active,
+buf_do_flush_list_batch() only picks the pages, and
+innodb_page_cleaner_threads workers run buf_flush_write(). */
+static struct buf_flush_workers_t
+{
+  /** maximum number of workers */
+  static constexpr ulint MAX= 8;
+  static_assert(MONITOR_FLUSH_WORKER_PAGES_7 - MONITOR_FLUSH_WORKER_PAGES_0 ==
+                MAX - 1, "consistency");
+
+private:
+  /** a write-fixed page */
+  struct request_t
+  {
+    buf_page_t *bpage;
+    fil_space_t *space;
+    uint32_t state;
+  };
+
+  /** worker thread */
+  struct worker_t
+  {
+    buf_flush_workers_t *workers;
+    ulint n;
+    tpool::waitable_task task{run, this};
+    /** Process requests until the batch is closed. */
+    static void run(void *arg)
+    {
+      const worker_t *w= static_cast<const worker_t*>(arg);
+      w->workers->run(w->n);
+    }
+  } workers[MAX];
+
+  /** number of workers of the current batch; 0 if none is active */
+  Atomic_relaxed<ulint> n_workers{0};
+  /** protects the fields below */
+  std::mutex mutex;
+  /** signalled on new requests and when the batch is closed */
+  std::condition_variable cond;
+  /** pending requests, in the order of submission */
+  std::deque<request_t> queue;
+  /** whether the current batch has been closed */
+  bool closed= false;
+  /** the thread that started the batch */
+  std::thread::id owner;
+
+  void run(ulint n)
+  {
+    ulint count= 0;
+    std::unique_lock<std::mutex> lk(mutex);
+    for (;;)
+    {
+      if (queue.empty())
+      {
+        if (closed)
+          break;
+        tpool::tpool_wait_begin();
+        cond.wait(lk);
+        tpool::tpool_wait_end();
+        continue;
+      }
+      const request_t r= queue.front();
+      queue.pop_front();
+      lk.unlock();
+      buf_flush_write(r.bpage, r.space, IORequest::WRITE_ASYNC, r.state);
+      count++;
+      lk.lock();
+    }
+    lk.unlock();
+    MONITOR_INC_VALUE(monitor_id_t(MONITOR_FLUSH_WORKER_PAGES_0 + n), count);
+  }
+
+public:
+  buf_flush_workers_t()
+  {
+    for (ulint i= 0; i < MAX; i++)
+      workers[i].workers= this, workers[i].n= i;
+  }
+
+  /** Start the workers of a flush_list batch, if configured. */
+  void start()
+  {
+    const ulint n= std::min<ulint>(srv_page_cleaner_threads, MAX);
+    if (n <= 1)
+      return;
+    ut_ad(!n_workers);
+    {
+      std::lock_guard<std::mutex> lk(mutex);
+      ut_ad(queue.empty());
+      closed= false;
+      owner= std::this_thread::get_id();
+    }
+    n_workers= n;
+    for (ulint i= 0; i < n; i++)
+      srv_thread_pool->submit_task(&workers[i].task);
+  }
+
+  /** Hand over a write-fixed page to the workers.
+  @param bpage  write-fixed page
+  @param space  tablespace
+  @param state  state of the page before it was write-fixed
+  @return whether the page was handed over */
+  bool add(buf_page_t *bpage, fil_space_t *space, uint32_t state)
+  {
+    /* Other threads than the one running the batch
+    (such as buf_flush_list_space()) write pages by themselves. */
+    if (!n_workers)
+      return false;
+    {
+      std::lock_guard<std::mutex> lk(mutex);
+      if (owner != std::this_thread::get_id())
+        return false;
+      queue.push_back({bpage, space, state});
+    }
+    cond.notify_one();
+    return true;
+  }
+
+  /** Wait for the workers to submit all the writes of a batch.
+  The caller must not hold buf_pool.mutex or buf_pool.flush_list_mutex. */
+  void finish()
+  {
+    mysql_mutex_assert_not_owner(&buf_pool.mutex);
+    mysql_mutex_assert_not_owner(&buf_pool.flush_list_mutex);
+    if (!n_workers)
+      return;
+    {
+      std::lock_guard<std::mutex> lk(mutex);
+      closed= true;
+    }
+    cond.notify_all();
+    for (ulint i= 0; i < n_workers; i++)
+      workers[i].task.wait();
+    n_workers= 0;
+    std::lock_guard<std::mutex> lk(mutex);
+    ut_ad(queue.empty());
+    owner= std::thread::id();
+  }
+
+  /** @return whether a batch is using the workers */
+  bool active() const { return n_workers != 0; }
+} buf_flush_workers;
+
 /** Write a flushable page to a file or free a freeable block.
 @param evict       whether to evict the page on write completion
 @param space       tablespace
@@ -803,87 +1043,10 @@ bool buf_page_t::flush(bool evict, fil_space_t *space)
                         evict ? "LRU" : "flush_list",
                         id().space(), id().page_no()));
 
-  buf_block_t *block= reinterpret_cast<buf_block_t*>(this);
-  page_t *write_frame= zip.data;
-
   space->reacquire();
-  size_t size;
-#if defined HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE || defined _WIN32
-  size_t orig_size;
-#endif
-  buf_tmp_buffer_t *slot= nullptr;
-
-  if (UNIV_UNLIKELY(!frame)) /* ROW_FORMAT=COMPRESSED */
-  {
-    ut_ad(!space->full_crc32());
-    ut_ad(!space->is_compressed()); /* not page_compressed */
-    size= zip_size();
-#if defined HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE || defined _WIN32
-    orig_size= size;
-#endif
-    buf_flush_update_zip_checksum(write_frame, size);
-    write_frame= buf_page_encrypt(space, this, write_frame, &slot, &size);
-    ut_ad(size == zip_size());
-  }
-  else
-  {
-    byte *page= frame;
-    size= block->physical_size();
-#if defined HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE || defined _WIN32
-    orig_size= size;
-#endif
-
-    if (space->full_crc32())
-    {
-      /* innodb_checksum_algorithm=full_crc32 is not implemented for
-      ROW_FORMAT=COMPRESSED pages. */
-      ut_ad(!write_frame);
-      page= buf_page_encrypt(space, this, page, &slot, &size);
-      buf_flush_init_for_writing(block, page, nullptr, true);
-    }
-    else
-    {
-      buf_flush_init_for_writing(block, page, write_frame ? &zip : nullptr,
-                                 false);
-      page= buf_page_encrypt(space, this, write_frame ? write_frame : page,
-                             &slot, &size);
-    }
-
-#if defined HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE || defined _WIN32
-    if (size != orig_size)
-    {
-      switch (space->chain.start->punch_hole) {
-      case 1:
-        static_assert(IORequest::PUNCH_LRU - IORequest::PUNCH ==
-                      IORequest::WRITE_LRU - IORequest::WRITE_ASYNC, "");
-        type=
-          IORequest::Type(type + (IORequest::PUNCH - IORequest::WRITE_ASYNC));
-        break;
-      case 2:
-        size= orig_size;
-      }
-    }
-#endif
-    write_frame= page;
-  }
 
-  if ((s & LRU_MASK) == REINIT || !space->use_doublewrite())
-  {
-    if (UNIV_LIKELY(space->purpose == FIL_TYPE_TABLESPACE))
-    {
-      const lsn_t lsn=
-        mach_read_from_8(my_assume_aligned<8>(FIL_PAGE_LSN +
-                                              (write_frame ? write_frame
-                                               : frame)));
-      ut_ad(lsn >= oldest_modification());
-      log_write_up_to(lsn, true);
-    }
-    space->io(IORequest{type, this, slot}, physical_offset(), size,
-              write_frame, this);
-  }
-  else
-    buf_dblwr.add_to_batch(IORequest{this, slot, space->chain.start, type},
-                           size);
+  if (evict || !buf_flush_workers.add(this, space, s))
+    buf_flush_write(this, space, type, s);
   return true;
 }
 
@@ -1413,6 +1576,8 @@ static ulint buf_do_flush_list_batch(ulint max_n, lsn_t lsn)
   static_assert(FIL_NULL > SRV_TMP_SPACE_ID, "consistency");
   static_assert(FIL_NULL > SRV_SPACE_ID_UPPER_BOUND, "consistency");
 
+  buf_flush_workers.start();
+
   /* Start from the end of the list looking for a suitable block to be
   flushed. */
   ulint len= UT_LIST_GET_LEN(buf_pool.flush_list);
@@ -1516,6 +1681,17 @@ static ulint buf_do_flush_list_batch(ulint max_n, lsn_t lsn)
   if (space)
     space->release();
 
+  if (buf_flush_workers.active())
+  {
+    /* The caller will invoke buf_dblwr.flush_buffered_writes(),
+    which must cover all the pages of this batch. */
+    mysql_mutex_unlock(&buf_pool.flush_list_mutex);
+    mysql_mutex_unlock(&buf_pool.mutex);
+    buf_flush_workers.finish();
+    mysql_mutex_lock(&buf_pool.mutex);
+    mysql_mutex_lock(&buf_pool.flush_list_mutex);
+  }
+
   if (scanned)
     MONITOR_INC_VALUE_CUMULATIVE(MONITOR_FLUSH_BATCH_SCANNED,
                                  MONITOR_FLUSH_BATCH_SCANNED_NUM_CALL,
@@ -1981,8 +2157,8 @@ log file. Use log_make_checkpoint() to flush also the pool.
 @retval false if a checkpoint write was already running */
 static bool log_checkpoint()
 {
-  if (recv_recovery_is_on())
-    recv_sys.apply(true);
+  if (recv_recovery_is_pending())
+    recv_sys.apply_all();
 
   fil_flush_file_spaces();
 
@@ -2042,8 +2218,8 @@ ATTRIBUTE_COLD void buf_flush_wait_flushed(lsn_t sync_lsn)
   ut_ad(sync_lsn < LSN_MAX);
   ut_ad(!srv_read_only_mode);
 
-  if (recv_recovery_is_on())
-    recv_sys.apply(true);
+  if (recv_recovery_is_pending())
+    recv_sys.apply_all();
 
   mysql_mutex_lock(&buf_pool.flush_list_mutex);
 
@@ -2101,8 +2277,8 @@ ATTRIBUTE_COLD void buf_flush_ahead(lsn_t lsn, bool furious)
 {
   ut_ad(!srv_read_only_mode);
 
-  if (recv_recovery_is_on())
-    recv_sys.apply(true);
+  if (recv_recovery_is_pending())
+    recv_sys.apply_all();
 
   DBUG_EXECUTE_IF("ib_log_checkpoint_avoid_hard", return;);
 
@@ -2149,7 +2325,7 @@ ATTRIBUTE_COLD static void buf_flush_sync_for_checkpoint(lsn_t lsn)
     lsn_t measure= buf_pool.get_oldest_modification(0);
     const lsn_t checkpoint_lsn= measure ? measure : newest_lsn;
 
-    if (!recv_recovery_is_on() &&
+    if (!recv_recovery_is_pending() &&
         checkpoint_lsn > log_sys.last_checkpoint_lsn + SIZE_OF_FILE_CHECKPOINT)
     {
       mysql_mutex_unlock(&buf_pool.flush_list_mutex);
@@ -2437,7 +2613,7 @@ static void buf_flush_page_cleaner()
         DBUG_EXECUTE_IF("ib_log_checkpoint_avoid", continue;);
         DBUG_EXECUTE_IF("ib_log_checkpoint_avoid_hard", continue;);
 
-        if (!recv_recovery_is_on() &&
+        if (!recv_recovery_is_pending() &&
             !srv_startup_is_before_trx_rollback_phase &&
             srv_operation <= SRV_OPERATION_EXPORT_RESTORED)
           log_checkpoint();
@@ -2679,12 +2855,8 @@ void buf_flush_sync_batch(lsn_t lsn)
 NOTE: The calling thread is not allowed to hold any buffer page latches! */
 void buf_flush_sync()
 {
-  if (recv_recovery_is_on())
-  {
-    mysql_mutex_lock(&recv_sys.mutex);
-    recv_sys.apply(true);
-    mysql_mutex_unlock(&recv_sys.mutex);
-  }
+  if (recv_recovery_is_pending())
+    recv_sys.apply_all();
 
   thd_wait_begin(nullptr, THD_WAIT_DISKIO);
   tpool::tpool_wait_begin();
@@ -2740,7 +2912,7 @@ static void buf_flush_validate_low()
 		ut_ad(om == 1 || om > 2);
 
 		bpage = UT_LIST_GET_NEXT(list, bpage);
-		ut_ad(om == 1 || !bpage || recv_recovery_is_on()
+		ut_ad(om == 1 || !bpage || recv_recovery_is_pending()
 		      || om >= bpage->oldest_modification());
 	}
 }
@@ -0,0 +1,312 @@
+/*****************************************************************************
+
+Copyright (c) 2026, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file buf/buf0l2.cc
+Second-level page cache on a local file
+*******************************************************/
+
+#include "buf0l2.h"
+#include "buf0buf.h"
+#include "fil0fil.h"
+#include "fil0crypt.h"
+#include "srv0srv.h"
+#include "log.h"
+
+/** The second-level page cache */
+buf_l2_t buf_l2;
+
+/** Execute the writes with max. concurrency 1 */
+static tpool::task_group buf_l2_write_group(1);
+static tpool::waitable_task buf_l2_write_task(buf_l2_t::write_task, nullptr,
+                                              &buf_l2_write_group);
+
+bool buf_l2_t::eligible(const fil_space_t &space)
+{
+  return space.purpose == FIL_TYPE_TABLESPACE && !space.crypt_data &&
+    !space.is_compressed() && !space.zip_size() &&
+    !srv_is_undo_tablespace(space.id);
+}
+
+void buf_l2_t::create()
+{
+  ut_ad(!enabled());
+  memset(&stat, 0, sizeof stat);
+
+  if (!srv_buf_l2_file || !*srv_buf_l2_file)
+    return;
+
+  const size_t n_slots= size_t(srv_buf_l2_size >> srv_page_size_shift);
+  if (n_slots < N_WRITE_BUFS)
+  {
+    sql_print_warning("InnoDB: innodb_buffer_pool_l2_size is too small;"
+                      " the second-level page cache is disabled");
+    return;
+  }
+
+  bool success;
+  file= os_file_create_simple_no_error_handling(innodb_data_file_key,
+                                                srv_buf_l2_file,
+                                                OS_FILE_CREATE,
+                                                OS_FILE_READ_WRITE, false,
+                                                &success);
+  if (!success)
+    file= os_file_create_simple_no_error_handling(innodb_data_file_key,
+                                                  srv_buf_l2_file,
+                                                  OS_FILE_OPEN,
+                                                  OS_FILE_READ_WRITE, false,
+                                                  &success);
+  if (!success ||
+      !os_file_set_size(srv_buf_l2_file, file,
+                        os_offset_t{n_slots} << srv_page_size_shift))
+  {
+    sql_print_warning("InnoDB: Cannot create %s;"
+                      " the second-level page cache is disabled",
+                      srv_buf_l2_file);
+    if (success)
+      os_file_close(file);
+    file= OS_FILE_CLOSED;
+    return;
+  }
+
+  write_buf_mem= static_cast<byte*>
+    (aligned_malloc(N_WRITE_BUFS << srv_page_size_shift, srv_page_size));
+  for (size_t i= 0; i < N_WRITE_BUFS; i++)
+    free_bufs.push_back(write_buf_mem + (i << srv_page_size_shift));
+
+  mysql_mutex_init(buf_l2_mutex_key, &mutex, nullptr);
+  map.reserve(n_slots);
+  slots.assign(n_slots, slot_t{EMPTY, nullptr, false});
+
+  sql_print_information("InnoDB: Using %s as a second-level page cache"
+                        " of %zu pages", srv_buf_l2_file, n_slots);
+}
+
+void buf_l2_t::close()
+{
+  if (!enabled())
+    return;
+
+  buf_l2_write_task.wait();
+  mysql_mutex_lock(&mutex);
+  ut_ad(write_queue.empty());
+  slots.clear();
+  map.clear();
+  free_bufs.clear();
+  mysql_mutex_unlock(&mutex);
+  mysql_mutex_destroy(&mutex);
+  aligned_free(write_buf_mem);
+  write_buf_mem= nullptr;
+  os_file_close(file);
+  file= OS_FILE_CLOSED;
+}
+
+void buf_l2_t::write_task(void *)
+{
+  buf_l2.write_pending();
+}
+
+void buf_l2_t::write_pending()
+{
+  std::vector<size_t> batch;
+
+  mysql_mutex_lock(&mutex);
+  while (!write_queue.empty())
+  {
+    batch.swap(write_queue);
+
+    for (size_t i : batch)
+    {
+      slot_t &s= slots[i];
+      const uint64_t id= s.id;
+      byte *buf= s.pending;
+      ut_ad(buf);
+      bool ok= false;
+
+      if (id != EMPTY)
+      {
+        /* The slot is busy and cannot be reused until we reset
+        s.pending. Concurrent read() may copy the page from buf. */
+        mysql_mutex_unlock(&mutex);
+        if (fil_space_t *space= fil_space_t::get(page_id_t{id}.space()))
+        {
+          ok= eligible(*space) &&
+            os_file_write(IORequestWrite, srv_buf_l2_file, file, buf,
+                          os_offset_t{i} << srv_page_size_shift,
+                          srv_page_size) == DB_SUCCESS;
+          space->release();
+        }
+        mysql_mutex_lock(&mutex);
+      }
+
+      s.pending= nullptr;
+      free_bufs.push_back(buf);
+
+      if (ok)
+        stat.n_writes++;
+      else if (s.id != EMPTY)
+      {
+        ut_ad(s.id == id);
+        remove(s);
+        stat.n_dropped++;
+      }
+    }
+
+    batch.clear();
+  }
+
+  writing= false;
+  mysql_mutex_unlock(&mutex);
+}
+
+void buf_l2_t::evict(const buf_page_t &bpage)
+{
+  const page_id_t id{bpage.id()};
+  ut_ad(enabled());
+
+  mysql_mutex_lock(&mutex);
+  {
+    auto it= map.find(id.raw());
+    if (it != map.end())
+      remove(slots[it->second]);
+  }
+
+  if (bpage.oldest_modification() || !bpage.frame || bpage.zip.data ||
+      bpage.is_freed() || id.space() == SRV_TMP_SPACE_ID)
+    goto func_exit;
+
+  if (!free_bufs.empty())
+  {
+    for (size_t n= slots.size(); n--; )
+    {
+      const size_t i= hand;
+      slot_t &s= slots[i];
+      if (++hand == slots.size())
+        hand= 0;
+      if (s.busy())
+        continue;
+      if (s.id != EMPTY)
+        remove(s);
+
+      s.id= id.raw();
+      s.pending= free_bufs.back();
+      free_bufs.pop_back();
+      memcpy_aligned<UNIV_PAGE_SIZE_MIN>(s.pending, bpage.frame,
+                                         srv_page_size);
+      map.emplace(s.id, i);
+      write_queue.push_back(i);
+
+      if (!writing)
+      {
+        writing= true;
+        srv_thread_pool->submit_task(&buf_l2_write_task);
+      }
+      goto func_exit;
+    }
+  }
+
+  stat.n_dropped++;
+func_exit:
+  mysql_mutex_unlock(&mutex);
+}
+
+bool buf_l2_t::read(const page_id_t id, const fil_space_t &space, byte *frame)
+{
+  ut_ad(enabled());
+  ut_ad(eligible(space));
+  bool ok;
+
+  mysql_mutex_lock(&mutex);
+  auto it= map.find(id.raw());
+  if (it == map.end())
+  {
+    mysql_mutex_unlock(&mutex);
+    return false;
+  }
+
+  const size_t i= it->second;
+  slot_t &s= slots[i];
+
+  if (s.pending)
+  {
+    /* The page has not been written to the file yet. */
+    memcpy_aligned<UNIV_PAGE_SIZE_MIN>(frame, s.pending, srv_page_size);
+    remove(s);
+    mysql_mutex_unlock(&mutex);
+    ok= true;
+  }
+  else
+  {
+    ut_ad(!s.reading);
+    s.reading= true;
+    mysql_mutex_unlock(&mutex);
+    ok= os_file_read(IORequestRead, file, frame,
+                     os_offset_t{i} << srv_page_size_shift, srv_page_size,
+                     nullptr) == DB_SUCCESS;
+    mysql_mutex_lock(&mutex);
+    s.reading= false;
+    /* The tablespace may have been dropped meanwhile. */
+    if (s.id == id.raw())
+      remove(s);
+    else
+      ok= false;
+    mysql_mutex_unlock(&mutex);
+  }
+
+  ok= ok && page_id_t(mach_read_from_4(frame + FIL_PAGE_SPACE_ID),
+                      mach_read_from_4(frame + FIL_PAGE_OFFSET)) == id &&
+    !buf_page_is_corrupted(false, frame, space.flags);
+
+  if (ok)
+  {
+    mysql_mutex_lock(&mutex);
+    stat.n_hits++;
+    mysql_mutex_unlock(&mutex);
+  }
+
+  return ok;
+}
+
+void buf_l2_t::invalidate(const page_id_t id)
+{
+  if (!enabled())
+    return;
+  mysql_mutex_lock(&mutex);
+  auto it= map.find(id.raw());
+  if (it != map.end())
+    remove(slots[it->second]);
+  mysql_mutex_unlock(&mutex);
+}
+
+void buf_l2_t::invalidate(uint32_t space_id)
+{
+  if (!enabled())
+    return;
+  mysql_mutex_lock(&mutex);
+  for (auto it= map.begin(); it != map.end(); )
+  {
+    if (page_id_t{it->first}.space() != space_id)
+      ++it;
+    else
+    {
+      slots[it->second].id= EMPTY;
+      it= map.erase(it);
+    }
+  }
+  mysql_mutex_unlock(&mutex);
+}
@@ -30,6 +30,7 @@ Created 11/5/1995 Heikki Tuuri
 #include "buf0buddy.h"
 #include "buf0buf.h"
 #include "buf0flu.h"
+#include "buf0l2.h"
 #include "buf0rea.h"
 #include "btr0sea.h"
 #include "os0file.h"
@@ -318,7 +319,8 @@ static void buf_LRU_check_size_of_non_data_objects()
 {
   mysql_mutex_assert_owner(&buf_pool.mutex);
 
-  if (recv_recovery_is_on() || buf_pool.n_chunks_new != buf_pool.n_chunks)
+  if (recv_recovery_is_pending() ||
+      buf_pool.n_chunks_new != buf_pool.n_chunks)
     return;
 
   const auto s= UT_LIST_GET_LEN(buf_pool.free) + UT_LIST_GET_LEN(buf_pool.LRU);
@@ -802,6 +804,40 @@ bool buf_page_make_young_if_needed(buf_page_t *bpage)
   return not_first;
 }
 
+void buf_LRU_make_last(const page_id_t id)
+{
+  buf_pool_t::hash_chain &chain= buf_pool.page_hash.cell_get(id.fold());
+
+  mysql_mutex_lock(&buf_pool.mutex);
+  buf_page_t *bpage= buf_pool.page_hash.get(id, chain);
+
+  /* Pages in the young part of the LRU list belong to the working set. */
+  if (bpage && bpage->old && !bpage->is_read_fixed() &&
+      bpage != UT_LIST_GET_LAST(buf_pool.LRU))
+  {
+    buf_LRU_remove_block(bpage);
+
+    if (!buf_pool.LRU_old)
+      buf_LRU_add_block(bpage, true);
+    else
+    {
+      UT_LIST_ADD_LAST(buf_pool.LRU, bpage);
+      ut_d(bpage->in_LRU_list= true);
+      incr_LRU_size_in_bytes(bpage);
+      buf_pool.LRU_old_len++;
+      bpage->set_old(true);
+      buf_LRU_old_adjust_len();
+
+      if (bpage->belongs_to_unzip_LRU())
+        buf_unzip_LRU_add_block(reinterpret_cast<buf_block_t*>(bpage), true);
+    }
+
+    buf_pool.stat.n_pages_made_last++;
+  }
+
+  mysql_mutex_unlock(&buf_pool.mutex);
+}
+
 /** Try to free a block. If bpage is a descriptor of a compressed-only
 ROW_FORMAT=COMPRESSED page, the buf_page_t object will be freed as well.
 The caller must hold buf_pool.mutex.
@@ -888,6 +924,10 @@ bool buf_LRU_free_page(buf_page_t *bpage, bool zip)
 
 	ut_ad(bpage->can_relocate());
 
+	if (buf_l2.enabled()) {
+		buf_l2.evict(*bpage);
+	}
+
 	if (!buf_LRU_block_remove_hashed(bpage, id, chain, zip)) {
 		ut_ad(!b);
 		mysql_mutex_assert_not_owner(&buf_pool.flush_list_mutex);
@@ -35,6 +35,7 @@ Created 11/5/1995 Heikki Tuuri
 #include "buf0lru.h"
 #include "buf0buddy.h"
 #include "buf0dblwr.h"
+#include "buf0l2.h"
 #include "page0zip.h"
 #include "log0recv.h"
 #include "trx0sys.h"
@@ -235,6 +236,40 @@ buf_read_page_low(
 	}
 
 	ut_ad(bpage->in_file());
+
+	if (UNIV_UNLIKELY(recv_sys.online)) {
+		page_recv_t* recs;
+		if (lsn_t init_lsn = recv_sys.claim_init(page_id, recs)) {
+			/* The page will be initialized by the log, like in
+			buf_read_recover(). The file may contain garbage. */
+			const IORequest request{
+				bpage, (buf_tmp_buffer_t*) recs,
+				UT_LIST_GET_FIRST(space->chain),
+				IORequest::READ_ASYNC};
+			if (sync) {
+				request.fake_read_complete(init_lsn);
+			} else {
+				os_fake_read(request, init_lsn);
+			}
+			return DB_SUCCESS;
+		}
+	}
+
+	if (!zip_size && buf_l2.enabled() && buf_l2_t::eligible(*space)) {
+		/* buf_l2.read() is synchronous. An asynchronous read
+		(such as btr_cur_prefetch_siblings() while holding index
+		latches) must not wait for it; the page in the data file
+		is identical, so just discard the cached copy. */
+		if (!sync) {
+			buf_l2.invalidate(page_id);
+		} else if (buf_l2.read(page_id, *space, bpage->frame)) {
+			dberr_t err = bpage->read_complete(
+				*UT_LIST_GET_FIRST(space->chain));
+			space->release();
+			return err == DB_FAIL ? DB_PAGE_CORRUPTED : err;
+		}
+	}
+
 	ulonglong mariadb_timer= 0;
 
 	if (sync) {
@@ -290,6 +325,152 @@ static void buf_read_release(buf_block_t *block)
   }
 }
 
+/** Submit an asynchronous read of adjacent pages.
+@param space  tablespace
+@param batch  read-fixed pages that were initialized for read
+@param n      number of pages in batch
+@return error code */
+static dberr_t buf_read_submit(fil_space_t *space, buf_page_t **batch,
+                               uint32_t n)
+{
+  ut_ad(n);
+  ut_ad(n <= buf_pool_t::READ_AHEAD_PAGES);
+  const os_offset_t offset=
+    os_offset_t{batch[0]->id().page_no()} << srv_page_size_shift;
+  space->reacquire();
+
+  if (n == 1)
+  {
+    dberr_t err= space->io(IORequest(IORequest::READ_ASYNC), offset,
+                           srv_page_size, batch[0]->frame, batch[0]).err;
+    if (err != DB_SUCCESS)
+      buf_pool.corrupted_evict(batch[0], buf_page_t::READ_FIX);
+    return err;
+  }
+
+  /* The frames of the blocks are not contiguous in memory. Read all
+  pages with a single request into a bounce buffer, from which
+  IORequest::read_complete() will copy the pages. */
+  buf_read_batch_t *b= new buf_read_batch_t;
+  b->buf= static_cast<byte*>(aligned_malloc(size_t{n} << srv_page_size_shift,
+                                            srv_page_size));
+  b->n= n;
+  memcpy(b->bpage, batch, n * sizeof *batch);
+
+  dberr_t err= space->io(IORequest{batch[0], b},
+                         offset, size_t{n} << srv_page_size_shift,
+                         b->buf, batch[0]).err;
+  if (err != DB_SUCCESS)
+  {
+    for (uint32_t i= 0; i < n; i++)
+      buf_pool.corrupted_evict(batch[i], buf_page_t::READ_FIX);
+    aligned_free(b->buf);
+    delete b;
+  }
+  return err;
+}
+
+/** Initiate read-ahead of the pages in a range that are not
+in the buffer pool. Runs of adjacent pages are read with a single
+request.
+@param space     tablespace
+@param low       first page to read
+@param high      end of the range (excluded)
+@param zip_size  ROW_FORMAT=COMPRESSED page size, or 0
+@param n_reads   number of submitted read requests
+@return number of pages whose read was initiated */
+static ulint buf_read_ahead_pages(fil_space_t *space, page_id_t low,
+                                  const page_id_t high, ulint zip_size,
+                                  ulint &n_reads)
+{
+  ut_ad(high.page_no() - low.page_no() <= buf_pool_t::READ_AHEAD_PAGES);
+  buf_block_t *block= nullptr;
+  ulint count= 0;
+  n_reads= 0;
+
+  if (UNIV_UNLIKELY(recv_sys.online))
+    /* Pages that will be initialized by the log must not be read;
+    see buf_read_page_low(). */
+    return 0;
+
+  if (UNIV_LIKELY(!zip_size))
+  {
+  allocate_block:
+    if (UNIV_UNLIKELY(!(block= buf_read_acquire())))
+      return 0;
+  }
+  else if (recv_recovery_is_pending())
+  {
+    zip_size|= 1;
+    goto allocate_block;
+  }
+
+  if (zip_size || UT_LIST_GET_LEN(space->chain) > 1)
+  {
+    /* ROW_FORMAT=COMPRESSED pages are not read into block->frame, and
+    a multi-file system tablespace may have a file boundary within
+    the range. Submit each page separately. */
+    for (; low < high; ++low)
+    {
+      if (space->is_stopping())
+        break;
+      buf_pool_t::hash_chain &chain= buf_pool.page_hash.cell_get(low.fold());
+      space->reacquire();
+      if (buf_read_page_low(low, zip_size, chain, space, block) == DB_SUCCESS)
+      {
+        count++;
+        n_reads++;
+        ut_ad(!block);
+        if ((UNIV_LIKELY(!zip_size) || (zip_size & 1)) &&
+            UNIV_UNLIKELY(!(block= buf_read_acquire())))
+          break;
+      }
+    }
+  }
+  else
+  {
+    buf_page_t *batch[buf_pool_t::READ_AHEAD_PAGES];
+    uint32_t n= 0;
+
+    for (; low < high; ++low)
+    {
+      if (space->is_stopping())
+        break;
+      buf_page_t *bpage= nullptr;
+      if (!buf_dblwr.is_inside(low))
+      {
+        buf_pool_t::hash_chain &chain=
+          buf_pool.page_hash.cell_get(low.fold());
+        bpage= buf_page_init_for_read(low, 0, chain, block);
+      }
+      if (bpage)
+      {
+        ut_ad(!block);
+        batch[n++]= bpage;
+        if (UNIV_UNLIKELY(!(block= buf_read_acquire())))
+          break;
+      }
+      else if (n)
+      {
+        buf_read_submit(space, batch, n);
+        count+= n;
+        n_reads++;
+        n= 0;
+      }
+    }
+
+    if (n)
+    {
+      buf_read_submit(space, batch, n);
+      count+= n;
+      n_reads++;
+    }
+  }
+
+  buf_read_release(block);
+  return count;
+}
+
 /** Applies a random read-ahead in buf_pool if there are at least a threshold
 value of accessed pages from the random read-ahead area. Does not read any
 page, not even the one at the position (space, offset), if the read-ahead
@@ -347,34 +528,8 @@ ulint buf_read_ahead_random(const page_id_t page_id, ulint zip_size)
     goto no_read_ahead;
 
   /* Read all the suitable blocks within the area */
-  buf_block_t *block= nullptr;
-  if (UNIV_LIKELY(!zip_size))
-  {
-  allocate_block:
-    if (UNIV_UNLIKELY(!(block= buf_read_acquire())))
-      goto no_read_ahead;
-  }
-  else if (recv_recovery_is_on())
-  {
-    zip_size|= 1;
-    goto allocate_block;
-  }
-
-  for (page_id_t i= low; i < high; ++i)
-  {
-    if (space->is_stopping())
-      break;
-    buf_pool_t::hash_chain &chain= buf_pool.page_hash.cell_get(i.fold());
-    space->reacquire();
-    if (buf_read_page_low(i, zip_size, chain, space, block) == DB_SUCCESS)
-    {
-      count++;
-      ut_ad(!block);
-      if ((UNIV_LIKELY(!zip_size) || (zip_size & 1)) &&
-          UNIV_UNLIKELY(!(block= buf_read_acquire())))
-        break;
-    }
-  }
+  ulint n_reads;
+  count= buf_read_ahead_pages(space, low, high, zip_size, n_reads);
 
   if (count)
   {
@@ -386,11 +541,11 @@ ulint buf_read_ahead_random(const page_id_t page_id, ulint zip_size)
     LRU policy decision. */
     buf_LRU_stat_inc_io();
     buf_pool.stat.n_ra_pages_read_rnd+= count;
+    buf_pool.stat.n_ra_reads+= n_reads;
     mysql_mutex_unlock(&buf_pool.mutex);
   }
 
   space->release();
-  buf_read_release(block);
   return count;
 }
 
@@ -429,7 +584,7 @@ dberr_t buf_read_page(const page_id_t page_id, ulint zip_size,
     block= buf_LRU_get_free_block(have_mutex);
     mysql_mutex_unlock(&buf_pool.mutex);
   }
-  else if (recv_recovery_is_on())
+  else if (recv_recovery_is_pending())
   {
     zip_size|= 1;
     goto allocate_block;
@@ -465,7 +620,7 @@ void buf_read_page_background(fil_space_t *space, const page_id_t page_id,
     if (UNIV_UNLIKELY(!(block= buf_read_acquire())))
       goto skip;
   }
-  else if (recv_recovery_is_on())
+  else if (recv_recovery_is_pending())
   {
     zip_size|= 1;
     goto allocate_block;
@@ -485,6 +640,18 @@ void buf_read_page_background(fil_space_t *space, const page_id_t page_id,
   can ignore these in our heuristics. */
 }
 
+ulint buf_read_pages_background(fil_space_t *space, const page_id_t low,
+                                const page_id_t high)
+{
+  ut_ad(low.space() == space->id);
+  ut_ad(high.page_no() - low.page_no() <= buf_pool_t::READ_AHEAD_PAGES);
+  ulint n_reads;
+  const ulint count= buf_read_ahead_pages(space, low, high, space->zip_size(),
+                                          n_reads);
+  space->release();
+  return count;
+}
+
 /** Applies linear read-ahead if in the buf_pool the page is a border page of
 a linear read-ahead area and all the pages in the area have been accessed.
 Does not read any page if the read-ahead mechanism is not activated. Note
@@ -640,40 +807,13 @@ ulint buf_read_ahead_linear(const page_id_t page_id, ulint zip_size)
   }
 
   /* If we got this far, read-ahead can be sensible: do it */
-  buf_block_t *block= nullptr;
-  if (UNIV_LIKELY(!zip_size))
-  {
-  allocate_block:
-    if (UNIV_UNLIKELY(!(block= buf_read_acquire())))
-      goto fail;
-  }
-  else if (recv_recovery_is_on())
-  {
-    zip_size|= 1;
-    goto allocate_block;
-  }
-
-  count= 0;
-  for (; new_low <= new_high_1; ++new_low)
-  {
-    if (space->is_stopping())
-      break;
-    buf_pool_t::hash_chain &chain= buf_pool.page_hash.cell_get(new_low.fold());
-    space->reacquire();
-    if (buf_read_page_low(new_low, zip_size, chain, space, block) ==
-        DB_SUCCESS)
-    {
-      count++;
-      ut_ad(!block);
-      if ((UNIV_LIKELY(!zip_size) || (zip_size & 1)) &&
-          UNIV_UNLIKELY(!(block= buf_read_acquire())))
-        break;
-    }
-  }
+  ulint n_reads;
+  count= buf_read_ahead_pages(space, new_low, new_high_1 + 1, zip_size,
+                              n_reads);
 
   if (count)
   {
-    DBUG_PRINT("ib_buf", ("random read-ahead %zu pages from %s: %u",
+    DBUG_PRINT("ib_buf", ("linear read-ahead %zu pages from %s: %u",
                           count, space->chain.start->name,
                           new_low.page_no()));
     mysql_mutex_lock(&buf_pool.mutex);
@@ -681,11 +821,11 @@ ulint buf_read_ahead_linear(const page_id_t page_id, ulint zip_size)
     LRU policy decision. */
     buf_LRU_stat_inc_io();
     buf_pool.stat.n_ra_pages_read+= count;
+    buf_pool.stat.n_ra_reads+= n_reads;
     mysql_mutex_unlock(&buf_pool.mutex);
   }
 
   space->release();
-  buf_read_release(block);
   return count;
 }
 
@@ -731,3 +871,78 @@ void buf_read_recover(fil_space_t *space, const page_id_t page_id,
 
   buf_LRU_block_free_non_file_page(block);
 }
+
+/** Read pages for recovery. The log records will be applied to the pages
+in buf_page_t::read_complete().
+@param space    tablespace
+@param page_id  first page to read
+@param n        number of adjacent pages to read
+@return number of submitted read requests */
+size_t buf_read_recover_pages(fil_space_t *space, page_id_t page_id,
+                              uint32_t n)
+{
+  ut_ad(space->id == page_id.space());
+  ut_ad(n);
+  ut_ad(n <= buf_pool_t::READ_AHEAD_PAGES);
+  const ulint zip_size= space->zip_size();
+  /* See buf_read_ahead_pages() */
+  const bool single= zip_size || UT_LIST_GET_LEN(space->chain) > 1;
+  buf_page_t *batch[buf_pool_t::READ_AHEAD_PAGES];
+  uint32_t b= 0;
+  size_t n_reads= 0;
+
+  for (const page_id_t end{page_id + n};; ++page_id)
+  {
+    if (page_id < end)
+    {
+      buf_pool_t::hash_chain &chain=
+        buf_pool.page_hash.cell_get(page_id.fold());
+      buf_block_t *block= buf_LRU_get_free_block(have_no_mutex);
+
+      if (single)
+      {
+        space->reacquire();
+        dberr_t err=
+          buf_read_page_low(page_id, zip_size | 1, chain, space, block);
+        if (err == DB_SUCCESS)
+        {
+          ut_ad(!block);
+          n_reads++;
+          continue;
+        }
+        if (err != DB_SUCCESS_LOCKED_REC)
+          sql_print_error("InnoDB: Recovery failed to read page "
+                          UINT32PF " from %s",
+                          page_id.page_no(), space->chain.start->name);
+        buf_pool.free_block(block);
+        continue;
+      }
+
+      if (buf_page_t *bpage= buf_page_init_for_read(page_id, 1, chain, block))
+      {
+        ut_ad(!block);
+        batch[b++]= bpage;
+        continue;
+      }
+
+      buf_pool.free_block(block);
+    }
+
+    if (b)
+    {
+      /* On failure, buf_read_submit() will have freed the blocks */
+      const uint32_t first= batch[0]->id().page_no();
+      const uint32_t last= batch[b - 1]->id().page_no();
+      if (buf_read_submit(space, batch, b) != DB_SUCCESS)
+        sql_print_error("InnoDB: Recovery failed to read pages "
+                        UINT32PF "-" UINT32PF " from %s",
+                        first, last, space->chain.start->name);
+      else
+        n_reads++;
+      b= 0;
+    }
+
+    if (!(page_id < end))
+      return n_reads;
+  }
+}
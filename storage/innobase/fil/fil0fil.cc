@@ -29,6 +29,7 @@ Created 10/25/1995 Heikki Tuuri
 
 #include "btr0btr.h"
 #include "buf0buf.h"
+#include "buf0l2.h"
 #include "dict0boot.h"
 #include "dict0dict.h"
 #include "dict0load.h"
@@ -46,6 +47,7 @@ Created 10/25/1995 Heikki Tuuri
 #include "trx0purge.h"
 #include "buf0lru.h"
 #include "buf0flu.h"
+#include "buf0rea.h"
 #include "log.h"
 #ifdef __linux__
 # include <sys/types.h>
@@ -893,6 +895,9 @@ fil_space_free_low(
 		std::this_thread::sleep_for(std::chrono::microseconds(100));
 	}
 
+	/* The tablespace identifier may be reused. */
+	buf_l2.invalidate(space->id);
+
 	for (fil_node_t* node = UT_LIST_GET_FIRST(space->chain);
 	     node != NULL; ) {
 		ut_d(space->size -= node->size);
@@ -2868,7 +2873,8 @@ fil_io_t fil_space_t::io(const IORequest &type, os_offset_t offset, size_t len,
 	ulint p = static_cast<ulint>(offset >> srv_page_size_shift);
 	dberr_t err;
 
-	if (type.type == IORequest::READ_ASYNC && is_stopping()) {
+	if ((type.type == IORequest::READ_ASYNC
+	     || type.type == IORequest::READ_BATCH) && is_stopping()) {
 		err = DB_TABLESPACE_DELETED;
 		node = nullptr;
 		goto release;
@@ -2892,7 +2898,8 @@ fil_io_t fil_space_t::io(const IORequest &type, os_offset_t offset, size_t len,
 			node = UT_LIST_GET_NEXT(chain, node);
 			if (!node) {
 fail:
-				if (type.type != IORequest::READ_ASYNC) {
+				if (type.type != IORequest::READ_ASYNC
+				    && type.type != IORequest::READ_BATCH) {
 					fil_invalid_page_access_msg(
 						node->name,
 						offset, len,
@@ -2926,7 +2933,10 @@ fil_io_t fil_space_t::io(const IORequest &type, os_offset_t offset, size_t len,
 		goto release_sync_write;
 	} else {
 		/* Queue the aio request */
-		err = os_aio(IORequest{bpage, type.slot, node, type.type},
+		err = os_aio(type.type == IORequest::READ_BATCH
+			     ? IORequest{bpage, type.read_batch, node}
+			     : IORequest{bpage, type.slot, node, type.type,
+					 type.dblwr_batch},
 			     buf, offset, len);
 	}
 
@@ -2970,35 +2980,60 @@ void IORequest::write_complete(int io_error) const
   node->space->release();
 }
 
-void IORequest::read_complete(int io_error) const
+/** Complete a read of a page.
+@param bpage     the page that was read
+@param node      data file
+@param io_error  error that was reported for the read, or 0 */
+static void fil_read_complete(buf_page_t *bpage, const fil_node_t &node,
+                              int io_error)
 {
-  ut_ad(fil_validate_skip());
-  ut_ad(node);
-  ut_ad(is_read());
-  ut_ad(bpage);
-
   const page_id_t id(bpage->id());
 
   if (UNIV_UNLIKELY(io_error != 0))
   {
     sql_print_error("InnoDB: Read error %d of page " UINT32PF " in file %s",
-                    io_error, id.page_no(), node->name);
+                    io_error, id.page_no(), node.name);
     buf_pool.corrupted_evict(bpage, buf_page_t::READ_FIX);
   corrupted:
-    if (recv_recovery_is_on() && !srv_force_recovery)
+    if (recv_recovery_is_pending() && !srv_force_recovery)
     {
       mysql_mutex_lock(&recv_sys.mutex);
       recv_sys.set_corrupt_fs();
       mysql_mutex_unlock(&recv_sys.mutex);
     }
   }
-  else if (dberr_t err= bpage->read_complete(*node))
+  else if (dberr_t err= bpage->read_complete(node))
   {
     if (err != DB_FAIL)
       ib::error() << "Failed to read page " << id.page_no()
-                  << " from file '" << node->name << "': " << err;
+                  << " from file '" << node.name << "': " << err;
     goto corrupted;
   }
+}
+
+void IORequest::read_complete(int io_error) const
+{
+  ut_ad(fil_validate_skip());
+  ut_ad(node);
+  ut_ad(is_read());
+  ut_ad(bpage);
+
+  if (type == READ_BATCH)
+  {
+    buf_read_batch_t *batch= read_batch;
+    ut_ad(batch->bpage[0] == bpage);
+    for (uint32_t i= 0; i < batch->n; i++)
+    {
+      buf_page_t *b= batch->bpage[i];
+      if (!io_error)
+        memcpy_aligned<4096>(b->frame, batch->page(i), srv_page_size);
+      fil_read_complete(b, *node, io_error);
+    }
+    aligned_free(batch->buf);
+    delete batch;
+  }
+  else
+    fil_read_complete(bpage, *node, io_error);
 
   node->space->release();
 }
@@ -36,6 +36,7 @@ Completed 2011/7/10 Sunny and Jimmy Yang
 #include "fts0plugin.h"
 #include "fts0vlc.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <vector>
 
@@ -145,6 +146,9 @@ struct fts_query_t {
 	ib_rbt_t*	wildcard_words;	/*!< words with wildcard */
 
 	bool		multi_exist;	/*!< multiple FTS_EXIST oper */
+	ulint		limit;		/*!< Number of most relevant documents
+					that are needed, or ULINT_UNDEFINED
+					if all matches must be returned */
 	byte		visiting_sub_exp; /*!< count of nested
 					fts_ast_visit_sub_exp() */
 
@@ -3641,6 +3645,125 @@ fts_retrieve_ranking(
 	DBUG_RETURN(0);
 }
 
+/** Add an element to a bounded selection of the best elements.
+@param top     binary heap whose front is the worst selected element
+@param k       maximum number of elements to select
+@param elem    element to add
+@param better  comparator that returns whether the first element is better */
+template<typename T, typename Better>
+static void fts_query_top_k_add(std::vector<T> &top, ulint k, T elem,
+				Better better)
+{
+	if (top.size() < k) {
+		top.push_back(elem);
+		std::push_heap(top.begin(), top.end(), better);
+	} else if (better(elem, top.front())) {
+		std::pop_heap(top.begin(), top.end(), better);
+		top.back() = elem;
+		std::push_heap(top.begin(), top.end(), better);
+	}
+}
+
+/** Rank the documents that may be among the query->limit most relevant
+ones. The rank of a document is the sum of freq * idf * idf of the words
+that it contains (see fts_query_calculate_ranking()). As in the MaxScore
+and WAND algorithms, we first compute an upper bound of the rank from the
+maximum frequency of each word, and skip the document if the bound is
+below the rank of the k-th best document found so far.
+@param query	query state
+@return the most relevant documents, ordered by doc_id
+@retval nullptr if the words of the documents are not known */
+static ib_rbt_t* fts_query_rank_top_k(fts_query_t* query)
+{
+	const ulint		k = query->limit;
+	const size_t		n_words = query->word_vector->size();
+	std::vector<double>	max_weight(n_words);
+
+	ut_ad(k < rbt_size(query->doc_ids));
+
+	for (size_t i = 0; i < n_words; i++) {
+		ib_rbt_bound_t	parent;
+
+		if (rbt_search(query->word_freqs, &parent,
+			       &query->word_vector->at(i))) {
+			return nullptr;
+		}
+
+		const fts_word_freq_t*	word_freq = rbt_value(
+			fts_word_freq_t, parent.last);
+		ulint			max_freq = 0;
+
+		for (const ib_rbt_node_t* node = rbt_first(
+			     word_freq->doc_freqs);
+		     node; node = rbt_next(word_freq->doc_freqs, node)) {
+			max_freq = std::max(
+				max_freq, rbt_value(fts_doc_freq_t, node)->freq);
+		}
+
+		max_weight[i] = double(max_freq)
+			* word_freq->idf * word_freq->idf;
+	}
+
+	/* Same order as fts_query_compare_rank(): descending on the rank
+	and ascending on the doc_id. */
+	auto better = [](const fts_ranking_t* a, const fts_ranking_t* b) {
+		return a->rank > b->rank
+			|| (a->rank == b->rank && a->doc_id < b->doc_id);
+	};
+
+	std::vector<fts_ranking_t*>	top;
+	ulint				n_skipped = 0;
+	top.reserve(k);
+
+	for (const ib_rbt_node_t* node = rbt_first(query->doc_ids);
+	     node; node = rbt_next(query->doc_ids, node)) {
+		fts_ranking_t*	ranking = rbt_value(fts_ranking_t, node);
+
+		if (top.size() == k) {
+			double	bound = ranking->rank;
+
+			for (ulint pos = 0; ranking->words
+			     && pos < ranking->words_len * CHAR_BIT; pos++) {
+				if (ranking->words[pos / CHAR_BIT]
+				    & (1 << (pos % CHAR_BIT))) {
+					ut_ad(pos < n_words);
+					bound += max_weight[pos];
+				}
+			}
+
+			/* Allow for the rounding errors of the
+			single precision fts_rank_t. */
+			if (bound * 1.0001 < top.front()->rank) {
+				n_skipped++;
+				continue;
+			}
+		}
+
+		fts_query_calculate_ranking(query, ranking);
+		ranking->words = NULL;
+		fts_query_top_k_add(top, k, ranking, better);
+	}
+
+	ib_rbt_t*	result = rbt_create(
+		sizeof(fts_ranking_t), fts_ranking_doc_id_cmp);
+
+	for (const fts_ranking_t* ranking : top) {
+		ut_ad(!ranking->words);
+		rbt_insert(result, ranking, ranking);
+	}
+
+	query->total_size += SIZEOF_RBT_CREATE
+		+ top.size() * (SIZEOF_RBT_NODE_ADD + sizeof(fts_ranking_t));
+
+	if (UNIV_UNLIKELY(fts_enable_diag_print)) {
+		ib::info() << "FTS top-" << k << " ranking skipped "
+			<< n_skipped << " of " << rbt_size(query->doc_ids)
+			<< " documents";
+	}
+
+	return result;
+}
+
 /*****************************************************************//**
 Create the result and copy the data to it. */
 static
@@ -3674,6 +3797,18 @@ fts_query_prepare_result(
 		doc_id_t*	updates =
 			(doc_id_t*) query->deleted->doc_ids->data;
 
+		/* With a single word, the rank is proportional to the
+		frequency. If only the query->limit most relevant documents
+		are needed, select them by descending frequency and
+		ascending doc_id, like fts_query_compare_rank(). */
+		std::vector<const fts_doc_freq_t*>	top;
+		auto better = [](const fts_doc_freq_t* a,
+				 const fts_doc_freq_t* b) {
+			return a->freq > b->freq
+				|| (a->freq == b->freq
+				    && a->doc_id < b->doc_id);
+		};
+
 		node = rbt_first(query->word_freqs);
 		ut_ad(node);
 		word_freq = rbt_value(fts_word_freq_t, node);
@@ -3682,7 +3817,6 @@ fts_query_prepare_result(
 		     node;
 		     node = rbt_next(word_freq->doc_freqs, node)) {
 			fts_doc_freq_t* doc_freq;
-			fts_ranking_t	ranking;
 
 			doc_freq = rbt_value(fts_doc_freq_t, node);
 
@@ -3694,6 +3828,13 @@ fts_query_prepare_result(
 				continue;
 			}
 
+			if (query->limit != ULINT_UNDEFINED) {
+				fts_query_top_k_add<const fts_doc_freq_t*>(
+					top, query->limit, doc_freq, better);
+				continue;
+			}
+
+			fts_ranking_t	ranking;
 			ranking.doc_id = doc_freq->doc_id;
 			ranking.rank = static_cast<fts_rank_t>(doc_freq->freq);
 			ranking.words = NULL;
@@ -3708,6 +3849,16 @@ fts_query_prepare_result(
 			}
 		}
 
+		for (const fts_doc_freq_t* doc_freq : top) {
+			fts_ranking_t	ranking;
+			ranking.doc_id = doc_freq->doc_id;
+			ranking.rank = static_cast<fts_rank_t>(doc_freq->freq);
+			ranking.words = NULL;
+
+			fts_query_add_ranking(query, result->rankings_by_id,
+					      &ranking);
+		}
+
 		/* Calculate IDF only after we exclude the deleted items */
 		fts_query_calculate_idf(query);
 
@@ -3732,6 +3883,14 @@ fts_query_prepare_result(
 
 	ut_a(rbt_size(query->doc_ids) > 0);
 
+	if (result_is_null && query->limit < rbt_size(query->doc_ids)) {
+		if (ib_rbt_t* top = fts_query_rank_top_k(query)) {
+			rbt_free(result->rankings_by_id);
+			result->rankings_by_id = top;
+			DBUG_RETURN(result);
+		}
+	}
+
 	for (node = rbt_first(query->doc_ids);
 	     node;
 	     node = rbt_next(query->doc_ids, node)) {
@@ -3945,6 +4104,8 @@ fts_query_can_optimize(
 @param[in]	query_str	FTS query
 @param[in]	query_len	FTS query string len in bytes
 @param[in,out]	result		result doc ids
+@param[in]	limit		number of most relevant documents that
+				are needed, or ULINT_UNDEFINED
 @return DB_SUCCESS if successful otherwise error code */
 dberr_t
 fts_query(
@@ -3953,7 +4114,8 @@ fts_query(
 	uint		flags,
 	const byte*	query_str,
 	ulint		query_len,
-	fts_result_t**	result)
+	fts_result_t**	result,
+	ulint		limit)
 {
 	fts_query_t	query;
 	dberr_t		error = DB_SUCCESS;
@@ -3978,6 +4140,10 @@ fts_query(
 	query.trx = query_trx;
 	query.index = index;
 	query.boolean_mode = boolean_mode;
+	/* The rank of boolean mode or query expansion searches is not
+	a sum of per-word weights. */
+	query.limit = (flags & (FTS_BOOL | FTS_EXPAND))
+		? ULINT_UNDEFINED : limit;
 	query.deleted = fts_doc_ids_create();
 	query.cur_node = NULL;
 
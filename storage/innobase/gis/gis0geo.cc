@@ -32,6 +32,7 @@ Created 2013/03/27 Allen Lai and Jimmy Yang
 
 #include <spatial.h>
 #include <cmath>
+#include <utility>
 
 /* These definitions are for comparing 2 mbrs. */
 
@@ -648,3 +649,39 @@ int rtree_key_cmp(page_cur_mode_t mode, const void *b, const void *a)
 
   return 0;
 }
+
+/** Map a coordinate to an unsigned integer that preserves the order.
+@param d  coordinate
+@return the most significant 32 bits of the order-preserving image of d */
+static uint32_t rtree_hilbert_coord(double d)
+{
+  uint64_t u;
+  memcpy(&u, &d, sizeof u);
+  u= (u & uint64_t{1} << 63) ? ~u : u | uint64_t{1} << 63;
+  return uint32_t(u >> 32);
+}
+
+uint64_t rtree_hilbert_value(const double *mbr)
+{
+  uint32_t x= rtree_hilbert_coord((mbr[0] + mbr[1]) / 2);
+  uint32_t y= rtree_hilbert_coord((mbr[2] + mbr[3]) / 2);
+  uint64_t d= 0;
+
+  for (uint32_t s= 1U << 31; s; s>>= 1)
+  {
+    const uint32_t rx= !!(x & s), ry= !!(y & s);
+    d+= uint64_t{s} * s * ((3 * rx) ^ ry);
+    /* Rotate the quadrant. */
+    if (!ry)
+    {
+      if (rx)
+      {
+        x= ~x;
+        y= ~y;
+      }
+      std::swap(x, y);
+    }
+  }
+
+  return d;
+}
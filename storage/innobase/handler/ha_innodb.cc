@@ -67,6 +67,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "buf0dump.h"
 #include "buf0buf.h"
 #include "buf0flu.h"
+#include "buf0l2.h"
 #include "buf0lru.h"
 #include "dict0boot.h"
 #include "dict0load.h"
@@ -89,6 +90,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "row0log.h"
 #include "row0merge.h"
 #include "row0mysql.h"
+#include "row0pread.h"
 #include "row0quiesce.h"
 #include "row0sel.h"
 #include "row0upd.h"
@@ -397,6 +399,24 @@ static TYPELIB innodb_deadlock_report_typelib = {
 	NULL
 };
 
+/** Names of allowed values of innodb_lock_grant_policy */
+static const char *innodb_lock_grant_policy_names[]= {
+	"fcfs", /* Grant waiting locks in the order of the queue */
+	"cats", /* Contention-Aware Transaction Scheduling */
+	NullS
+};
+
+static_assert(LOCK_GRANT_FCFS == 0, "compatibility");
+static_assert(LOCK_GRANT_CATS == 1, "compatibility");
+
+/** Enumeration of innodb_lock_grant_policy */
+static TYPELIB innodb_lock_grant_policy_typelib = {
+	array_elements(innodb_lock_grant_policy_names) - 1,
+	"innodb_lock_grant_policy_typelib",
+	innodb_lock_grant_policy_names,
+	NULL
+};
+
 /** Allowed values of innodb_instant_alter_column_allowed */
 const char* innodb_instant_alter_column_allowed_names[] = {
 	"never", /* compatible with MariaDB 5.5 to 10.2 */
@@ -521,6 +541,7 @@ mysql_pfs_key_t	srv_innodb_monitor_mutex_key;
 mysql_pfs_key_t	srv_misc_tmpfile_mutex_key;
 mysql_pfs_key_t	srv_monitor_file_mutex_key;
 mysql_pfs_key_t	buf_dblwr_mutex_key;
+mysql_pfs_key_t	buf_l2_mutex_key;
 mysql_pfs_key_t	trx_pool_mutex_key;
 mysql_pfs_key_t	trx_pool_manager_mutex_key;
 mysql_pfs_key_t	lock_wait_mutex_key;
@@ -550,6 +571,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	PSI_KEY(srv_misc_tmpfile_mutex),
 	PSI_KEY(srv_monitor_file_mutex),
 	PSI_KEY(buf_dblwr_mutex),
+	PSI_KEY(buf_l2_mutex),
 	PSI_KEY(trx_pool_mutex),
 	PSI_KEY(trx_pool_manager_mutex),
 	PSI_KEY(lock_wait_mutex),
@@ -669,6 +691,9 @@ ha_create_table_option innodb_table_option_list[]=
   HA_TOPTION_ENUM("ENCRYPTED", encryption, "DEFAULT,YES,NO", 0),
   /* With this option the user defines the key identifier using for the encryption */
   HA_TOPTION_SYSVAR("ENCRYPTION_KEY_ID", encryption_key_id, default_encryption_key_id),
+  /* With this option the user can choose the compression algorithm
+  of ROW_FORMAT=COMPRESSED pages */
+  HA_TOPTION_ENUM("ZIP_ALGORITHM", zip_algorithm, "DEFAULT,ZLIB,LZ4", 0),
 
   HA_TOPTION_END
 };
@@ -884,6 +909,30 @@ static MYSQL_THDVAR_STR(tmpdir,
   "Directory for temporary non-tablespace files.",
   innodb_tmpdir_validate, NULL, NULL);
 
+static MYSQL_THDVAR_UINT(ddl_threads, PLUGIN_VAR_RQCMDARG,
+  "Number of threads that scan the clustered index and merge-sort the"
+  " records when creating secondary indexes without rebuilding the table"
+  " (1=single-threaded)",
+  NULL, NULL, 1, 1, 64, 0);
+
+static MYSQL_THDVAR_UINT(scan_resistant_pct, PLUGIN_VAR_RQCMDARG,
+  "Percentage of the buffer pool size; the leaf pages of a full scan of"
+  " a larger index are replaced first once the scan has passed them"
+  " (0=disable)",
+  NULL, NULL, 0, 0, 100, 0);
+
+static MYSQL_THDVAR_UINT(parallel_read_threads, PLUGIN_VAR_RQCMDARG,
+  "Number of threads that count the records of the clustered index"
+  " for SELECT COUNT(*) (1=use a table scan)",
+  NULL, NULL, 1, 1, 64, 0);
+
+static MYSQL_THDVAR_UINT(autoinc_prefetch, PLUGIN_VAR_RQCMDARG,
+  "Number of AUTO_INCREMENT values that a table handle reserves at a time"
+  " and assigns without acquiring the AUTO-INC lock or mutex of the table;"
+  " unused values will be skipped. Ignored with binlog_format=STATEMENT"
+  " (0=disable)",
+  NULL, NULL, 0, 0, 65536, 0);
+
 static size_t truncated_status_writes;
 
 static SHOW_VAR innodb_status_variables[]= {
@@ -901,6 +950,9 @@ static SHOW_VAR innodb_status_variables[]= {
   (char*) &export_vars.innodb_buffer_pool_resize_status,  SHOW_CHAR},
   {"buffer_pool_load_incomplete",
   &export_vars.innodb_buffer_pool_load_incomplete,        SHOW_BOOL},
+  {"buffer_pool_l2_dropped", &buf_l2.stat.n_dropped, SHOW_SIZE_T},
+  {"buffer_pool_l2_hits", &buf_l2.stat.n_hits, SHOW_SIZE_T},
+  {"buffer_pool_l2_writes", &buf_l2.stat.n_writes, SHOW_SIZE_T},
   {"buffer_pool_pages_data", &UT_LIST_GET_LEN(buf_pool.LRU), SHOW_SIZE_T},
   {"buffer_pool_bytes_data",
    &export_vars.innodb_buffer_pool_bytes_data, SHOW_SIZE_T},
@@ -913,6 +965,8 @@ static SHOW_VAR innodb_status_variables[]= {
   {"buffer_pool_pages_latched",
    &export_vars.innodb_buffer_pool_pages_latched, SHOW_SIZE_T},
 #endif /* UNIV_DEBUG */
+  {"buffer_pool_pages_made_last",
+   &buf_pool.stat.n_pages_made_last, SHOW_SIZE_T},
   {"buffer_pool_pages_made_not_young",
    &buf_pool.stat.n_pages_not_made_young, SHOW_SIZE_T},
   {"buffer_pool_pages_made_young",
@@ -930,6 +984,7 @@ static SHOW_VAR innodb_status_variables[]= {
   {"buffer_pool_read_ahead", &buf_pool.stat.n_ra_pages_read, SHOW_SIZE_T},
   {"buffer_pool_read_ahead_evicted",
    &buf_pool.stat.n_ra_pages_evicted, SHOW_SIZE_T},
+  {"buffer_pool_read_ahead_reads", &buf_pool.stat.n_ra_reads, SHOW_SIZE_T},
   {"buffer_pool_read_requests",
    &export_vars.innodb_buffer_pool_read_requests, SHOW_SIZE_T},
   {"buffer_pool_reads", &buf_pool.stat.n_pages_read, SHOW_SIZE_T},
@@ -1807,6 +1862,15 @@ const char *thd_innodb_tmpdir(THD *thd)
 	return(tmp_dir);
 }
 
+/** Get the value of innodb_ddl_threads.
+@param[in]	thd	thread handle, or NULL to query
+			the global innodb_ddl_threads.
+@return number of threads for creating secondary indexes */
+uint thd_ddl_threads(THD *thd)
+{
+	return(THDVAR(thd, ddl_threads));
+}
+
 /** Obtain the InnoDB transaction of a MySQL thread.
 @param[in,out]	thd	thread handle
 @return reference to transaction pointer */
@@ -3510,6 +3574,11 @@ ha_innobase::reset_template(void)
 		m_prebuilt->pk_filter = NULL;
 		m_prebuilt->template_type = ROW_MYSQL_NO_TEMPLATE;
 	}
+	if (m_prebuilt->scan_filter) {
+		m_prebuilt->scan_filter = NULL;
+		m_prebuilt->idx_cond_n_cols = 0;
+		m_prebuilt->template_type = ROW_MYSQL_NO_TEMPLATE;
+	}
 }
 
 /*****************************************************************//**
@@ -4993,7 +5062,15 @@ ha_innobase::table_flags() const
 	/* Need to use tx_isolation here since table flags is (also)
 	called before prebuilt is inited. */
 
-	if (thd_tx_isolation(thd) <= ISO_READ_COMMITTED) {
+	const ulong		iso = thd_tx_isolation(thd);
+
+	/* A locking read would be needed for SERIALIZABLE. */
+	if (iso != ISO_SERIALIZABLE
+	    && THDVAR(thd, parallel_read_threads) > 1) {
+		flags |= HA_HAS_RECORDS;
+	}
+
+	if (iso <= ISO_READ_COMMITTED) {
 		return(flags);
 	}
 
@@ -5965,6 +6042,19 @@ ha_innobase::open(const char* name, int, uint)
 			ib_table->release();
 			DBUG_RETURN(ret_err);
 		}
+	} else if ((ib_table->flags2 & DICT_TF2_ZIP_LZ4)
+		   && !provider_service_lz4->is_loaded
+		   && !thd_tablespace_op(thd)) {
+		push_warning_printf(
+			thd, Sql_condition::WARN_LEVEL_WARN,
+			ER_PROVIDER_NOT_LOADED,
+			"Table %s is compressed with LZ4, which is not"
+			" currently loaded. Please load the LZ4 provider"
+			" plugin to open the table",
+			table_share->table_name.str);
+		ib_table->release();
+		set_my_errno(ENOENT);
+		DBUG_RETURN(HA_ERR_NO_SUCH_TABLE);
 	}
 
 	m_prebuilt = row_create_prebuilt(ib_table, table->s->reclength);
@@ -7379,6 +7469,7 @@ ha_innobase::build_template(
 	m_prebuilt->mysql_prefix_len = 0;
 	m_prebuilt->n_template = 0;
 	m_prebuilt->idx_cond_n_cols = 0;
+	m_prebuilt->scan_filter = NULL;
 
 	/* Note that in InnoDB, i is the column number in the table.
 	MySQL calls columns 'fields'. */
@@ -7577,10 +7668,53 @@ ha_innobase::build_template(
 		m_prebuilt->idx_cond = NULL;
 		ut_ad(num_v == 0);
 
+		/* A filter pushed into a table scan is checked in
+		row_search_idx_cond_check() like an index condition.
+		Convert the fields that it refers to first, so that the
+		rest of the record needs to be converted only if the
+		filter accepts it. ha_innobase::scan_filter_push() has
+		made sure that none of them is virtual or a BLOB. */
+		const MY_BITMAP* scan_filter_fields = NULL;
+
+		if (pushed_scan_filter && !m_prebuilt->pk_filter
+		    && m_prebuilt->index == clust_index) {
+			m_prebuilt->scan_filter = this;
+			scan_filter_fields = pushed_scan_filter->fields();
+
+			for (ulint i = 0; i < n_fields; i++) {
+				const Field*	field = table->field[i];
+
+				if (!field->stored_in_db()) {
+					num_v++;
+					continue;
+				}
+
+				if (!bitmap_is_set(scan_filter_fields, i)) {
+					continue;
+				}
+
+				mysql_row_templ_t* templ= build_template_field(
+					m_prebuilt, clust_index, index,
+					table, field, i - num_v, 0);
+				templ->icp_rec_field_no = templ->rec_field_no;
+				m_prebuilt->idx_cond_n_cols++;
+			}
+
+			ut_ad(m_prebuilt->idx_cond_n_cols > 0);
+			num_v = 0;
+		}
+
 		for (ulint i = 0; i < n_fields; i++) {
 			const Field*	field = table->field[i];
 			const bool is_v = !field->stored_in_db();
 
+			if (scan_filter_fields
+			    && bitmap_is_set(scan_filter_fields, i)) {
+				/* Added above */
+				ut_ad(!is_v);
+				continue;
+			}
+
 			if (whole_row) {
 				if (is_v && skip_virtual) {
 					num_v++;
@@ -7809,6 +7943,12 @@ ha_innobase::write_row(
 			goto func_exit;
 		}
 
+		if (!insert_id_for_cur_row) {
+			/* The value was specified by the user. */
+			innobase_invalidate_autoinc_ranges(
+				table->next_number_field->val_uint());
+		}
+
 		auto_inc_used = true;
 	}
 
@@ -8594,6 +8734,10 @@ ha_innobase::update_row(
 		goto func_exit;
 	}
 
+	if (autoinc) {
+		innobase_invalidate_autoinc_ranges(autoinc);
+	}
+
 	if (!uvect->n_fields) {
 		/* This is the same as success, but instructs
 		MySQL that the row is not really updated and it
@@ -8830,6 +8974,8 @@ ha_innobase::index_end(void)
 
 	in_range_check_pushed_down = FALSE;
 
+	m_prebuilt->scan_resistant = false;
+
 	m_ds_mrr.dsmrr_close();
 
 	DBUG_RETURN(0);
@@ -8927,6 +9073,19 @@ overwrap, we use this test only as a secondary way of determining the
 start of a new SQL statement. */
 
 
+/** Determine whether a full scan of an index is large enough to use
+the scan-resistant mode (innodb_scan_resistant_pct).
+@param thd    current thread
+@param index  index to be scanned
+@return whether the index is larger than the configured percentage
+of the buffer pool */
+static bool innobase_scan_is_large(THD *thd, const dict_index_t *index)
+{
+	const ulonglong	pct = THDVAR(thd, scan_resistant_pct);
+
+	return pct && index->stat_index_size > buf_pool.curr_size * pct / 100;
+}
+
 /**********************************************************************//**
 Positions an index cursor to the index specified in the handle. Fetches the
 row if any.
@@ -8973,6 +9132,11 @@ ha_innobase::index_read(
 		DBUG_RETURN(HA_ERR_KEY_NOT_FOUND);
 	}
 
+	/* A scan from the start of a large index should not
+	replace the working set in the buffer pool. */
+	m_prebuilt->scan_resistant = !key_len
+		&& innobase_scan_is_large(m_user_thd, index);
+
 	/* For R-Tree index, we will always place the page lock to
 	pages being searched */
 	if (index->is_spatial() && !m_prebuilt->trx->will_lock) {
@@ -9251,7 +9415,8 @@ STATEMENT to ROW if binary log format is MIXED and autoincrement values
 are changed in the statement */
 bool ha_innobase::autoinc_lock_mode_stmt_unsafe() const
 {
-  return innobase_autoinc_lock_mode == AUTOINC_NO_LOCKING;
+  return innobase_autoinc_lock_mode == AUTOINC_NO_LOCKING ||
+    THDVAR(ha_thd(), autoinc_prefetch);
 }
 
 /***********************************************************************//**
@@ -9540,9 +9705,11 @@ ha_innobase::ft_init()
 	}
 
         /* If there is an FTS scan in progress, stop it */
-        fts_result_t* result =  (reinterpret_cast<NEW_FT_INFO*>(ft_handler))->ft_result;
+        NEW_FT_INFO* fts_hdl = reinterpret_cast<NEW_FT_INFO*>(ft_handler);
+        fts_result_t* result = fts_hdl->ft_result;
         if (result)
                 result->current= NULL;
+        fts_hdl->ft_found = 0;
 
 	DBUG_RETURN(rnd_init(false));
 }
@@ -9552,11 +9719,13 @@ Initialize FT index scan
 @return FT_INFO structure if successful or NULL */
 
 FT_INFO*
-ha_innobase::ft_init_ext(
-/*=====================*/
+ha_innobase::ft_init_ext_with_limit(
+/*================================*/
 	uint			flags,	/* in: */
 	uint			keynr,	/* in: */
-	String*			key)	/* in: */
+	String*			key,	/* in: */
+	ha_rows			limit)	/* in: number of most relevant
+					rows needed, or HA_POS_ERROR */
 {
 	NEW_FT_INFO*		fts_hdl = NULL;
 	dict_index_t*		index;
@@ -9645,22 +9814,39 @@ ha_innobase::ft_init_ext(
 	const byte*	q = reinterpret_cast<const byte*>(
 		const_cast<char*>(query));
 
-	// FIXME: support ft_init_ext_with_hints(), pass LIMIT
-	dberr_t	error = fts_query(trx, index, flags, q, query_len, &result);
+	/* The limit is ignored for boolean mode and query expansion */
+	const ulint	ft_limit = limit >= ULINT_UNDEFINED
+		|| (flags & (FT_BOOL | FT_EXPAND))
+		? ULINT_UNDEFINED : ulint(limit);
+
+	dberr_t	error = fts_query(trx, index, flags, q, query_len, &result,
+				  ft_limit);
 
 	if (error != DB_SUCCESS) {
 		my_error(convert_error_code_to_mysql(error, 0, NULL), MYF(0));
 		return(NULL);
 	}
 
-	/* Allocate FTS handler, and instantiate it before return */
+	/* Allocate FTS handler, and instantiate it before return.
+	If the result is limited, keep a copy of the query after the
+	handler, in case it has to be run again by ft_read(). */
+	const ulint	copy_len = ft_limit == ULINT_UNDEFINED ? 0 : query_len;
+
 	fts_hdl = reinterpret_cast<NEW_FT_INFO*>(
-		my_malloc(PSI_INSTRUMENT_ME, sizeof(NEW_FT_INFO), MYF(0)));
+		my_malloc(PSI_INSTRUMENT_ME, sizeof(NEW_FT_INFO) + copy_len,
+			  MYF(0)));
 
 	fts_hdl->please = const_cast<_ft_vft*>(&ft_vft_result);
 	fts_hdl->could_you = const_cast<_ft_vft_ext*>(&ft_vft_ext_result);
 	fts_hdl->ft_prebuilt = m_prebuilt;
 	fts_hdl->ft_result = result;
+	fts_hdl->ft_limit = ft_limit;
+	fts_hdl->ft_found = 0;
+	fts_hdl->ft_index = index;
+	fts_hdl->ft_flags = flags;
+	fts_hdl->ft_query_len = copy_len;
+	fts_hdl->ft_query = static_cast<const byte*>(
+		memcpy(fts_hdl + 1, q, copy_len));
 
 	/* FIXME: Re-evaluate the condition when Bug 14469540 is resolved */
 	m_prebuilt->in_fts_query = true;
@@ -9730,6 +9916,73 @@ innobase_fts_create_doc_id_key(
 	return DB_SUCCESS;
 }
 
+/** Run a full-text query again without the limit on the number of
+the most relevant documents, after all documents of the limited result
+were consumed but fewer rows than the limit were returned. This happens
+when some of the documents are not visible in the read view of the
+transaction.
+The documents of the limited result are excluded from the new result.
+@param fts_hdl	full-text search handler
+@param trx	transaction
+@return error code */
+static
+dberr_t
+innobase_fts_refill(NEW_FT_INFO* fts_hdl, trx_t* trx)
+{
+	fts_result_t*	result = fts_hdl->ft_result;
+
+	ut_ad(!result->current);
+
+	if (fts_hdl->ft_limit == ULINT_UNDEFINED
+	    || fts_hdl->ft_found >= fts_hdl->ft_limit
+	    || !result->rankings_by_id
+	    || rbt_size(result->rankings_by_id) < fts_hdl->ft_limit) {
+		/* Enough rows were returned, or the result was not
+		truncated */
+		return(DB_SUCCESS);
+	}
+
+	fts_result_t*	full;
+	dberr_t		error = fts_query(trx, fts_hdl->ft_index,
+					  fts_hdl->ft_flags,
+					  fts_hdl->ft_query,
+					  fts_hdl->ft_query_len, &full,
+					  ULINT_UNDEFINED);
+
+	if (error != DB_SUCCESS) {
+		return(error);
+	}
+
+	if (full->rankings_by_id) {
+		fts_query_sort_result_on_rank(full);
+
+		/* Skip the documents that were already returned or found
+		to be invisible. The rank of a document may differ between
+		the results, so look it up in the new result. */
+		for (const ib_rbt_node_t* node
+			     = rbt_first(result->rankings_by_id);
+		     node; node = rbt_next(result->rankings_by_id, node)) {
+			ib_rbt_bound_t	parent;
+
+			if (!rbt_search(full->rankings_by_id, &parent,
+					rbt_value(fts_ranking_t, node))) {
+				rbt_delete(full->rankings_by_rank,
+					   rbt_value(fts_ranking_t,
+						     parent.last));
+			}
+		}
+
+		full->current = const_cast<ib_rbt_node_t*>(
+			rbt_first(full->rankings_by_rank));
+	}
+
+	fts_query_free_result(result);
+	fts_hdl->ft_result = full;
+	fts_hdl->ft_limit = ULINT_UNDEFINED;
+
+	return(DB_SUCCESS);
+}
+
 /**********************************************************************//**
 Fetch next result from the FT result set
 @return error code */
@@ -9741,14 +9994,15 @@ ha_innobase::ft_read(
 {
 	row_prebuilt_t*	ft_prebuilt;
 	mariadb_set_stats set_stats_temporary(handler_stats);
+	NEW_FT_INFO*	fts_hdl = reinterpret_cast<NEW_FT_INFO*>(ft_handler);
 
-	ft_prebuilt = reinterpret_cast<NEW_FT_INFO*>(ft_handler)->ft_prebuilt;
+	ft_prebuilt = fts_hdl->ft_prebuilt;
 
 	ut_a(ft_prebuilt == m_prebuilt);
 
 	fts_result_t*	result;
 
-	result = reinterpret_cast<NEW_FT_INFO*>(ft_handler)->ft_result;
+	result = fts_hdl->ft_result;
 
 	if (result->current == NULL) {
 		/* This is the case where the FTS query did not
@@ -9768,6 +10022,18 @@ ha_innobase::ft_read(
 	} else {
 		result->current = const_cast<ib_rbt_node_t*>(
 			rbt_next(result->rankings_by_rank, result->current));
+
+		if (result->current == NULL) {
+			dberr_t	err = innobase_fts_refill(
+				fts_hdl, m_prebuilt->trx);
+
+			if (err != DB_SUCCESS) {
+				return(convert_error_code_to_mysql(
+					       err, 0, m_user_thd));
+			}
+
+			result = fts_hdl->ft_result;
+		}
 	}
 
 next_record:
@@ -9789,6 +10055,7 @@ ha_innobase::ft_read(
 			}
 #endif
 			table->status= 0;
+			fts_hdl->ft_found++;
 			return(0);
 		}
 
@@ -9825,12 +10092,30 @@ ha_innobase::ft_read(
 		case DB_SUCCESS:
 			error = 0;
 			table->status = 0;
+			fts_hdl->ft_found++;
 			break;
 		case DB_RECORD_NOT_FOUND:
 			result->current = const_cast<ib_rbt_node_t*>(
 				rbt_next(result->rankings_by_rank,
 					 result->current));
 
+			if (!result->current) {
+				/* The document was not visible. If the
+				result was limited to the most relevant
+				documents, fetch the rest of them. */
+				ret = innobase_fts_refill(
+					fts_hdl, m_prebuilt->trx);
+
+				if (ret != DB_SUCCESS) {
+					error = convert_error_code_to_mysql(
+						ret, 0, m_user_thd);
+					table->status = STATUS_NOT_FOUND;
+					break;
+				}
+
+				result = fts_hdl->ft_result;
+			}
+
 			if (!result->current) {
 				/* exhaust the result set, should return
 				HA_ERR_END_OF_FILE just like
@@ -11421,6 +11706,28 @@ create_table_info_t::check_table_options()
 		}
 	}
 
+	if (options->zip_algorithm != PAGE_ZIP_DEFAULT
+	    && row_format != ROW_TYPE_COMPRESSED
+	    && (row_format != ROW_TYPE_DEFAULT
+		|| !m_create_info->key_block_size)) {
+		push_warning(
+			m_thd, Sql_condition::WARN_LEVEL_WARN,
+			HA_WRONG_CREATE_OPTION,
+			"InnoDB: ZIP_ALGORITHM requires"
+			" ROW_FORMAT=COMPRESSED");
+		return "ZIP_ALGORITHM";
+	}
+
+	if (options->zip_algorithm == PAGE_ZIP_LZ4
+	    && !provider_service_lz4->is_loaded) {
+		push_warning(
+			m_thd, Sql_condition::WARN_LEVEL_WARN,
+			HA_WRONG_CREATE_OPTION,
+			"InnoDB: ZIP_ALGORITHM=LZ4 requires"
+			" the provider_lz4 plugin");
+		return "ZIP_ALGORITHM";
+	}
+
 	return NULL;
 }
 
@@ -11793,6 +12100,10 @@ bool create_table_info_t::innobase_table_flags()
 		m_flags |= DICT_TF_MASK_NO_ROLLBACK;
 	}
 
+	if (zip_ssize && options->zip_algorithm == PAGE_ZIP_LZ4) {
+		m_flags2 |= DICT_TF2_ZIP_LZ4;
+	}
+
 	/* Set the flags2 when create table or alter tables */
 	m_flags2 |= DICT_TF2_FTS_AUX_HEX_NAME;
 
@@ -14330,6 +14641,193 @@ ha_innobase::records_in_range(
 	DBUG_RETURN((ha_rows) n_rows);
 }
 
+/** Count the rows in the table that are visible to the transaction,
+by scanning key ranges of the clustered index in parallel.
+@return number of rows
+@retval HA_POS_ERROR if the rows could not be counted */
+ha_rows ha_innobase::records()
+{
+	if (!(ha_table_flags() & HA_HAS_RECORDS)) {
+		return(handler::records());
+	}
+
+	DBUG_ENTER("ha_innobase::records");
+	mariadb_set_stats set_stats_temporary(handler_stats);
+
+	update_thd(ha_thd());
+
+	dict_table_t*	table = m_prebuilt->table;
+	dict_index_t*	index = dict_table_get_first_index(table);
+	trx_t*		trx = m_prebuilt->trx;
+
+	/* A locking read must use the normal table scan. */
+	if (!table->space || !table->is_readable() || index->is_corrupted()
+	    || m_prebuilt->select_lock_type != LOCK_NONE) {
+		DBUG_RETURN(HA_POS_ERROR);
+	}
+
+	trx_start_if_not_started_xa(trx, false);
+
+	ReadView*	view = NULL;
+
+	if (!table->is_temporary()
+	    && trx->isolation_level > TRX_ISO_READ_UNCOMMITTED) {
+		trx->read_view.open(trx);
+		view = &trx->read_view;
+
+		/* See row_search_mvcc() for a comment on bulk_trx_id */
+		if (table->bulk_trx_id
+		    && !view->changes_visible(table->bulk_trx_id)) {
+			DBUG_RETURN(0);
+		}
+	}
+
+	trx->op_info = "counting records";
+
+	ulint	n_rows;
+	dberr_t	err = row_pread_count(index, trx, view,
+					THDVAR(m_user_thd,
+					       parallel_read_threads),
+					&n_rows);
+
+	trx->op_info = "";
+
+	/* On error, let the caller fall back to a table scan, which
+	will report the error. */
+	DBUG_RETURN(err == DB_SUCCESS ? ha_rows(n_rows) : HA_POS_ERROR);
+}
+
+/** @return whether parallel_scan() can be used */
+bool ha_innobase::can_parallel_scan()
+{
+	dict_table_t*	table = m_prebuilt->table;
+
+	/* A locking read must use the normal table scan.
+	row_sel_store_mysql_rec() would update prebuilt->fts_doc_id. */
+	return(table->space && table->is_readable()
+	       && !dict_table_get_first_index(table)->is_corrupted()
+	       && !dict_table_has_fts_index(table)
+	       && m_prebuilt->select_lock_type == LOCK_NONE);
+}
+
+/** Read the rows of the clustered index in several threads.
+@param n_threads	maximum number of threads
+@param visitor		consumer of the rows
+@return error code
+@retval HA_ERR_WRONG_COMMAND if the scan is not possible */
+int ha_innobase::parallel_scan(uint n_threads, Parallel_scan_visitor* visitor)
+{
+	DBUG_ENTER("ha_innobase::parallel_scan");
+
+	dict_table_t*	table = m_prebuilt->table;
+	dict_index_t*	index = dict_table_get_first_index(table);
+	trx_t*		trx = m_prebuilt->trx;
+
+	if (!can_parallel_scan()) {
+		DBUG_RETURN(HA_ERR_WRONG_COMMAND);
+	}
+
+	/* BLOB columns would be copied to prebuilt->blob_heap, and
+	virtual columns are computed by row_search_mvcc(). */
+	for (ulint i = 0; i < m_prebuilt->n_template; i++) {
+		const mysql_row_templ_t* templ = &m_prebuilt->mysql_template[i];
+
+		if (templ->is_virtual
+		    || DATA_LARGE_MTYPE(templ->type)
+		    || DATA_GEOMETRY_MTYPE(templ->type)) {
+			DBUG_RETURN(HA_ERR_WRONG_COMMAND);
+		}
+	}
+
+	if (m_prebuilt->blob_heap) {
+		row_mysql_prebuilt_free_blob_heap(m_prebuilt);
+	}
+
+	trx_start_if_not_started_xa(trx, false);
+
+	ReadView*	view = NULL;
+
+	if (!table->is_temporary()
+	    && trx->isolation_level > TRX_ISO_READ_UNCOMMITTED) {
+		trx->read_view.open(trx);
+		view = &trx->read_view;
+
+		/* See row_search_mvcc() for a comment on bulk_trx_id */
+		if (table->bulk_trx_id
+		    && !view->changes_visible(table->bulk_trx_id)) {
+			DBUG_RETURN(0);
+		}
+	}
+
+	/** Converter of the visible records to the MySQL format */
+	struct converter_t : public row_pread_visitor_t
+	{
+		row_prebuilt_t*		prebuilt;
+		Parallel_scan_visitor*	visitor;
+		uint			thread;
+		byte*			buf;
+
+		converter_t(row_prebuilt_t* prebuilt,
+			    Parallel_scan_visitor* visitor, uint thread) :
+			prebuilt(prebuilt), visitor(visitor), thread(thread),
+			buf(visitor->begin(thread)) {}
+
+		dberr_t visit(const rec_t* rec, const rec_offs* offsets,
+			      mem_heap_t*) override
+		{
+			/* Like row_search_mvcc(), skip a record whose
+			BLOB was not written yet (READ UNCOMMITTED). */
+			if (!row_sel_store_mysql_rec_clust(buf, prebuilt,
+							   rec, offsets)) {
+				return(DB_SUCCESS);
+			}
+
+			return(visitor->row(thread)
+			       ? DB_INTERRUPTED : DB_SUCCESS);
+		}
+	};
+
+	trx->op_info = "fetching rows";
+
+	row_pread_t	reader(index, trx, view);
+	dberr_t		err = reader.split(
+		n_threads * row_pread_t::RANGES_PER_THREAD);
+
+	if (err == DB_SUCCESS) {
+		std::atomic<size_t>	next{0};
+		std::atomic<dberr_t>	first_err{DB_SUCCESS};
+
+		row_pread_run(
+			std::min<ulint>(n_threads, reader.n_ranges()),
+			[&](ulint thread)
+			{
+				converter_t	converter(m_prebuilt, visitor,
+							  uint(thread));
+
+				for (size_t range;
+				     !reader.aborted()
+				     && (range = next++) < reader.n_ranges(); ) {
+					dberr_t	e = reader.scan(range, converter);
+
+					if (e != DB_SUCCESS) {
+						dberr_t	expected = DB_SUCCESS;
+						first_err.compare_exchange_strong(
+							expected, e);
+						reader.abort();
+					}
+				}
+
+				visitor->end(uint(thread));
+			});
+
+		err = first_err;
+	}
+
+	trx->op_info = "";
+
+	DBUG_RETURN(convert_error_code_to_mysql(err, 0, m_user_thd));
+}
+
 /*********************************************************************//**
 Gives an UPPER BOUND to the number of rows in a table. This is used in
 filesort.cc.
@@ -16487,6 +16985,124 @@ ha_innobase::innobase_get_autoinc(
 	return(m_prebuilt->autoinc_error);
 }
 
+/** Assign AUTO_INCREMENT values from a range that was reserved
+for this table handle (innodb_autoinc_prefetch). When the range has
+been exhausted, reserve a new one while holding dict_table_t::autoinc_mutex.
+Values that remain unused when the handle is closed are skipped.
+@param offset             auto_increment_offset
+@param increment          auto_increment_increment
+@param nb_desired_values  number of values requested, or 0 if unknown
+@param first_value        the first assigned value
+@param nb_reserved_values number of assigned values
+@return whether values were assigned */
+bool ha_innobase::innobase_get_autoinc_range(ulonglong offset,
+                                             ulonglong increment,
+                                             ulonglong nb_desired_values,
+                                             ulonglong *first_value,
+                                             ulonglong *nb_reserved_values)
+{
+  const ulonglong n_prefetch= THDVAR(m_user_thd, autoinc_prefetch);
+  if (!n_prefetch || srv_read_only_mode ||
+      thd_sql_command(m_user_thd) == SQLCOM_ALTER_TABLE ||
+      /* With statement-based replication, the replica must assign the
+      same values; see also autoinc_lock_mode_stmt_unsafe(). */
+      thd_binlog_format(m_user_thd) == BINLOG_FORMAT_STMT)
+    return false;
+
+  row_prebuilt_t *prebuilt= m_prebuilt;
+  nb_desired_values= std::max(nb_desired_values, 1ULL);
+
+  if (prebuilt->autoinc_range_n &&
+      (prebuilt->autoinc_range_increment != increment ||
+       prebuilt->autoinc_range_offset != offset ||
+       prebuilt->autoinc_range_version !=
+       prebuilt->table->autoinc_range_version))
+    prebuilt->autoinc_range_n= 0;
+
+  if (!prebuilt->autoinc_range_n)
+  {
+    dict_table_t *t= prebuilt->table;
+    const ulonglong col_max_value=
+      table->next_number_field->get_max_int_value();
+    t->autoinc_mutex.wr_lock();
+    /* Honor the AUTO-INC lock of a concurrent INSERT...SELECT or similar,
+    like innobase_lock_autoinc() does. */
+    if (innobase_autoinc_lock_mode != AUTOINC_NO_LOCKING &&
+        t->n_waiting_or_granted_auto_inc_locks)
+    {
+    fallback:
+      t->autoinc_mutex.wr_unlock();
+      return false;
+    }
+
+    ulonglong autoinc= dict_table_autoinc_read(t);
+    if (!autoinc || autoinc >= col_max_value)
+      goto fallback;
+    if (increment > 1)
+    {
+      if (increment > ~autoinc)
+        goto fallback;
+      autoinc= ((autoinc - 1) + increment - offset) / increment *
+        increment + offset;
+      if (autoinc >= col_max_value)
+        goto fallback;
+    }
+
+    const ulonglong n= std::max(ulonglong{n_prefetch}, nb_desired_values);
+    const ulonglong end= innobase_next_autoinc(autoinc, n, increment, offset,
+                                               col_max_value);
+    /* Leave the last values of the column to the normal code path,
+    which reports the overflow. */
+    if (end >= col_max_value || end <= autoinc)
+      goto fallback;
+    dict_table_autoinc_update_if_greater(t, end);
+    if (!t->autoinc_range_low || autoinc < t->autoinc_range_low)
+      t->autoinc_range_low= autoinc;
+    prebuilt->autoinc_range_version= t->autoinc_range_version;
+    t->autoinc_mutex.wr_unlock();
+
+    prebuilt->autoinc_range_next= autoinc;
+    prebuilt->autoinc_range_end= end;
+    prebuilt->autoinc_range_n= n;
+    prebuilt->autoinc_range_increment= increment;
+    prebuilt->autoinc_range_offset= offset;
+  }
+
+  const ulonglong n= std::min(nb_desired_values, prebuilt->autoinc_range_n);
+  *first_value= prebuilt->autoinc_range_next;
+  *nb_reserved_values= n;
+  prebuilt->autoinc_range_next+= n * increment;
+  prebuilt->autoinc_range_n-= n;
+
+  /* write_row() will not update the table's AUTO-INC counter
+  for any values below the end of the range. */
+  prebuilt->autoinc_last_value= prebuilt->autoinc_range_end;
+  prebuilt->autoinc_offset= offset;
+  prebuilt->autoinc_increment= increment;
+  return true;
+}
+
+/** Discard the AUTO_INCREMENT ranges that table handles have reserved
+(innodb_autoinc_prefetch) if an explicitly specified value may be inside
+one of them. This must be invoked before the value is written, so that
+the value will not be assigned from a range afterwards.
+@param value  the value that was specified by the user */
+void ha_innobase::innobase_invalidate_autoinc_ranges(ulonglong value)
+{
+  dict_table_t *t= m_prebuilt->table;
+  const ulonglong low= t->autoinc_range_low;
+  if (!low || value < low)
+    return;
+  t->autoinc_mutex.wr_lock();
+  if (t->autoinc_range_low && value >= t->autoinc_range_low &&
+      value < dict_table_autoinc_read(t))
+  {
+    t->autoinc_range_version= t->autoinc_range_version + 1;
+    t->autoinc_range_low= 0;
+  }
+  t->autoinc_mutex.wr_unlock();
+}
+
 /*******************************************************************//**
 This function reads the global auto-inc counter. It doesn't use the
 AUTOINC lock even if the lock mode is set to TRADITIONAL.
@@ -16541,6 +17157,11 @@ ha_innobase::get_auto_increment(
 	/* Prepare m_prebuilt->trx in the table handle */
 	update_thd(ha_thd());
 
+	if (innobase_get_autoinc_range(offset, increment, nb_desired_values,
+				       first_value, nb_reserved_values)) {
+		return;
+	}
+
 	error = innobase_get_autoinc(&autoinc);
 
 	if (error != DB_SUCCESS) {
@@ -18700,6 +19321,12 @@ static MYSQL_SYSVAR_BOOL(doublewrite, srv_use_doublewrite_buf,
   " Disable with --skip-innodb-doublewrite.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_ULONG(doublewrite_batches, srv_doublewrite_batches,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of doublewrite batches that can be written concurrently;"
+  " the doublewrite buffer is divided between them",
+  NULL, NULL, 1, 1, buf_dblwr_t::MAX_BATCHES, 0);
+
 static MYSQL_SYSVAR_BOOL(use_atomic_writes, srv_use_atomic_writes,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
   "Enable atomic writes, instead of using the doublewrite buffer, for files "
@@ -18968,6 +19595,17 @@ static MYSQL_SYSVAR_STR(buffer_pool_filename, srv_buf_dump_filename,
   "Filename to/from which to dump/load the InnoDB buffer pool",
   NULL, NULL, SRV_BUF_DUMP_FILENAME_DEFAULT);
 
+static MYSQL_SYSVAR_STR(buffer_pool_l2_file, srv_buf_l2_file,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "File on a fast local device for caching clean pages that are evicted"
+  " from the InnoDB buffer pool; NULL=disabled",
+  NULL, NULL, NULL);
+
+static MYSQL_SYSVAR_ULONGLONG(buffer_pool_l2_size, srv_buf_l2_size,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Size of innodb_buffer_pool_l2_file in bytes; 0=disabled",
+  NULL, NULL, 0, 0, ~0ULL, 0);
+
 static MYSQL_SYSVAR_BOOL(buffer_pool_dump_now, innodb_buffer_pool_dump_now,
   PLUGIN_VAR_RQCMDARG,
   "Trigger an immediate dump of the buffer pool into a file named @@innodb_buffer_pool_filename",
@@ -18983,6 +19621,16 @@ static MYSQL_SYSVAR_ULONG(buffer_pool_dump_pct, srv_buf_pool_dump_pct,
   "Dump only the hottest N% of each buffer pool, defaults to 25",
   NULL, NULL, 25, 1, 100, 0);
 
+static MYSQL_SYSVAR_ULONG(buffer_pool_load_threads, srv_buf_pool_load_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that submit reads during a buffer pool load",
+  NULL, NULL, 4, 1, 64, 0);
+
+static MYSQL_SYSVAR_ULONG(buffer_pool_load_io_depth, srv_buf_pool_load_io_depth,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum number of pending read requests during a buffer pool load",
+  NULL, NULL, 64, 1, 65536, 0);
+
 #ifdef UNIV_DEBUG
 /* Added to test the innodb_buffer_pool_load_incomplete status variable. */
 static MYSQL_SYSVAR_ULONG(buffer_pool_load_pages_abort, srv_buf_pool_load_pages_abort,
@@ -19030,6 +19678,12 @@ static MYSQL_SYSVAR_ULONG(flush_neighbors, srv_flush_neighbors,
   " when flushing a block",
   NULL, NULL, 1, 0, 2, 0);
 
+static MYSQL_SYSVAR_ULONG(page_cleaner_threads, srv_page_cleaner_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that compute checksums, encrypt or compress"
+  " and submit the page writes of a flush_list batch",
+  NULL, NULL, 1, 1, 8, 0);
+
 static MYSQL_SYSVAR_BOOL(deadlock_detect, innodb_deadlock_detect,
   PLUGIN_VAR_NOCMDARG,
   "Enable/disable InnoDB deadlock detector (default ON)."
@@ -19042,6 +19696,13 @@ static MYSQL_SYSVAR_ENUM(deadlock_report, innodb_deadlock_report,
   "How to report deadlocks (if innodb_deadlock_detect=ON).",
   NULL, NULL, Deadlock::REPORT_FULL, &innodb_deadlock_report_typelib);
 
+static MYSQL_SYSVAR_ENUM(lock_grant_policy, innodb_lock_grant_policy,
+  PLUGIN_VAR_RQCMDARG,
+  "The order of granting waiting record locks:"
+  " fcfs (in the order of the lock queue) or"
+  " cats (first to the transactions that block the most other transactions)",
+  NULL, NULL, LOCK_GRANT_FCFS, &innodb_lock_grant_policy_typelib);
+
 static MYSQL_SYSVAR_UINT(fill_factor, innobase_fill_factor,
   PLUGIN_VAR_RQCMDARG,
   "Percentage of B-tree page filled during bulk insert",
@@ -19122,6 +19783,12 @@ static MYSQL_SYSVAR_ULONG(sort_buffer_size, srv_sort_buf_size,
   "Memory buffer size for index creation",
   NULL, NULL, 1048576, 65536, 64<<20, 0);
 
+static MYSQL_SYSVAR_ULONG(old_version_cache_size, srv_old_version_cache_size,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum memory per transaction for caching old versions of records"
+  " that were constructed for a consistent read (0=disable the cache)",
+  NULL, NULL, 0, 0, 1<<30, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   PLUGIN_VAR_RQCMDARG,
   "Maximum modification log file size for online index creation",
@@ -19176,6 +19843,12 @@ static MYSQL_SYSVAR_ULONG(force_recovery, srv_force_recovery,
   "Helps to save your data in case the disk image of the database becomes corrupt. Value 5 can return bogus data, and 6 can permanently corrupt data.",
   NULL, NULL, 0, 0, 6, 0);
 
+static MYSQL_SYSVAR_BOOL(recovery_online, srv_recovery_online,
+  PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+  "Whether to accept connections while crash recovery is still applying"
+  " the redo log to pages that have not been accessed yet",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ULONG(page_size, srv_page_size,
   PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
   "Page size to use for all InnoDB tablespaces.",
@@ -19346,6 +20019,12 @@ static MYSQL_SYSVAR_BOOL(numa_interleave, srv_numa_interleave,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
   "Use NUMA interleave memory policy to allocate InnoDB buffer pool.",
   NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_BOOL(numa_local_chunks, srv_numa_local_chunks,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Bind each InnoDB buffer pool chunk to one NUMA node, using the allowed"
+  " nodes in turn",
+  NULL, NULL, FALSE);
 #endif /* HAVE_LIBNUMA */
 
 static MYSQL_SYSVAR_ENUM(stats_method, srv_innodb_stats_method,
@@ -19586,6 +20265,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(buffer_pool_size),
   MYSQL_SYSVAR(buffer_pool_chunk_size),
   MYSQL_SYSVAR(buffer_pool_filename),
+  MYSQL_SYSVAR(buffer_pool_l2_file),
+  MYSQL_SYSVAR(buffer_pool_l2_size),
   MYSQL_SYSVAR(buffer_pool_dump_now),
   MYSQL_SYSVAR(buffer_pool_dump_at_shutdown),
   MYSQL_SYSVAR(buffer_pool_dump_pct),
@@ -19594,19 +20275,23 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
 #endif /* UNIV_DEBUG */
   MYSQL_SYSVAR(buffer_pool_load_now),
   MYSQL_SYSVAR(buffer_pool_load_abort),
+  MYSQL_SYSVAR(buffer_pool_load_io_depth),
 #ifdef UNIV_DEBUG
   MYSQL_SYSVAR(buffer_pool_load_pages_abort),
 #endif /* UNIV_DEBUG */
   MYSQL_SYSVAR(buffer_pool_load_at_startup),
+  MYSQL_SYSVAR(buffer_pool_load_threads),
   MYSQL_SYSVAR(lru_scan_depth),
   MYSQL_SYSVAR(lru_flush_size),
   MYSQL_SYSVAR(flush_neighbors),
+  MYSQL_SYSVAR(page_cleaner_threads),
   MYSQL_SYSVAR(checksum_algorithm),
   MYSQL_SYSVAR(compression_level),
   MYSQL_SYSVAR(data_file_path),
   MYSQL_SYSVAR(temp_data_file_path),
   MYSQL_SYSVAR(data_home_dir),
   MYSQL_SYSVAR(doublewrite),
+  MYSQL_SYSVAR(doublewrite_batches),
   MYSQL_SYSVAR(stats_include_delete_marked),
   MYSQL_SYSVAR(use_atomic_writes),
   MYSQL_SYSVAR(fast_shutdown),
@@ -19617,6 +20302,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(flush_log_at_trx_commit),
   MYSQL_SYSVAR(flush_method),
   MYSQL_SYSVAR(force_recovery),
+  MYSQL_SYSVAR(recovery_online),
   MYSQL_SYSVAR(fill_factor),
   MYSQL_SYSVAR(ft_cache_size),
   MYSQL_SYSVAR(ft_total_cache_size),
@@ -19629,7 +20315,11 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(lock_wait_timeout),
   MYSQL_SYSVAR(deadlock_detect),
   MYSQL_SYSVAR(deadlock_report),
+  MYSQL_SYSVAR(lock_grant_policy),
   MYSQL_SYSVAR(page_size),
+  MYSQL_SYSVAR(scan_resistant_pct),
+  MYSQL_SYSVAR(parallel_read_threads),
+  MYSQL_SYSVAR(autoinc_prefetch),
   MYSQL_SYSVAR(log_buffer_size),
 #if defined __linux__ || defined _WIN32
   MYSQL_SYSVAR(log_file_buffering),
@@ -19650,6 +20340,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(max_purge_lag_wait),
   MYSQL_SYSVAR(old_blocks_pct),
   MYSQL_SYSVAR(old_blocks_time),
+  MYSQL_SYSVAR(old_version_cache_size),
   MYSQL_SYSVAR(open_files),
   MYSQL_SYSVAR(optimize_fulltext_only),
   MYSQL_SYSVAR(rollback_on_timeout),
@@ -19679,10 +20370,12 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(table_locks),
   MYSQL_SYSVAR(prefix_index_cluster_optimization),
   MYSQL_SYSVAR(tmpdir),
+  MYSQL_SYSVAR(ddl_threads),
   MYSQL_SYSVAR(autoinc_lock_mode),
   MYSQL_SYSVAR(use_native_aio),
 #ifdef HAVE_LIBNUMA
   MYSQL_SYSVAR(numa_interleave),
+  MYSQL_SYSVAR(numa_local_chunks),
 #endif /* HAVE_LIBNUMA */
   MYSQL_SYSVAR(random_read_ahead),
   MYSQL_SYSVAR(read_ahead_threshold),
@@ -20262,6 +20955,32 @@ bool ha_innobase::rowid_filter_push(Rowid_filter* pk_filter)
 	DBUG_RETURN(false);
 }
 
+/** Push a filter into table scans.
+@param[in]	filter	filter against which the rows of table scans
+			are to be checked
+@retval	false if pushed
+@retval	true if the filter refers to virtual or BLOB columns */
+bool ha_innobase::scan_filter_push(Scan_filter* filter)
+{
+	DBUG_ENTER("ha_innobase::scan_filter_push");
+	DBUG_ASSERT(filter != NULL);
+
+	/* The filter is checked before any off-page columns
+	are fetched. */
+	const MY_BITMAP* fields = filter->fields();
+	for (uint i = 0; i < table->s->fields; i++) {
+		const Field* field = table->field[i];
+		if (bitmap_is_set(fields, i)
+		    && (!field->stored_in_db()
+			|| (field->flags & BLOB_FLAG))) {
+			DBUG_RETURN(true);
+		}
+	}
+
+	pushed_scan_filter= filter;
+	DBUG_RETURN(false);
+}
+
 static bool is_part_of_a_key_prefix(const Field_longstr *field)
 {
   const TABLE_SHARE *s= field->table->s;
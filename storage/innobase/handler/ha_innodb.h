@@ -50,6 +50,8 @@ struct ha_table_option_struct
 						value OFF.*/
 	uint		encryption;		/*!<  DEFAULT, ON, OFF */
 	ulonglong	encryption_key_id;	/*!< encryption key id  */
+	uint		zip_algorithm;		/*!< DEFAULT, ZLIB, LZ4
+						for ROW_FORMAT=COMPRESSED */
 };
 
 /** The class defining a handle to an Innodb table */
@@ -159,7 +161,10 @@ class ha_innobase final : public handler
 
 	int ft_init() override;
 	void ft_end() override { rnd_end(); }
-	FT_INFO *ft_init_ext(uint flags, uint inx, String* key) override;
+	FT_INFO *ft_init_ext(uint flags, uint inx, String* key) override
+	{ return ft_init_ext_with_limit(flags, inx, key, HA_POS_ERROR); }
+	FT_INFO *ft_init_ext_with_limit(uint flags, uint inx, String* key,
+					ha_rows limit) override;
 	int ft_read(uchar* buf) override;
 
 	void position(const uchar *record) override;
@@ -186,6 +191,13 @@ class ha_innobase final : public handler
                 const key_range*        max_key,
                 page_range*             pages) override;
 
+	ha_rows records() override;
+
+	bool can_parallel_scan() override;
+
+	int parallel_scan(uint n_threads, Parallel_scan_visitor* visitor)
+		override;
+
 	ha_rows estimate_rows_upper_bound() override;
 
 	void update_create_info(HA_CREATE_INFO* create_info) override;
@@ -422,6 +434,13 @@ class ha_innobase final : public handler
 	@retval	false if pushed (always) */
 	bool rowid_filter_push(Rowid_filter *rowid_filter) override;
 
+	/** Push a filter into table scans.
+	@param[in]	filter	filter against which the rows of table
+				scans are to be checked
+	@retval	false if pushed
+	@retval	true if not pushed */
+	bool scan_filter_push(Scan_filter *filter) override;
+
 	bool can_convert_nocopy(const Field &field,
 				const Column_definition& new_field) const
 		override;
@@ -453,6 +472,11 @@ class ha_innobase final : public handler
 	dberr_t innobase_lock_autoinc();
 	ulonglong innobase_peek_autoinc();
 	dberr_t innobase_set_max_autoinc(ulonglong auto_inc);
+	bool innobase_get_autoinc_range(ulonglong offset, ulonglong increment,
+					ulonglong nb_desired_values,
+					ulonglong* first_value,
+					ulonglong* nb_reserved_values);
+	void innobase_invalidate_autoinc_ranges(ulonglong value);
 
 	/** Resets a query execution 'template'.
 	@see build_template() */
@@ -579,6 +603,17 @@ typedef struct new_ft_info
 	struct _ft_vft_ext	*could_you;
 	row_prebuilt_t*		ft_prebuilt;
 	fts_result_t*		ft_result;
+	/** number of the most relevant documents that ft_result
+	was limited to, or ULINT_UNDEFINED */
+	ulint			ft_limit;
+	/** number of rows that ft_read() returned since ft_init() */
+	ulint			ft_found;
+	/** the full-text index, flags and query, for running the
+	query again without ft_limit */
+	dict_index_t*		ft_index;
+	uint			ft_flags;
+	ulint			ft_query_len;
+	const byte*		ft_query;
 } NEW_FT_INFO;
 
 /**
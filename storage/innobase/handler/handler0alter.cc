@@ -1544,10 +1544,13 @@ static bool alter_options_need_rebuild(
 	const ha_table_option_struct& opt= *table->s->option_struct;
 
 	/* Allow an instant change to enable page_compressed,
-	and any change of page_compression_level. */
+	and any change of page_compression_level.
+	Changing zip_algorithm requires recompressing all pages. */
 	if ((!alt_opt.page_compressed && opt.page_compressed)
 	    || alt_opt.encryption != opt.encryption
-	    || alt_opt.encryption_key_id != opt.encryption_key_id) {
+	    || alt_opt.encryption_key_id != opt.encryption_key_id
+	    || (alt_opt.zip_algorithm == PAGE_ZIP_LZ4)
+	    != (opt.zip_algorithm == PAGE_ZIP_LZ4)) {
 		return(true);
 	}
 
@@ -81,7 +81,6 @@ class PageBulk
 		m_modify_clock(0),
 		m_err(DB_SUCCESS)
 	{
-		ut_ad(!dict_index_is_spatial(m_index));
 		ut_ad(!m_index->table->is_temporary());
 	}
 
@@ -178,6 +177,16 @@ class PageBulk
 	@return true	if space is available */
 	inline bool isSpaceAvailable(ulint	rec_size);
 
+	/** Check if required space would be available in the page for
+	a record to be inserted after some records. We check fill factor
+	& padding here.
+	@param[in]	rec_no		number of records in the page
+	@param[in]	free_space	free space left in the page
+	@param[in]	rec_size	required length
+	@return true	if space is available */
+	bool isSpaceAvailable(ulint rec_no, ulint free_space,
+			      ulint rec_size) const;
+
 	/** Get page no */
 	uint32_t getPageNo() const { return m_page_no; }
 
@@ -290,7 +299,14 @@ class BtrBulk
 		m_index(index),
 		m_trx(trx)
 	{
-		ut_ad(!dict_index_is_spatial(index));
+	}
+
+	/** Destructor */
+	~BtrBulk()
+	{
+		for (rtr_batch& batch : m_rtr_batches) {
+			mem_heap_free(batch.heap);
+		}
 	}
 
 	/** Insert a tuple
@@ -316,6 +332,9 @@ class BtrBulk
 
 	table_name_t table_name() { return m_index->table->name; }
 
+	/** @return the index that is being loaded */
+	dict_index_t* index() const { return m_index; }
+
 private:
 	/** Insert a tuple to a page in a level
 	@param[in]	tuple	tuple to insert
@@ -323,6 +342,32 @@ class BtrBulk
 	@return error code */
 	dberr_t insert(dtuple_t* tuple, ulint level);
 
+	/** Insert a tuple to the current page in a level
+	@param[in]	tuple		tuple to insert
+	@param[in]	level		B-tree level
+	@param[in]	is_left_most	whether the tuple is the first one
+					of the level
+	@param[in]	new_page	whether to start a new page unless
+					the current page is empty
+	@return error code */
+	dberr_t insertTuple(dtuple_t* tuple, ulint level,
+			    bool is_left_most, bool new_page);
+
+	/** Buffer a tuple of a SPATIAL INDEX. The records of an R-tree
+	page must be in ascending order, but the tuples arrive in the
+	order of the bulk load. We collect a page worth of tuples in each
+	level and write them to a page of their own in rtrFlush().
+	@param[in]	tuple	tuple to insert
+	@param[in]	level	R-tree level
+	@return error code */
+	dberr_t rtrInsert(dtuple_t* tuple, ulint level);
+
+	/** Sort the tuples that were buffered by rtrInsert() and
+	write them to a new page.
+	@param[in]	level	R-tree level
+	@return error code */
+	dberr_t rtrFlush(ulint level);
+
 	/** Split a page
 	@param[in]	page_bulk	page to split
 	@param[in]	next_page_bulk	next page
@@ -366,6 +411,21 @@ class BtrBulk
 
 	/** Page cursor vector for all level */
 	page_bulk_vector	m_page_bulks;
+
+	/** Tuples of a SPATIAL INDEX level that have not been written yet */
+	struct rtr_batch
+	{
+		/** memory heap for the tuples */
+		mem_heap_t*		heap;
+		/** the buffered tuples */
+		std::vector<dtuple_t*>	tuples;
+		/** free space that would be left on an empty page
+		after inserting the tuples */
+		ulint			free_space;
+	};
+
+	/** Buffered tuples of each level of a SPATIAL INDEX */
+	std::vector<rtr_batch>	m_rtr_batches;
 };
 
 #endif
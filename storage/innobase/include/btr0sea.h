@@ -31,6 +31,7 @@ Created 2/17/1996 Heikki Tuuri
 #ifdef BTR_CUR_HASH_ADAPT
 #include "ha0ha.h"
 #include "srw_lock.h"
+#include <thread>
 
 #ifdef UNIV_PFS_RWLOCK
 extern mysql_pfs_key_t btr_search_latch_key;
@@ -246,6 +247,15 @@ struct btr_search_sys_t
     hash_table_t table;
     /** memory heap for table */
     mem_heap_t *heap;
+    /** nodes that were removed from table, for reuse by inserts;
+    their memory is freed by ha_free_nodes() when no lookups that
+    do not hold latch are in progress, or in clear() */
+    ha_node_t *free_nodes;
+    /** length of free_nodes */
+    ulint n_free;
+    /** sequence number for lookups that do not hold latch;
+    odd while table is being modified or the partition is disabled */
+    std::atomic<uint32_t> seq;
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -254,7 +264,8 @@ struct btr_search_sys_t
 #endif
 
     char pad[(CPU_LEVEL1_DCACHE_LINESIZE - sizeof latch -
-              sizeof table - sizeof heap) &
+              sizeof table - sizeof heap - sizeof free_nodes -
+              sizeof n_free - sizeof seq) &
              (CPU_LEVEL1_DCACHE_LINESIZE - 1)];
 
 #ifdef _MSC_VER
@@ -265,6 +276,35 @@ struct btr_search_sys_t
     {
       memset((void*) this, 0, sizeof *this);
       latch.SRW_LOCK_INIT(btr_search_latch_key);
+      seq.store(1, std::memory_order_relaxed);
+    }
+
+    /** Start modifying table while holding exclusive latch.
+    Lookups that do not hold latch will retry or fall back to
+    acquiring latch until write_end(). */
+    void write_begin()
+    {
+      const uint32_t s= seq.load(std::memory_order_relaxed);
+      ut_ad(!(s & 1));
+      seq.store(s + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    /** Finish modifying table, or enable the partition */
+    void write_end()
+    {
+      const uint32_t s= seq.load(std::memory_order_relaxed);
+      ut_ad(s & 1);
+      seq.store(s + 1, std::memory_order_release);
+    }
+
+    /** Check if the partition was not modified since a lookup started.
+    @param s  the value of seq at the start of the lookup
+    @return whether the data that was read since then is consistent */
+    bool validate(uint32_t s) const
+    {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return seq.load(std::memory_order_relaxed) == s;
     }
 
     void alloc(ulint hash_size)
@@ -275,12 +315,15 @@ struct btr_search_sys_t
                                                   - MEM_BLOCK_HEADER_SIZE
                                                   - MEM_SPACE_NEEDED(0)),
                                   MEM_HEAP_FOR_BTR_SEARCH);
+      write_end();
     }
 
     void clear()
     {
       mem_heap_free(heap);
       heap= nullptr;
+      free_nodes= nullptr;
+      n_free= 0;
       ut_free(table.array);
     }
 
@@ -295,6 +338,52 @@ struct btr_search_sys_t
   /** Partitions of the adaptive hash index */
   partition *parts;
 
+  /** Number of lookups that do not hold partition::latch,
+  distributed over cache lines to avoid contention */
+  struct alignas(CPU_LEVEL1_DCACHE_LINESIZE) reader_slot
+  {
+    std::atomic<uint32_t> n;
+  };
+
+  /** Number of reader slots */
+  static constexpr size_t N_READER_SLOTS= 64;
+
+  /** Lookups that do not hold partition::latch.
+  btr_search_disable() waits for these before freeing any memory. */
+  reader_slot readers[N_READER_SLOTS];
+
+  /** Registration of a lookup that does not hold partition::latch */
+  class reader_guard
+  {
+    std::atomic<uint32_t> &n;
+  public:
+    reader_guard(reader_slot &slot) : n(slot.n) { n.fetch_add(1); }
+    ~reader_guard() { n.fetch_sub(1, std::memory_order_release); }
+  };
+
+  /** Check if no lookups that do not hold partition::latch are in
+  progress. Invoked after partition::write_begin(), which prevents new
+  lookups from accessing the partition.
+  @return whether no such lookups are in progress */
+  bool readers_idle() const
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (const reader_slot &slot : readers)
+      if (slot.n.load())
+        return false;
+    return true;
+  }
+
+  /** Wait for all lookups that do not hold partition::latch to finish.
+  Invoked by btr_search_disable() after partition::write_begin(). */
+  void wait_for_readers()
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (const reader_slot &slot : readers)
+      while (slot.n.load())
+        std::this_thread::yield();
+  }
+
   /** Get an adaptive hash index partition */
   partition *get_part(index_id_t id, ulint space_id) const
   {
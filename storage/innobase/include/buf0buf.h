@@ -1101,12 +1101,18 @@ struct buf_pool_stat_t{
 	ulint	n_ra_pages_evicted;/*!< number of read ahead
 				pages that are evicted without
 				being accessed */
+	ulint	n_ra_reads;	/*!< number of read requests
+				submitted by read ahead; a request
+				may cover several adjacent pages */
 	ulint	n_pages_made_young; /*!< number of pages made young, in
 				buf_page_make_young() */
 	ulint	n_pages_not_made_young; /*!< number of pages not made
 				young because the first access
 				was not long enough ago, in
 				buf_page_peek_if_too_old() */
+	ulint	n_pages_made_last; /*!< number of pages moved to the
+				end of the LRU list by scans, in
+				buf_LRU_make_last() */
 	/** number of waits for eviction */
 	ulint	LRU_waits;
 	ulint	LRU_bytes;	/*!< LRU size in bytes */
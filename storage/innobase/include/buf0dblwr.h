@@ -51,35 +51,58 @@ class buf_dblwr_t
     byte* write_buf;
     /** buffer blocks to be written via write_buf */
     element* buf_block_arr;
+    /** the doublewrite area that the batch is being written to,
+    or NOT_RUNNING */
+    ulint area;
+    /** number of expected flush_buffered_writes_completed() calls */
+    unsigned flushing_buffered_writes;
   };
 
+  /** slot::area of a slot that is not being written */
+  static constexpr ulint NOT_RUNNING= ULINT_UNDEFINED;
+
   /** the page number of the first doublewrite block (block_size() pages) */
   page_id_t block1{0, 0};
   /** the page number of the second doublewrite block (block_size() pages) */
   page_id_t block2{0, 0};
 
+public:
+  /** Maximum value of innodb_doublewrite_batches */
+  static constexpr ulint MAX_BATCHES= 8;
+
+private:
   /** mutex protecting the data members below */
   mysql_mutex_t mutex;
-  /** condition variable for !batch_running */
+  /** condition variable for n_running changes */
   pthread_cond_t cond;
-  /** whether a batch is being written from the doublewrite buffer */
-  bool batch_running;
-  /** number of expected flush_buffered_writes_completed() calls */
-  unsigned flushing_buffered_writes;
+  /** number of doublewrite areas (innodb_doublewrite_batches) */
+  ulint n_batches;
+  /** number of batches that are being written */
+  ulint n_running;
   /** number of flush_buffered_writes_completed() calls */
   ulint writes_completed;
   /** number of pages written by flush_buffered_writes_completed() */
   ulint pages_written;
 
-  slot slots[2];
+  /** One slot more than n_batches, so that a batch can be collected
+  while n_batches are being written. */
+  slot slots[MAX_BATCHES + 1];
   slot *active_slot;
 
+  /** @return the capacity of a batch, in pages */
+  ulint batch_size() const { return 2 * block_size() / n_batches; }
+
   /** Initialise the persistent storage of the doublewrite buffer.
   @param header   doublewrite page header in the TRX_SYS page */
   inline void init(const byte *header);
 
+  /** Write the pages of a batch to the doublewrite area.
+  @param s        slot that was filled
+  @param area     doublewrite area to write to */
+  inline void write_batch(slot *s, ulint area);
+
   /** Flush possible buffered writes to persistent storage. */
-  bool flush_buffered_writes(const ulint size);
+  bool flush_buffered_writes_low();
 
 public:
   /** Initialise the doublewrite buffer data structures. */
@@ -114,8 +137,9 @@ class buf_dblwr_t
   /** Process and remove the double write buffer pages for all tablespaces. */
   void recover();
 
-  /** Update the doublewrite buffer on data page write completion. */
-  void write_completed();
+  /** Update the doublewrite buffer on data page write completion.
+  @param request  the completed page write request */
+  void write_completed(const IORequest &request);
   /** Flush possible buffered writes to persistent storage.
   It is very important to call this function after a batch of writes has been
   posted, and also when we may have to wait for a page latch!
@@ -154,7 +178,7 @@ class buf_dblwr_t
   void wait_flush_buffered_writes()
   {
     mysql_mutex_lock(&mutex);
-    while (batch_running)
+    while (n_running)
       my_cond_wait(&cond, &mutex.m_mutex);
     mysql_mutex_unlock(&mutex);
   }
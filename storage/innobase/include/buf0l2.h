@@ -0,0 +1,156 @@
+/*****************************************************************************
+
+Copyright (c) 2026, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/buf0l2.h
+Second-level page cache on a local file
+
+Clean pages that are evicted from the buffer pool are copied to a file
+on a fast local device (innodb_buffer_pool_l2_file), from where a later
+read of the page can be served instead of reading the data file.
+
+The cache is exclusive: a page is either in the buffer pool or in the
+second-level cache. An entry is removed when the page is read back,
+and it is replaced when the page is evicted again. Therefore, there is
+no need to invalidate entries when a page is modified in the buffer pool.
+
+Only synchronous reads are served from the cache. Asynchronous reads
+(read-ahead or prefetch) must not wait for the cache file, and they read
+the data file, which contains the same copy of a clean page.
+*******************************************************/
+
+#pragma once
+
+#include "buf0types.h"
+#include "os0file.h"
+#include <unordered_map>
+#include <vector>
+
+struct fil_space_t;
+
+/** Second-level page cache */
+class buf_l2_t
+{
+  /** A page-sized slot in the cache file */
+  struct slot_t
+  {
+    /** page_id_t::raw() of the cached page, or EMPTY */
+    uint64_t id;
+    /** copy of the page that is being written, or nullptr */
+    byte *pending;
+    /** whether a read from the slot is in progress */
+    bool reading;
+
+    bool busy() const { return pending || reading; }
+  };
+
+  /** value of slot_t::id for an unused slot */
+  static constexpr uint64_t EMPTY= ~uint64_t{0};
+
+  /** maximum number of pending writes */
+  static constexpr size_t N_WRITE_BUFS= 64;
+
+  /** protects all the fields */
+  mysql_mutex_t mutex;
+  /** the cache file */
+  pfs_os_file_t file= OS_FILE_CLOSED;
+  /** the slots; empty if the cache is disabled */
+  std::vector<slot_t> slots;
+  /** mapping from page_id_t::raw() to the index of slots[] */
+  std::unordered_map<uint64_t, size_t> map;
+  /** the next slot to be replaced */
+  size_t hand= 0;
+  /** write_buf_mem divided into page-sized buffers that are not in use */
+  std::vector<byte*> free_bufs;
+  /** memory for the page copies of pending writes */
+  byte *write_buf_mem= nullptr;
+  /** pending writes (indexes of slots[]) */
+  std::vector<size_t> write_queue;
+  /** whether the write task has been submitted */
+  bool writing= false;
+
+  /** Remove the mapping of a slot.
+  @param s  slot whose page is no longer cached */
+  void remove(slot_t &s)
+  {
+    mysql_mutex_assert_owner(&mutex);
+    ut_ad(s.id != EMPTY);
+    map.erase(s.id);
+    s.id= EMPTY;
+  }
+
+  /** Write the pending pages to the cache file. */
+  void write_pending();
+
+public:
+  /** Write the pending pages to the cache file. */
+  static void write_task(void *);
+
+  /** Statistics for SHOW STATUS */
+  struct stat_t
+  {
+    /** number of page reads that were served from the cache */
+    ulint n_hits;
+    /** number of pages that were written to the cache */
+    ulint n_writes;
+    /** number of evicted pages that could not be cached */
+    ulint n_dropped;
+  } stat;
+
+  /** Open the cache file, if innodb_buffer_pool_l2_file is set.
+  If the file cannot be created, the cache will be disabled. */
+  void create();
+  /** Wait for pending writes and close the cache file. */
+  void close();
+
+  /** @return whether the cache is enabled */
+  bool enabled() const { return !slots.empty(); }
+
+  /** Note that a page is being evicted from the buffer pool.
+  If the page is clean, copy it to the cache. Otherwise,
+  remove any copy of the page.
+  The caller must hold buf_pool.mutex and the page_hash latch.
+  @param bpage  page that is being evicted */
+  void evict(const buf_page_t &bpage);
+
+  /** Read a page from the cache and remove it from the cache.
+  @param id     page identifier
+  @param space  tablespace
+  @param frame  page frame to read to
+  @return whether the page was found and is not corrupted */
+  bool read(const page_id_t id, const fil_space_t &space, byte *frame);
+
+  /** Remove a page that is being reinitialized or read from the
+  data file from the cache.
+  @param id  page identifier */
+  void invalidate(const page_id_t id);
+
+  /** Remove all pages of a tablespace from the cache.
+  @param space_id  tablespace identifier */
+  void invalidate(uint32_t space_id);
+
+  /** Determine if pages of a tablespace may be cached.
+  The in-memory frame must be identical to the page in the data file,
+  which rules out encrypted and compressed tablespaces.
+  @param space  tablespace
+  @return whether the pages of the tablespace may be cached */
+  static bool eligible(const fil_space_t &space);
+};
+
+/** The second-level page cache */
+extern buf_l2_t buf_l2;
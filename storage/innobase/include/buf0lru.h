@@ -129,6 +129,12 @@ if it is too old.
 @param bpage  buffer pool page
 @return whether this is not the first access */
 bool buf_page_make_young_if_needed(buf_page_t *bpage);
+/** Move a page that a scan in the scan-resistant mode
+(innodb_scan_resistant_pct) has passed to the end of buf_pool.LRU,
+so that it will be replaced first, like in a small ring of buffers.
+Pages in the young part of the LRU list are not moved.
+@param id  page identifier */
+void buf_LRU_make_last(const page_id_t id);
 
 /******************************************************************//**
 Adds a block to the LRU list of decompressed zip pages. */
@@ -28,6 +28,22 @@ Created 11/5/1995 Heikki Tuuri
 
 #include "buf0buf.h"
 
+/** A read-ahead request that covers several adjacent pages
+(IORequest::READ_BATCH) */
+struct buf_read_batch_t
+{
+  /** buffer for the contents of all pages */
+  byte *buf;
+  /** number of pages */
+  uint32_t n;
+  /** the read-fixed pages, in ascending order of page number */
+  buf_page_t *bpage[buf_pool_t::READ_AHEAD_PAGES];
+
+  /** @return the contents of the i-th page in buf */
+  const byte *page(uint32_t i) const
+  { ut_ad(i < n); return buf + (size_t{i} << srv_page_size_shift); }
+};
+
 /** High-level function which reads a page asynchronously from a file to the
 buffer buf_pool if it is not already there. Sets the io_fix flag and sets
 an exclusive lock on the buffer frame. The flag is cleared and the x-lock
@@ -55,6 +71,18 @@ void buf_read_page_background(fil_space_t *space, const page_id_t page_id,
                               ulint zip_size)
   MY_ATTRIBUTE((nonnull));
 
+/** Read a range of pages asynchronously for buffer pool load.
+Runs of adjacent pages that are not in buf_pool are read with a
+single request, like in read-ahead.
+@param space  tablespace; will be released
+@param low    first page to read
+@param high   end of the range (excluded), at most
+              buf_pool_t::READ_AHEAD_PAGES pages after low
+@return number of pages whose read was initiated */
+ulint buf_read_pages_background(fil_space_t *space, const page_id_t low,
+                                const page_id_t high)
+  MY_ATTRIBUTE((nonnull));
+
 /** Applies a random read-ahead in buf_pool if there are at least a threshold
 value of accessed pages from the random read-ahead area. Does not read any
 page, not even the one at the position (space, offset), if the read-ahead
@@ -98,3 +126,12 @@ ulint buf_read_ahead_linear(const page_id_t page_id, ulint zip_size);
 @param init_lsn page initialization, or 0 if the page needs to be read */
 void buf_read_recover(fil_space_t *space, const page_id_t page_id,
                       page_recv_t &recs, lsn_t init_lsn);
+
+/** Read pages for recovery. The log records will be applied to the pages
+in buf_page_t::read_complete().
+@param space    tablespace
+@param page_id  first page to read
+@param n        number of adjacent pages to read
+@return number of submitted read requests */
+size_t buf_read_recover_pages(fil_space_t *space, page_id_t page_id,
+                              uint32_t n);
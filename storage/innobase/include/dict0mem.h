@@ -243,7 +243,7 @@ ROW_FORMAT=REDUNDANT.  InnoDB engines do not check these flags
 for unknown bits in order to protect backward incompatibility. */
 /* @{ */
 /** Total number of bits in table->flags2. */
-#define DICT_TF2_BITS			7
+#define DICT_TF2_BITS			8
 #define DICT_TF2_UNUSED_BIT_MASK	(~0U << DICT_TF2_BITS)
 #define DICT_TF2_BIT_MASK		~DICT_TF2_UNUSED_BIT_MASK
 
@@ -272,6 +272,10 @@ constexpr unsigned DICT_TF2_DISCARDED= 1U << DICT_TF2_POS_DISCARDED;
 index tables) of a FTS table are in HEX format. */
 #define DICT_TF2_FTS_AUX_HEX_NAME	64U
 
+/** The ROW_FORMAT=COMPRESSED index pages are compressed with LZ4
+(ZIP_ALGORITHM=LZ4) */
+#define DICT_TF2_ZIP_LZ4		128U
+
 /* @} */
 
 #define DICT_TF2_FLAG_SET(table, flag)		\
@@ -2334,6 +2338,15 @@ struct dict_table_t {
   Atomic_counter<uint64_t> row_id{0};
   /** Autoinc counter value to give to the next inserted row. */
   uint64_t autoinc;
+  /** Lowest first value of the AUTO_INCREMENT ranges that table handles
+  have reserved with innodb_autoinc_prefetch since the last change of
+  autoinc_range_version, or 0 if none. Written under autoinc_mutex. */
+  Atomic_relaxed<uint64_t> autoinc_range_low;
+  /** Incremented when a value at or above autoinc_range_low and below
+  autoinc is specified explicitly. A reserved range is discarded when
+  this differs from row_prebuilt_t::autoinc_range_version.
+  Written under autoinc_mutex. */
+  Atomic_relaxed<uint32_t> autoinc_range_version;
 
   /** The transaction that currently holds the the AUTOINC lock on this table.
   Protected by lock_mutex.
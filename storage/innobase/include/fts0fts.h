@@ -520,6 +520,8 @@ fts_commit(
 @param[in]	query_str	FTS query
 @param[in]	query_len	FTS query string len in bytes
 @param[in,out]	result		result doc ids
+@param[in]	limit		number of most relevant documents that
+				are needed, or ULINT_UNDEFINED
 @return DB_SUCCESS if successful otherwise error code */
 dberr_t
 fts_query(
@@ -528,7 +530,8 @@ fts_query(
 	uint		flags,
 	const byte*	query_str,
 	ulint		query_len,
-	fts_result_t**	result)
+	fts_result_t**	result,
+	ulint		limit = ULINT_UNDEFINED)
 	MY_ATTRIBUTE((warn_unused_result));
 
 /******************************************************************//**
@@ -119,4 +119,11 @@ split_rtree_node(
 @retval 0 if the predicate holds
 @retval 1 if the precidate does not hold */
 int rtree_key_cmp(page_cur_mode_t mode, const void *b, const void *a);
+
+/** Compute the position of the centre of a minimum bounding rectangle
+on a Hilbert curve. Sorting by this value keeps nearby objects together,
+which is how the R-tree bulk load packs its pages.
+@param mbr  minimum bounding rectangle: xmin, xmax, ymin, ymax
+@return position on the Hilbert curve */
+uint64_t rtree_hilbert_value(const double *mbr);
 #endif
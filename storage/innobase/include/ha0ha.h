@@ -31,6 +31,7 @@ Created 8/18/1994 Heikki Tuuri
 #include "page0types.h"
 #include "buf0types.h"
 #include "rem0types.h"
+#include "my_atomic_wrapper.h"
 
 #ifdef BTR_CUR_HASH_ADAPT
 /*************************************************************//**
@@ -44,14 +45,20 @@ ha_search_and_get_data(
 	hash_table_t*	table,	/*!< in: hash table */
 	ulint		fold);	/*!< in: folded value of the searched data */
 
-/** The hash table external chain node */
+/** The hash table external chain node. The fields other than block
+may be read by btr_search_guess_on_hash() without holding the partition
+latch, concurrently with modifications. */
 struct ha_node_t {
-	ulint		fold;	/*!< fold value for the data */
-	ha_node_t*	next;	/*!< next chain node or NULL if none */
+	/** fold value for the data */
+	Atomic_relaxed<ulint>		fold;
+	/** next chain node or NULL if none */
+	Atomic_relaxed<ha_node_t*>	next;
 #if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
 	buf_block_t*	block;	/*!< buffer block containing the data, or NULL */
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
-	const rec_t*	data;	/*!< pointer to the data */
+	/** pointer to the data, or NULL if the node is in
+	btr_search_sys_t::partition::free_nodes */
+	Atomic_relaxed<const rec_t*>	data;
 };
 
 #include "ha0ha.inl"
@@ -231,6 +231,12 @@ innobase_get_at_most_n_mbchars(
 @retval NULL if innodb_tmpdir="" */
 const char *thd_innodb_tmpdir(THD *thd);
 
+/** Get the value of innodb_ddl_threads.
+@param[in]	thd	thread handle, or NULL to query
+			the global innodb_ddl_threads.
+@return number of threads for creating secondary indexes */
+uint thd_ddl_threads(THD *thd);
+
 /******************************************************************//**
 Returns the lock wait timeout for the current connection.
 @return the lock wait timeout, in seconds */
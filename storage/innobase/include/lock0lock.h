@@ -46,6 +46,19 @@ extern my_bool innodb_deadlock_detect;
 /** The value of innodb_deadlock_report */
 extern ulong innodb_deadlock_report;
 
+/** The allowed values of innodb_lock_grant_policy */
+enum lock_grant_policy
+{
+  /** grant waiting record locks in the order of the lock queue */
+  LOCK_GRANT_FCFS,
+  /** grant waiting record locks first to the transactions that
+  are blocking the most other transactions (Contention-Aware
+  Transaction Scheduling) */
+  LOCK_GRANT_CATS
+};
+/** The value of innodb_lock_grant_policy */
+extern ulong innodb_lock_grant_policy;
+
 namespace Deadlock
 {
   /** The allowed values of innodb_deadlock_report */
@@ -758,6 +771,13 @@ class lock_sys_t
   uint64_t wait_time;
   /** Longest wait time; protected by wait_mutex */
   uint64_t wait_time_max;
+public:
+  /** Number of buckets in the lock wait time histogram */
+  static constexpr unsigned WAIT_HISTOGRAM_SIZE= 5;
+private:
+  /** Number of record lock waits by duration: less than 10ms, 100ms, 1s,
+  10s, and longer; protected by wait_mutex */
+  uint64_t wait_histogram[WAIT_HISTOGRAM_SIZE];
 public:
   /** number of deadlocks detected; protected by wait_mutex */
   ulint deadlocks;
@@ -902,8 +922,14 @@ class lock_sys_t
   /** Note that a record lock wait started */
   inline void wait_start();
 
-  /** Note that a record lock wait resumed */
-  inline void wait_resume(THD *thd, my_hrtime_t start, my_hrtime_t now);
+  /** Note that a record lock wait resumed
+  @param thd       connection that was waiting
+  @param start     start time of the wait
+  @param now       current time
+  @param rec_lock  whether a record lock (not a table lock) was waited for,
+                   so that the wait is counted in the wait time histogram */
+  inline void wait_resume(THD *thd, my_hrtime_t start, my_hrtime_t now,
+                          bool rec_lock);
 
   /** @return pending number of lock waits */
   ulint get_wait_pending() const
@@ -917,6 +943,10 @@ class lock_sys_t
   uint64_t get_wait_time_cumulative() const { return wait_time; }
   /** Longest wait time; protected by wait_mutex */
   uint64_t get_wait_time_max() const { return wait_time_max; }
+  /** Number of lock waits in a bucket of the wait time histogram;
+  protected by wait_mutex */
+  uint64_t get_wait_histogram(unsigned i) const
+  { ut_ad(i < WAIT_HISTOGRAM_SIZE); return wait_histogram[i]; }
 
   /** Get the lock hash table for a mode */
   hash_table &hash_get(ulint mode)
@@ -36,6 +36,11 @@ Created 9/20/1997 Heikki Tuuri
 
 /** @return whether recovery is currently running. */
 #define recv_recovery_is_on() UNIV_UNLIKELY(recv_sys.recovery_on)
+/** @return whether log may have to be applied to pages that are read
+into the buffer pool (recovery is running, or recv_sys_t::apply_online()
+has not finished yet) */
+#define recv_recovery_is_pending() \
+  UNIV_UNLIKELY(recv_sys.recovery_on || recv_sys.online)
 
 ATTRIBUTE_COLD MY_ATTRIBUTE((nonnull, warn_unused_result))
 /** Apply any buffered redo log to a page.
@@ -207,6 +212,10 @@ struct recv_sys_t
   /** whether recv_recover_page(), invoked from buf_page_t::read_complete(),
   should apply log records*/
   bool apply_log_recs;
+  /** whether apply_online() is applying the last batch in the background */
+  Atomic_relaxed<bool> online;
+  /** signalled when online is reset; protected by mutex */
+  pthread_cond_t online_cond;
   /** number of bytes in log_sys.buf */
   size_t len;
   /** start offset of non-parsed log records in log_sys.buf */
@@ -219,6 +228,21 @@ struct recv_sys_t
   lsn_t file_checkpoint;
   /** the time when progress was last reported */
   time_t progress_time;
+  /** durations of the recovery phases, reported at the end of recovery */
+  struct
+  {
+    /** time spent parsing the log, in nanoseconds */
+    ulonglong parse_time;
+    /** time spent in apply(), in nanoseconds */
+    ulonglong apply_time;
+    /** time spent applying log records to pages, summed over all
+    threads, in nanoseconds */
+    Atomic_counter<ulonglong> page_time;
+    /** number of read requests submitted by apply() */
+    size_t reads;
+    /** number of pages read by apply() */
+    size_t pages_read;
+  } stats;
 
   using map = std::map<const page_id_t, page_recv_t,
                        std::less<const page_id_t>,
@@ -322,6 +346,29 @@ struct recv_sys_t
   @param last_batch     whether it is possible to write more redo log */
   void apply(bool last_batch);
 
+  /** Start applying the last batch in the background, so that the server
+  can accept connections while the log is being applied
+  (innodb_recovery_online=ON). Pages that are accessed in the meantime
+  will be recovered in buf_page_t::read_complete().
+  @return whether the background task was started */
+  bool apply_online();
+  /** Wait for apply_online() to finish. */
+  void wait_online();
+  /** Apply any remaining log, or wait for apply_online() to finish. */
+  void apply_all();
+  /** Discard the log for a page that buf_page_create() reinitialized
+  while apply_online() is in progress.
+  @param page_id  page identifier */
+  void discard(page_id_t page_id);
+  /** Claim the log of a page that is being read while apply_online() is
+  in progress, if the log initializes the page so that the contents of the
+  data file must not be read or validated.
+  @param page_id  page that the caller has just read-fixed
+  @param recs     the log records to apply
+  @return the page initialization LSN
+  @retval 0 if the page must be read from the data file */
+  lsn_t claim_init(page_id_t page_id, page_recv_t *&recs);
+
 #ifdef UNIV_DEBUG
   /** whether all redo log in the current batch has been applied */
   bool after_apply= false;
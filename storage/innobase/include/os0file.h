@@ -52,6 +52,7 @@ extern bool	os_has_said_disk_full;
 typedef ib_uint64_t os_offset_t;
 
 class buf_tmp_buffer_t;
+struct buf_read_batch_t;
 
 #ifdef _WIN32
 
@@ -183,11 +184,13 @@ class IORequest
     READ_MAYBE_PARTIAL= READ_SYNC | 4,
     /** Read for doublewrite buffer recovery */
     DBLWR_RECOVER= READ_SYNC | 8,
+    /** Asynchronous read of adjacent pages into read_batch */
+    READ_BATCH= READ_ASYNC | 256,
     /** Synchronous write */
     WRITE_SYNC= 16,
     /** Asynchronous write */
     WRITE_ASYNC= WRITE_SYNC | 1,
-    /** A doublewrite batch */
+    /** A doublewrite batch; see dblwr_batch */
     DBLWR_BATCH= WRITE_ASYNC | 8,
     /** Write data; evict the block on write completion */
     WRITE_LRU= WRITE_ASYNC | 32,
@@ -200,13 +203,23 @@ class IORequest
   };
 
   constexpr IORequest(buf_page_t *bpage, buf_tmp_buffer_t *slot,
-                      fil_node_t *node, Type type) :
-    bpage(bpage), slot(slot), node(node), type(type) {}
+                      fil_node_t *node, Type type,
+                      uint8_t dblwr_batch= 0) :
+    bpage(bpage), slot(slot), node(node), type(type),
+    dblwr_batch(dblwr_batch) {}
 
   constexpr IORequest(Type type= READ_SYNC, buf_page_t *bpage= nullptr,
                       buf_tmp_buffer_t *slot= nullptr) :
     bpage(bpage), slot(slot), type(type) {}
 
+  /** Create a READ_BATCH request.
+  @param bpage  the first page of the batch
+  @param batch  the pages to read
+  @param node   data file, or nullptr */
+  constexpr IORequest(buf_page_t *bpage, buf_read_batch_t *batch,
+                      fil_node_t *node= nullptr) :
+    bpage(bpage), read_batch(batch), node(node), type(READ_BATCH) {}
+
   bool is_read() const { return (type & READ_SYNC) != 0; }
   bool is_write() const { return (type & WRITE_SYNC) != 0; }
   bool is_LRU() const { return (type & (WRITE_LRU ^ WRITE_ASYNC)) != 0; }
@@ -238,14 +251,23 @@ class IORequest
   /** Page to be written on write operation */
   buf_page_t *const bpage= nullptr;
 
-  /** Memory to be used for encrypted or page_compressed pages */
-  buf_tmp_buffer_t *const slot= nullptr;
+  union
+  {
+    /** Memory to be used for encrypted or page_compressed pages */
+    buf_tmp_buffer_t *const slot;
+    /** The pages of a READ_BATCH request */
+    buf_read_batch_t *const read_batch;
+  };
 
   /** File descriptor */
   fil_node_t *const node= nullptr;
 
   /** Request type bit flags */
   const Type type;
+
+  /** 1 + the buf_dblwr_t batch of a DBLWR_BATCH request, or of a page
+  write that was submitted from the batch; 0 if none */
+  const uint8_t dblwr_batch= 0;
 };
 
 constexpr IORequest IORequestRead(IORequest::READ_SYNC);
@@ -1073,6 +1095,10 @@ void os_aio_wait_until_no_pending_writes(bool declare);
 @param declare  whether the wait will be declared in tpool */
 void os_aio_wait_until_no_pending_reads(bool declare);
 
+/** Wait until fewer than n asynchronous reads are pending.
+@param n  maximum number of pending reads, plus 1 */
+void os_aio_wait_until_pending_reads_below(size_t n);
+
 /** Prints info of the aio arrays.
 @param[in/out]	file		file where to print */
 void
@@ -43,6 +43,18 @@ extern uint	page_zip_level;
 
 /* Default compression level. */
 #define DEFAULT_COMPRESSION_LEVEL	6
+
+/** Compression algorithm of ROW_FORMAT=COMPRESSED index pages
+(table option ZIP_ALGORITHM) */
+enum page_zip_algorithm
+{
+  /** not specified; PAGE_ZIP_ZLIB for ROW_FORMAT=COMPRESSED */
+  PAGE_ZIP_DEFAULT= 0,
+  /** zlib deflate(), with a compression level of page_zip_level */
+  PAGE_ZIP_ZLIB,
+  /** LZ4 from the provider_lz4 plugin (DICT_TF2_ZIP_LZ4) */
+  PAGE_ZIP_LZ4
+};
 /** Start offset of the area that will be compressed */
 #define PAGE_ZIP_START			PAGE_NEW_SUPREMUM_END
 /** Size of an compressed page directory entry */
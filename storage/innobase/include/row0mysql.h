@@ -510,6 +510,10 @@ struct row_prebuilt_t {
 					(VARCHAR can be off-page too) */
 	unsigned	versioned_write:1;/*!< whether this is
 					a versioned write */
+	unsigned	scan_resistant:1;/*!< whether the leaf pages that
+					a full index scan has passed are
+					moved to the end of buf_pool.LRU
+					(innodb_scan_resistant_pct) */
 	mysql_row_templ_t* mysql_template;/*!< template used to transform
 					rows fast between MySQL and Innobase
 					formats; memory for this template
@@ -656,6 +660,22 @@ struct row_prebuilt_t {
 					autoinc value from the table. We
 					store it here so that we can return
 					it to MySQL */
+	ulonglong	autoinc_range_next;
+					/*!< next value of the AUTO-INC range
+					that was reserved for this handle
+					(innodb_autoinc_prefetch) */
+	ulonglong	autoinc_range_end;
+					/*!< table AUTO-INC counter value after
+					the reservation of the range */
+	ulonglong	autoinc_range_n;/*!< number of values remaining
+					in the reserved range */
+	ulonglong	autoinc_range_increment;
+					/*!< increment of the reserved range */
+	ulonglong	autoinc_range_offset;
+					/*!< offset of the reserved range */
+	uint32_t	autoinc_range_version;
+					/*!< dict_table_t::autoinc_range_version
+					when the range was reserved */
 	/*----------------------*/
 
 	/** Argument of handler_rowid_filter_check(),
@@ -666,7 +686,12 @@ struct row_prebuilt_t {
 	or NULL if no index condition pushdown (ICP) is used. */
 	ha_innobase*	idx_cond;
 	ulint		idx_cond_n_cols;/*!< Number of fields in idx_cond_cols.
-					0 if and only if idx_cond == NULL. */
+					0 if and only if idx_cond == NULL
+					and scan_filter == NULL. */
+
+	/** Argument to handler_scan_filter_check(),
+	or NULL if no filter is pushed into a table scan */
+	ha_innobase*	scan_filter;
 	/*----------------------*/
 
 	/*----------------------*/
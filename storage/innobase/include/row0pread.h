@@ -0,0 +1,153 @@
+/*****************************************************************************
+
+Copyright (c) 2026, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/row0pread.h
+Parallel read of the clustered index in key ranges
+*******************************************************/
+
+#pragma once
+
+#include "data0types.h"
+#include "dict0types.h"
+#include "rem0types.h"
+#include "trx0types.h"
+#include "srv0srv.h"
+#include <atomic>
+#include <vector>
+
+class ReadView;
+
+/** Invoke a function in several threads. The calling thread is one of
+the threads.
+@tparam Fn        void(ulint thread)
+@param n_threads  number of threads
+@param fn         function to invoke with the thread number
+                  0 (the calling thread) to n_threads - 1 */
+template<typename Fn>
+void row_pread_run(ulint n_threads, Fn &&fn)
+{
+  struct thread_t
+  {
+    Fn *fn;
+    ulint n;
+    static void run(void *arg)
+    {
+      const thread_t *t= static_cast<const thread_t*>(arg);
+      (*t->fn)(t->n);
+    }
+  };
+
+  std::vector<thread_t> threads(n_threads - 1);
+  std::vector<tpool::waitable_task*> tasks;
+  tasks.reserve(n_threads - 1);
+
+  for (ulint i= 0; i < n_threads - 1; i++)
+  {
+    threads[i]= {&fn, i + 1};
+    tasks.push_back(new tpool::waitable_task(thread_t::run, &threads[i]));
+    srv_thread_pool->submit_task(tasks.back());
+  }
+
+  fn(0);
+
+  for (tpool::waitable_task *task : tasks)
+  {
+    task->wait();
+    delete task;
+  }
+}
+
+/** Processor of the records of a parallel scan */
+class row_pread_visitor_t
+{
+public:
+  virtual ~row_pread_visitor_t()= default;
+
+  /** Process a record.
+  @param rec      clustered index record, or an old version of it
+  @param offsets  rec_get_offsets(rec)
+  @param heap     memory heap that will be emptied after the call
+  @return error code */
+  virtual dberr_t visit(const rec_t *rec, const rec_offs *offsets,
+                        mem_heap_t *heap)= 0;
+};
+
+/** Parallel reader of the clustered index. The index is split into key
+ranges at node pointer records on the upper levels of the B-tree, and
+each range can be scanned by a different thread with its own cursor and
+mini-transaction. Only the records that are visible in the read view are
+passed to row_pread_visitor_t::visit(). */
+class row_pread_t
+{
+  /** the clustered index */
+  dict_index_t *const m_index;
+  /** the transaction, for checking whether it was interrupted */
+  const trx_t *const m_trx;
+  /** the read view, or nullptr to read the latest committed or
+  uncommitted version of each record (READ UNCOMMITTED) */
+  ReadView *const m_view;
+  /** memory heap for m_bounds */
+  mem_heap_t *const m_heap;
+  /** the first keys of the ranges, except the first range */
+  std::vector<const dtuple_t*> m_bounds;
+  /** set when the scan should be stopped */
+  std::atomic<bool> m_abort{false};
+
+public:
+  /** Number of key ranges per thread. Having more ranges than threads
+  evens out the work when some ranges contain more records than others. */
+  static constexpr ulint RANGES_PER_THREAD= 4;
+
+  /** Constructor.
+  @param index  clustered index
+  @param trx    transaction
+  @param view   read view, or nullptr for READ UNCOMMITTED */
+  row_pread_t(dict_index_t *index, const trx_t *trx, ReadView *view);
+  ~row_pread_t();
+
+  /** Split the index into key ranges.
+  @param n  maximum number of ranges
+  @return error code */
+  dberr_t split(ulint n);
+
+  /** @return number of key ranges */
+  size_t n_ranges() const { return m_bounds.size() + 1; }
+
+  /** Request all threads to stop at the next page boundary. */
+  void abort() { m_abort= true; }
+  /** @return whether abort() was called */
+  bool aborted() const { return m_abort; }
+
+  /** Scan a key range.
+  @param range    range number, less than n_ranges()
+  @param visitor  record processor
+  @return error code */
+  dberr_t scan(size_t range, row_pread_visitor_t &visitor);
+};
+
+/** Count the records of the clustered index that are visible in a
+read view, using several threads.
+@param index      clustered index
+@param trx        transaction
+@param view       read view, or nullptr for READ UNCOMMITTED
+@param n_threads  number of threads
+@param n_rows     number of records
+@return error code */
+dberr_t row_pread_count(dict_index_t *index, const trx_t *trx,
+                        ReadView *view, ulint n_threads, ulint *n_rows);
@@ -34,6 +34,7 @@ Created 3/14/1997 Heikki Tuuri
 #include "row0mysql.h"
 #include "mysqld.h"
 #include <queue>
+#include <vector>
 #include <unordered_map>
 
 class MDL_ticket;
@@ -94,6 +95,40 @@ struct purge_node_t
   /** map of table identifiers to table handles and meta-data locks */
   std::unordered_map<table_id_t, std::pair<dict_table_t*,MDL_ticket*>> tables;
 
+  /** A delete-marked row whose purge was deferred */
+  struct del_mark_t
+  {
+    /** row reference */
+    const dtuple_t *ref;
+    /** DB_ROLL_PTR of the undo log record */
+    roll_ptr_t roll_ptr;
+    /** DB_TRX_ID of the undo log record */
+    trx_id_t trx_id;
+    /** stored position of the clustered index record, for reusing
+    the lookup for all secondary index entries of the row */
+    btr_pcur_t pcur;
+    /** whether pcur is positioned on the clustered index record */
+    bool found_clust= false;
+  };
+
+  /** A secondary index entry of a deferred delete-marked row */
+  struct sec_entry_t
+  {
+    /** secondary index */
+    dict_index_t *index;
+    /** the index entry */
+    const dtuple_t *entry;
+    /** position of the row in del_marks */
+    size_t row;
+  };
+
+  /** table of del_marks, or nullptr */
+  dict_table_t *del_mark_table= nullptr;
+  /** delete-marked rows of del_mark_table, in undo log order */
+  std::vector<del_mark_t> del_marks;
+  /** secondary index entries of del_marks */
+  std::vector<sec_entry_t> sec_entries;
+
   /** Constructor */
   explicit purge_node_t(que_thr_t *parent) :
     common(QUE_NODE_PURGE, parent), heap(mem_heap_create(256)),
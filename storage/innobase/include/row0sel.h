@@ -178,6 +178,20 @@ current read view.
 dberr_t row_check_index(row_prebuilt_t *prebuilt, ulint *n_rows)
   MY_ATTRIBUTE((nonnull, warn_unused_result));
 
+/** Convert a clustered index record to the MySQL format of
+prebuilt->mysql_template. This does not modify prebuilt, and it may be
+invoked concurrently from several threads, if prebuilt->blob_heap is not
+allocated, the template contains no BLOB or virtual columns, and the table
+has no FULLTEXT index.
+@param mysql_rec  row in the MySQL format
+@param prebuilt   cursor
+@param rec        clustered index record
+@param offsets    rec_get_offsets(rec)
+@return whether all columns could be retrieved */
+bool row_sel_store_mysql_rec_clust(byte *mysql_rec, row_prebuilt_t *prebuilt,
+                                   const rec_t *rec, const rec_offs *offsets)
+  MY_ATTRIBUTE((nonnull, warn_unused_result));
+
 /** Read the max AUTOINC value from an index.
 @param[in] index	index starting with an AUTO_INCREMENT column
 @return	the largest AUTO_INCREMENT value
@@ -34,10 +34,100 @@ Created 2/6/1997 Heikki Tuuri
 #include "mtr0mtr.h"
 #include "dict0mem.h"
 #include "row0types.h"
+#include <unordered_map>
 
 // Forward declaration
 class ReadView;
 
+/** Cache of old versions of clustered index records that were constructed
+by row_vers_build_for_consistent_read() for the read view of a transaction.
+Repeated visits of a row that was modified after the read view was created
+will avoid applying the same undo log records again.
+
+An entry is identified by DB_ROLL_PTR of the latest version of the record;
+any modification of the record would assign a new DB_ROLL_PTR. The undo log
+records cannot be purged while the read view is open. The cache must be
+cleared whenever the read view is reopened. A rollback (also to a savepoint)
+truncates undo logs, after which a DB_ROLL_PTR may be reused for a different
+record; undo_truncations will invalidate all caches in that case.
+
+The cache is only accessed by the thread that is executing the transaction. */
+class row_vers_cache_t
+{
+  /** A cached old version */
+  struct entry_t
+  {
+    /** copy of the record, starting with the extra bytes,
+    or nullptr if the record does not exist in the read view */
+    const byte *buf;
+    /** rec_offs_extra_size() */
+    uint32_t extra;
+    /** rec_offs_size() */
+    uint32_t size;
+    /** dict_index_t::id of the clustered index */
+    index_id_t index_id;
+  };
+
+  /** mapping from DB_ROLL_PTR of the latest version to the old version */
+  std::unordered_map<roll_ptr_t, entry_t> map;
+  /** memory heap for the record copies */
+  mem_heap_t *heap= nullptr;
+  /** approximate memory usage, in bytes */
+  size_t used= 0;
+  /** undo_truncations at the time the entries were added */
+  uint64_t epoch= 0;
+
+  /** Discard all entries if undo logs were truncated since they were
+  added.
+  @return whether the entries are still valid */
+  bool validate()
+  {
+    const uint64_t e= undo_truncations;
+    if (UNIV_LIKELY(e == epoch))
+      return true;
+    clear();
+    epoch= e;
+    return false;
+  }
+
+public:
+  /** Number of truncations of persistent undo logs by rollback.
+  Incremented by trx_undo_try_truncate() before any DB_ROLL_PTR
+  can be reused. */
+  static Atomic_relaxed<uint64_t> undo_truncations;
+
+  ~row_vers_cache_t() { clear(); }
+
+  /** Remove all entries. */
+  void clear();
+
+  /** Look up an old version.
+  @param index     clustered index
+  @param roll_ptr  DB_ROLL_PTR of the latest version
+  @param heap      memory heap for the copy of the record
+  @param old_vers  old version, or nullptr if the record
+                   does not exist in the read view
+  @return whether the old version was found */
+  bool find(const dict_index_t &index, roll_ptr_t roll_ptr,
+            mem_heap_t *heap, rec_t **old_vers);
+
+  /** Add an old version. If innodb_old_version_cache_size would be
+  exceeded, all previously cached entries will be discarded.
+  @param index     clustered index
+  @param roll_ptr  DB_ROLL_PTR of the latest version
+  @param old_vers  old version, or nullptr if the record
+                   does not exist in the read view
+  @param offsets   rec_get_offsets(old_vers, index) */
+  void add(const dict_index_t &index, roll_ptr_t roll_ptr,
+           const rec_t *old_vers, const rec_offs *offsets);
+
+  /** Get the cache of a transaction, creating it if needed.
+  @param trx  transaction
+  @return the cache
+  @retval nullptr if innodb_old_version_cache_size=0 */
+  static row_vers_cache_t *get(trx_t *trx);
+};
+
 /** Determine if an active transaction has inserted or modified a secondary
 index record.
 @param[in,out]	caller_trx	trx of current thread
@@ -111,7 +201,9 @@ row_vers_build_for_consistent_read(
 				if the history is missing or the record
 				does not exist in the view, that is,
 				it was freshly inserted afterwards */
-	dtuple_t**	vrow);	/*!< out: reports virtual column info if any */
+	dtuple_t**	vrow,	/*!< out: reports virtual column info if any */
+	row_vers_cache_t*cache = nullptr);/*!< in/out: cache of old
+				versions for the read view, or nullptr */
 
 /*****************************************************************//**
 Constructs the last committed version of a clustered index record,
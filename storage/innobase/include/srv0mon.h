@@ -155,6 +155,11 @@ enum monitor_id_t {
 	MONITOR_OVLD_LOCK_MAX_WAIT_TIME,
 	MONITOR_OVLD_ROW_LOCK_WAIT,
 	MONITOR_OVLD_LOCK_AVG_WAIT_TIME,
+	MONITOR_OVLD_ROW_LOCK_WAIT_10MS,
+	MONITOR_OVLD_ROW_LOCK_WAIT_100MS,
+	MONITOR_OVLD_ROW_LOCK_WAIT_1S,
+	MONITOR_OVLD_ROW_LOCK_WAIT_10S,
+	MONITOR_OVLD_ROW_LOCK_WAIT_LONGER,
 
 	/* Buffer and I/O realted counters. */
 	MONITOR_MODULE_BUFFER,
@@ -186,6 +191,14 @@ enum monitor_id_t {
 	MONITOR_FLUSH_NEIGHBOR_TOTAL_PAGE,
 	MONITOR_FLUSH_NEIGHBOR_COUNT,
 	MONITOR_FLUSH_NEIGHBOR_PAGES,
+	MONITOR_FLUSH_WORKER_PAGES_0,
+	MONITOR_FLUSH_WORKER_PAGES_1,
+	MONITOR_FLUSH_WORKER_PAGES_2,
+	MONITOR_FLUSH_WORKER_PAGES_3,
+	MONITOR_FLUSH_WORKER_PAGES_4,
+	MONITOR_FLUSH_WORKER_PAGES_5,
+	MONITOR_FLUSH_WORKER_PAGES_6,
+	MONITOR_FLUSH_WORKER_PAGES_7,
 	MONITOR_FLUSH_N_TO_FLUSH_REQUESTED,
 
 	MONITOR_FLUSH_N_TO_FLUSH_BY_AGE,
@@ -272,6 +285,10 @@ enum monitor_id_t {
 	MONITOR_NUM_UNDO_SLOT_USED,
 	MONITOR_NUM_UNDO_SLOT_CACHED,
 	MONITOR_RSEG_CUR_SIZE,
+	MONITOR_TRX_OLD_VERSIONS_BUILT,
+	MONITOR_TRX_OLD_VERSION_UNDO_RECS,
+	MONITOR_TRX_OLD_VERSION_CACHE_HITS,
+	MONITOR_TRX_SNAPSHOTS_REUSED,
 
 	/* Purge related counters */
 	MONITOR_MODULE_PURGE,
@@ -300,6 +317,8 @@ enum monitor_id_t {
 	MONITOR_MODULE_PAGE,
 	MONITOR_PAGE_COMPRESS,
 	MONITOR_PAGE_DECOMPRESS,
+	MONITOR_PAGE_COMPRESS_LZ4,
+	MONITOR_PAGE_DECOMPRESS_LZ4,
 	MONITOR_PAD_INCREMENTS,
 	MONITOR_PAD_DECREMENTS,
 	/* New monitor variables for page compression */
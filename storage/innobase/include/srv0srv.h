@@ -134,6 +134,11 @@ extern const char	srv_mysql50_table_name_prefix[10];
 #define SRV_BUF_DUMP_FILENAME_DEFAULT	"ib_buffer_pool"
 extern char*		srv_buf_dump_filename;
 
+/** The second-level page cache file name, or NULL */
+extern char*		srv_buf_l2_file;
+/** Size of the second-level page cache file, in bytes */
+extern ulonglong	srv_buf_l2_size;
+
 /** Boolean config knobs that tell InnoDB to dump the buffer pool at shutdown
 and/or load it during startup. */
 extern char		srv_buffer_pool_dump_at_shutdown;
@@ -174,6 +179,9 @@ extern my_bool	srv_file_per_table;
 
 /** Sort buffer size in index creation */
 extern ulong	srv_sort_buf_size;
+/** Maximum size of the cache of old record versions of a transaction,
+in bytes; 0 disables the cache */
+extern ulong	srv_old_version_cache_size;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
 
@@ -183,6 +191,9 @@ use simulated aio.
 Currently we support native aio on windows and linux */
 extern my_bool	srv_use_native_aio;
 extern my_bool	srv_numa_interleave;
+/** innodb_numa_local_chunks: whether to allocate each buffer pool chunk
+on one NUMA node */
+extern my_bool	srv_numa_local_chunks;
 
 /* Use atomic writes i.e disable doublewrite buffer */
 extern my_bool srv_use_atomic_writes;
@@ -238,6 +249,8 @@ extern size_t		srv_buf_pool_chunk_unit;
 extern ulong	srv_LRU_scan_depth;
 /** Whether or not to flush neighbors of a block */
 extern ulong	srv_flush_neighbors;
+/** Number of threads that write the pages of a flush_list batch */
+extern ulong	srv_page_cleaner_threads;
 /** Previously requested size */
 extern ulint	srv_buf_pool_old_size;
 /** Current size as scaling factor for the other components */
@@ -246,6 +259,10 @@ extern ulint	srv_buf_pool_base_size;
 extern ulint	srv_buf_pool_curr_size;
 /** Dump this % of each buffer pool during BP dump */
 extern ulong	srv_buf_pool_dump_pct;
+/** Number of threads that submit reads during BP load */
+extern ulong	srv_buf_pool_load_threads;
+/** Maximum number of pending read requests during BP load */
+extern ulong	srv_buf_pool_load_io_depth;
 #ifdef UNIV_DEBUG
 /** Abort load after this amount of pages */
 extern ulong srv_buf_pool_load_pages_abort;
@@ -284,6 +301,10 @@ extern ulong	srv_flushing_avg_loops;
 
 extern ulong	srv_force_recovery;
 
+/** innodb_recovery_online: whether the last batch of crash recovery
+may be applied in the background while the server accepts connections */
+extern my_bool	srv_recovery_online;
+
 /** innodb_fast_shutdown=1 skips purge.
 innodb_fast_shutdown=2 effectively crashes the server (no log checkpoint).
 innodb_fast_shutdown=3 is a clean shutdown that skips the rollback
@@ -301,6 +322,8 @@ extern unsigned long long	srv_stats_modified_counter;
 extern my_bool			srv_stats_sample_traditional;
 
 extern my_bool	srv_use_doublewrite_buf;
+/** innodb_doublewrite_batches: number of concurrent doublewrite batches */
+extern ulong	srv_doublewrite_batches;
 extern ulong	srv_checksum_algorithm;
 
 extern my_bool	srv_force_primary_key;
@@ -870,6 +870,26 @@ class trx_sys_t
   alignas(CPU_LEVEL1_DCACHE_LINESIZE)
   std::atomic<trx_id_t> m_rw_trx_hash_version;
 
+  /**
+    Incremented by deregister_rw(), which is when the changes of a committed
+    transaction become visible to new snapshots. Registration of read-write
+    transactions does not matter, because their identifiers are not below
+    the m_low_limit_id of any existing snapshot.
+
+    This shares the cache line with m_rw_trx_hash_version, which is
+    modified by every commit anyway.
+
+    @sa get_snapshot()
+  */
+  std::atomic<uint64_t> m_snapshot_generation;
+
+  /** Protects m_snapshot */
+  alignas(CPU_LEVEL1_DCACHE_LINESIZE) srw_spin_lock_low m_snapshot_latch;
+  /** m_snapshot_generation when m_snapshot was created, or 0 */
+  std::atomic<uint64_t> m_snapshot_cached;
+  /** The most recently created snapshot, for reuse by get_snapshot() */
+  ReadViewBase m_snapshot;
+
 
   bool m_initialised;
 
@@ -1055,6 +1075,29 @@ class trx_sys_t
   }
 
 
+  /**
+    Copy the most recently created MVCC snapshot, unless it is outdated.
+
+    Read views that are opened between two commits will share the snapshot
+    that was created by the first of them. This avoids the iteration over
+    rw_trx_hash in snapshot_ids() and the sorting of the identifiers when
+    many read views are being opened while many read-write transactions
+    are active.
+
+    @param[out] view        the snapshot
+    @param[out] generation  value to pass to put_snapshot()
+    @return whether the snapshot was copied to view
+  */
+  bool get_snapshot(ReadViewBase *view, uint64_t *generation);
+
+  /**
+    Store a snapshot for reuse by get_snapshot().
+    @param view        snapshot that was created by snapshot_ids()
+    @param generation  the value that was returned by get_snapshot()
+  */
+  void put_snapshot(const ReadViewBase &view, uint64_t generation);
+
+
   /** Initialiser for m_max_trx_id and m_rw_trx_hash_version. */
   void init_max_trx_id(trx_id_t value)
   {
@@ -1130,6 +1173,7 @@ class trx_sys_t
   void deregister_rw(trx_t *trx)
   {
     rw_trx_hash.erase(trx);
+    m_snapshot_generation.fetch_add(1, std::memory_order_release);
   }
 
 
@@ -43,6 +43,7 @@ Created 3/26/1996 Heikki Tuuri
 // Forward declaration
 struct mtr_t;
 struct rw_trx_hash_element_t;
+class row_vers_cache_t;
 
 /******************************************************************//**
 Set detailed error message for the transaction. */
@@ -330,6 +331,10 @@ struct trx_lock_t
   Atomic_relaxed<lock_t*> wait_lock;
   /** Transaction being waited for; protected by lock_sys.wait_mutex */
   trx_t *wait_trx;
+  /** Number of transactions whose wait_trx points to this transaction;
+  the scheduling weight for innodb_lock_grant_policy=CATS.
+  Protected by lock_sys.wait_mutex. */
+  ulint n_waiters;
   /** condition variable for !wait_lock; used with lock_sys.wait_mutex */
   pthread_cond_t cond;
   /** lock wait start time */
@@ -771,6 +776,9 @@ struct trx_t : ilist_node<>
 
   /** Consistent read view of the transaction */
   ReadView read_view;
+  /** Cache of old record versions for read_view, or nullptr;
+  see row_vers_cache_t::get() */
+  row_vers_cache_t *vers_cache;
 
 	/* These fields are not protected by any mutex. */
 
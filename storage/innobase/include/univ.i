@@ -478,6 +478,7 @@ extern mysql_pfs_key_t srv_innodb_monitor_mutex_key;
 extern mysql_pfs_key_t srv_misc_tmpfile_mutex_key;
 extern mysql_pfs_key_t srv_monitor_file_mutex_key;
 extern mysql_pfs_key_t buf_dblwr_mutex_key;
+extern mysql_pfs_key_t buf_l2_mutex_key;
 extern mysql_pfs_key_t trx_pool_mutex_key;
 extern mysql_pfs_key_t trx_pool_manager_mutex_key;
 extern mysql_pfs_key_t lock_wait_mutex_key;
@@ -58,6 +58,8 @@ Created 5/7/1996 Heikki Tuuri
 my_bool innodb_deadlock_detect;
 /** The value of innodb_deadlock_report */
 ulong innodb_deadlock_report;
+/** The value of innodb_lock_grant_policy */
+ulong innodb_lock_grant_policy;
 
 #ifdef HAVE_REPLICATION
 extern "C" void thd_rpl_deadlock_check(MYSQL_THD thd, MYSQL_THD other_thd);
@@ -1148,6 +1150,22 @@ lock_number_of_tables_locked(
 
 /*============== RECORD LOCK CREATION AND QUEUE MANAGEMENT =============*/
 
+/** Set the transaction that a transaction is waiting for.
+@param trx       waiting transaction
+@param wait_trx  transaction that trx is waiting for, or nullptr */
+static void lock_set_wait_trx(trx_t *trx, trx_t *wait_trx)
+{
+  mysql_mutex_assert_owner(&lock_sys.wait_mutex);
+  if (trx_t *old= trx->lock.wait_trx)
+  {
+    ut_ad(old->lock.n_waiters);
+    old->lock.n_waiters--;
+  }
+  trx->lock.wait_trx= wait_trx;
+  if (wait_trx)
+    wait_trx->lock.n_waiters++;
+}
+
 /** Reset the wait status of a lock.
 @param[in,out]	lock	lock that was possibly being waited for */
 static void lock_reset_lock_and_trx_wait(lock_t *lock)
@@ -1160,7 +1178,7 @@ static void lock_reset_lock_and_trx_wait(lock_t *lock)
   if (trx_t *wait_trx= trx->lock.wait_trx)
     Deadlock::to_check.erase(wait_trx);
   trx->lock.wait_lock= nullptr;
-  trx->lock.wait_trx= nullptr;
+  lock_set_wait_trx(trx, nullptr);
   lock->type_mode&= ~LOCK_WAIT;
 }
 
@@ -1281,7 +1299,7 @@ lock_rec_create_low(
 			ut_ad((*trx->lock.wait_lock).trx == trx);
 		} else {
 			ut_ad(c_lock);
-			trx->lock.wait_trx = c_lock->trx;
+			lock_set_wait_trx(trx, c_lock->trx);
 			ut_ad(!trx->lock.wait_lock);
 		}
 		trx->lock.wait_lock = lock;
@@ -1697,10 +1715,14 @@ lock_rec_lock(
 
 /*********************************************************************//**
 Checks if a waiting record lock request still has to wait in a queue.
+@param cell          lock hash table cell
+@param wait_lock     waiting lock request
+@param granted_only  whether to ignore waiting requests ahead of wait_lock
 @return lock that is causing the wait */
 static
 const lock_t*
-lock_rec_has_to_wait_in_queue(const hash_cell_t &cell, const lock_t *wait_lock)
+lock_rec_has_to_wait_in_queue(const hash_cell_t &cell, const lock_t *wait_lock,
+			      bool granted_only= false)
 {
 	const lock_t*	lock;
 	ulint		heap_no;
@@ -1723,6 +1745,7 @@ lock_rec_has_to_wait_in_queue(const hash_cell_t &cell, const lock_t *wait_lock)
 
 		if (heap_no < lock_rec_get_n_bits(lock)
 		    && (p[bit_offset] & bit_mask)
+		    && !(granted_only && lock->is_waiting())
 		    && lock_has_to_wait(wait_lock, lock)) {
 #ifdef WITH_WSREP
 			if (lock->trx->is_wsrep() &&
@@ -1752,7 +1775,8 @@ inline void lock_sys_t::wait_start()
 
 /** Note that a record lock wait resumed */
 inline
-void lock_sys_t::wait_resume(THD *thd, my_hrtime_t start, my_hrtime_t now)
+void lock_sys_t::wait_resume(THD *thd, my_hrtime_t start, my_hrtime_t now,
+                             bool rec_lock)
 {
   mysql_mutex_assert_owner(&wait_mutex);
   ut_ad(get_wait_pending());
@@ -1767,6 +1791,15 @@ void lock_sys_t::wait_resume(THD *thd, my_hrtime_t start, my_hrtime_t now)
     if (diff_time > wait_time_max)
       wait_time_max= diff_time;
 
+    if (rec_lock)
+    {
+      unsigned i= 0;
+      for (uint64_t limit= 10;
+           i < WAIT_HISTOGRAM_SIZE - 1 && diff_time >= limit; limit*= 10)
+        i++;
+      wait_histogram[i]++;
+    }
+
     thd_storage_lock_wait(thd, diff_time);
   }
 }
@@ -2069,7 +2102,8 @@ dberr_t lock_wait(que_thr_t *thr)
 
 end_loop:
   if (row_lock_wait)
-    lock_sys.wait_resume(trx->mysql_thd, suspend_time, my_hrtime_coarse());
+    lock_sys.wait_resume(trx->mysql_thd, suspend_time, my_hrtime_coarse(),
+                         !(type_mode & LOCK_TABLE));
 
   ut_ad(!wait_lock == !trx->lock.wait_lock);
 
@@ -2184,6 +2218,57 @@ static void lock_rec_cancel(lock_t *lock)
   trx->mutex_unlock();
 }
 
+/** Grant waiting record locks on a page in the order of
+innodb_lock_grant_policy=CATS: the transactions that the most other
+transactions are waiting for are considered first, and a request is
+granted if no granted lock ahead of it in the queue conflicts with it.
+Granted requests are moved to the start of the queue, so that the
+requests that remain waiting will find them in
+lock_rec_has_to_wait_in_queue().
+@param cell     lock hash table cell
+@param page_id  page whose lock queue changed */
+static void lock_rec_grant_cats(hash_cell_t &cell, const page_id_t page_id)
+{
+  mysql_mutex_assert_owner(&lock_sys.wait_mutex);
+  small_vector<lock_t*, 16> waiting;
+
+  for (lock_t *lock= lock_sys_t::get_first(cell, page_id); lock;
+       lock= lock_rec_get_next_on_page(lock))
+    if (lock->is_waiting())
+      waiting.emplace_back(static_cast<lock_t*>(lock));
+
+  /* Among equal weights, preserve the queue order. */
+  std::stable_sort(waiting.begin(), waiting.end(),
+                   [](const lock_t *a, const lock_t *b)
+                   { return a->trx->lock.n_waiters > b->trx->lock.n_waiters; });
+
+  for (lock_t *lock : waiting)
+  {
+    ut_ad(lock->trx->lock.wait_trx);
+    ut_ad(lock->trx->lock.wait_lock);
+    if (lock_rec_has_to_wait_in_queue(cell, lock, true))
+      continue;
+    lock_grant(lock);
+    /* Move the granted request to the start of the hash cell. */
+    HASH_DELETE(lock_t, hash, &lock_sys.rec_hash, page_id.fold(), lock);
+    lock->hash= static_cast<lock_t*>(cell.node);
+    cell.node= lock;
+  }
+
+  for (lock_t *lock : waiting)
+  {
+    if (!lock->is_waiting())
+      continue;
+    const lock_t *c= lock_rec_has_to_wait_in_queue(cell, lock);
+    ut_ad(c);
+    trx_t *c_trx= c->trx;
+    lock_set_wait_trx(lock->trx, c_trx);
+    if (c_trx->lock.wait_trx && innodb_deadlock_detect &&
+        Deadlock::to_check.emplace(c_trx).second)
+      Deadlock::to_be_checked= true;
+  }
+}
+
 /** Remove a record lock request, waiting or granted, from the queue and
 grant locks to other transactions in the queue if they now are entitled
 to a lock. NOTE: all record locks contained in in_lock are removed.
@@ -2217,6 +2302,25 @@ static void lock_rec_dequeue_from_page(lock_t *in_lock, bool owns_wait_mutex)
 
 	bool acquired = false;
 
+	if (innodb_lock_grant_policy == LOCK_GRANT_CATS
+	    && &lock_hash == &lock_sys.rec_hash) {
+		for (lock_t* lock = lock_sys_t::get_first(cell, page_id);
+		     lock != NULL;
+		     lock = lock_rec_get_next_on_page(lock)) {
+			if (lock->is_waiting()) {
+				if (!owns_wait_mutex) {
+					mysql_mutex_lock(
+						&lock_sys.wait_mutex);
+					acquired = true;
+				}
+				lock_rec_grant_cats(cell, page_id);
+				break;
+			}
+		}
+
+		goto func_exit;
+	}
+
 	/* Check if waiting locks in the queue can now be granted:
 	grant locks if there are no conflicting locks ahead. Stop at
 	the first X lock that is waiting or has been granted. */
@@ -2240,7 +2344,7 @@ static void lock_rec_dequeue_from_page(lock_t *in_lock, bool owns_wait_mutex)
 		if (const lock_t* c = lock_rec_has_to_wait_in_queue(
 			    cell, lock)) {
 			trx_t* c_trx = c->trx;
-			lock->trx->lock.wait_trx = c_trx;
+			lock_set_wait_trx(lock->trx, c_trx);
 			if (c_trx->lock.wait_trx
 			    && innodb_deadlock_detect
 			    && Deadlock::to_check.emplace(c_trx).second) {
@@ -2253,6 +2357,7 @@ static void lock_rec_dequeue_from_page(lock_t *in_lock, bool owns_wait_mutex)
 		}
 	}
 
+func_exit:
 	if (acquired) {
 		mysql_mutex_unlock(&lock_sys.wait_mutex);
 	}
@@ -3509,7 +3614,7 @@ lock_t *lock_table_create(dict_table_t *table, unsigned type_mode, trx_t *trx,
 			ut_ad((*trx->lock.wait_lock).trx == trx);
 		} else {
 			ut_ad(c_lock);
-			trx->lock.wait_trx = c_lock->trx;
+			lock_set_wait_trx(trx, c_lock->trx);
 			ut_ad(!trx->lock.wait_lock);
 		}
 		trx->lock.wait_lock = lock;
@@ -3910,7 +4015,7 @@ static void lock_table_dequeue(lock_t *in_lock, bool owns_wait_mutex)
 
 		if (const lock_t* c = lock_table_has_to_wait_in_queue(lock)) {
 			trx_t* c_trx = c->trx;
-			lock->trx->lock.wait_trx = c_trx;
+			lock_set_wait_trx(lock->trx, c_trx);
 			if (c_trx->lock.wait_trx
 			    && innodb_deadlock_detect
 			    && Deadlock::to_check.emplace(c_trx).second) {
@@ -4031,7 +4136,8 @@ dberr_t lock_sys_tables(trx_t *trx)
 }
 
 /** Rebuild waiting queue after first_lock for heap_no. The queue is rebuilt
-close to the way lock_rec_dequeue_from_page() does it.
+close to the way lock_rec_dequeue_from_page() does it, also regarding
+innodb_lock_grant_policy.
 @param trx        transaction that has set a lock, which caused the queue
                   rebuild
 @param cell       rec hash cell of first_lock
@@ -4045,6 +4151,23 @@ static void lock_rec_rebuild_waiting_queue(
 {
   lock_sys.assert_locked(cell);
 
+  if (innodb_lock_grant_policy == LOCK_GRANT_CATS && first_lock &&
+      !(first_lock->type_mode & (LOCK_PREDICATE | LOCK_PRDT_PAGE)))
+  {
+    for (lock_t *lock= first_lock; lock != NULL;
+         lock= lock_rec_get_next(heap_no, lock))
+    {
+      if (!lock->is_waiting())
+        continue;
+      ut_ad(trx != lock->trx);
+      mysql_mutex_lock(&lock_sys.wait_mutex);
+      lock_rec_grant_cats(cell, lock->un_member.rec_lock.page_id);
+      mysql_mutex_unlock(&lock_sys.wait_mutex);
+      break;
+    }
+    return;
+  }
+
   for (lock_t *lock= first_lock; lock != NULL;
        lock= lock_rec_get_next(heap_no, lock))
   {
@@ -4055,7 +4178,7 @@ static void lock_rec_rebuild_waiting_queue(
     ut_ad(lock->trx->lock.wait_lock);
 
     if (const lock_t *c= lock_rec_has_to_wait_in_queue(cell, lock))
-      lock->trx->lock.wait_trx= c->trx;
+      lock_set_wait_trx(lock->trx, c->trx);
     else
     {
       /* Grant the lock */
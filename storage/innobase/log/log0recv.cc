@@ -1322,6 +1322,7 @@ void recv_sys_t::close()
     ut_d(mysql_mutex_unlock(&mutex));
 
     scanned_lsn= 0;
+    pthread_cond_destroy(&online_cond);
     mysql_mutex_destroy(&mutex);
   }
 
@@ -1337,8 +1338,10 @@ void recv_sys_t::create()
 	ut_ad(this == &recv_sys);
 	ut_ad(!is_initialised());
 	mysql_mutex_init(recv_sys_mutex_key, &mutex, nullptr);
+	pthread_cond_init(&online_cond, nullptr);
 
 	apply_log_recs = false;
+	online = false;
 
 	len = 0;
 	offset = 0;
@@ -1386,8 +1389,12 @@ void recv_sys_t::debug_free()
   mysql_mutex_lock(&mutex);
 
   recovery_on= false;
-  pages.clear();
-  pages_it= pages.end();
+  /* If apply_online() is in progress, it will clear the pages. */
+  if (!online)
+  {
+    pages.clear();
+    pages_it= pages.end();
+  }
 
   mysql_mutex_unlock(&mutex);
 }
@@ -2002,6 +2009,15 @@ ATTRIBUTE_COLD void recv_sys_t::wait_for_pool(size_t pages)
   garbage_collect();
   mysql_mutex_lock(&buf_pool.mutex);
   bool need_more= UT_LIST_GET_LEN(buf_pool.free) < pages;
+  if (need_more && online)
+  {
+    /* Other threads are using the buffer pool. Instead of writing out
+    all dirty pages, evict enough pages from the tail of buf_pool.LRU. */
+    buf_flush_LRU(pages, true);
+    mysql_mutex_unlock(&buf_pool.mutex);
+    buf_dblwr.flush_buffered_writes();
+    return;
+  }
   mysql_mutex_unlock(&buf_pool.mutex);
   if (need_more)
     buf_flush_sync_batch(lsn);
@@ -3086,6 +3102,8 @@ static buf_block_t *recv_recover_page(buf_block_t *block, mtr_t &mtr,
 	ut_ad(!space || space->id == block->page.id().space());
 	ut_ad(log_sys.is_latest());
 
+	const ulonglong start_time = my_interval_timer();
+
 	if (UNIV_UNLIKELY(srv_print_verbose_log == 2)) {
 		ib::info() << "Applying log to page " << block->page.id();
 	}
@@ -3260,7 +3278,13 @@ static buf_block_t *recv_recover_page(buf_block_t *block, mtr_t &mtr,
 		mysql_mutex_lock(&buf_pool.flush_list_mutex);
 		buf_pool.flush_list_bytes+= block->physical_size();
 		block->page.set_oldest_modification(start_lsn);
-		UT_LIST_ADD_FIRST(buf_pool.flush_list, &block->page);
+		if (UNIV_LIKELY(!recv_sys.online)) {
+			UT_LIST_ADD_FIRST(buf_pool.flush_list, &block->page);
+		} else {
+			/* Any pages that were modified after
+			apply_online() are newer than start_lsn. */
+			UT_LIST_ADD_LAST(buf_pool.flush_list, &block->page);
+		}
 		buf_pool.page_cleaner_wakeup();
 		mysql_mutex_unlock(&buf_pool.flush_list_mutex);
 	} else if (free_page && init_lsn) {
@@ -3282,6 +3306,7 @@ static buf_block_t *recv_recover_page(buf_block_t *block, mtr_t &mtr,
 		recv_max_page_lsn = page_lsn;
 	}
 
+	recv_sys.stats.page_time += my_interval_timer() - start_time;
 	return block;
 }
 
@@ -3290,7 +3315,7 @@ This function should only be called when innodb_force_recovery is set.
 @param page_id  corrupted page identifier */
 ATTRIBUTE_COLD void recv_sys_t::free_corrupted_page(page_id_t page_id)
 {
-  if (!recovery_on)
+  if (!recv_recovery_is_pending())
     return;
 
   mysql_mutex_lock(&mutex);
@@ -3382,7 +3407,7 @@ void IORequest::fake_read_complete(os_offset_t offset) const
   ut_ad(is_read());
   ut_ad(bpage);
   ut_ad(bpage->frame);
-  ut_ad(recv_recovery_is_on());
+  ut_ad(recv_recovery_is_pending());
   ut_ad(offset);
 
   mtr_t mtr;
@@ -3550,7 +3575,7 @@ bool recv_sys_t::apply_batch(uint32_t space_id, fil_space_t *&space,
     ut_ad(!buf_dblwr.is_inside(pages_it->first));
     if (!pages_it->second.being_processed)
     {
-      const page_id_t id{pages_it->first};
+      page_id_t id{pages_it->first};
 
       if (space_id != id.space())
       {
@@ -3578,9 +3603,32 @@ bool recv_sys_t::apply_batch(uint32_t space_id, fil_space_t *&space,
         page_recv_t &recs= pages_it->second;
         ut_ad(!recs.log.empty());
         recs.being_processed= 1;
-        const lsn_t init_lsn{recs.skip_read ? mlog_init.last(id) : 0};
-        mysql_mutex_unlock(&mutex);
-        buf_read_recover(space, id, recs, init_lsn);
+        if (recs.skip_read)
+        {
+          const lsn_t init_lsn{mlog_init.last(id)};
+          mysql_mutex_unlock(&mutex);
+          buf_read_recover(space, id, recs, init_lsn);
+        }
+        else
+        {
+          /* Read any subsequent adjacent pages with the same request. */
+          uint32_t n_pages= 1;
+          for (map::iterator i= std::next(pages_it);
+               n_pages < n && n_pages < buf_pool_t::READ_AHEAD_PAGES &&
+                 i != pages.end() && i->first == id + n_pages &&
+                 !i->second.being_processed && !i->second.skip_read &&
+                 !space->is_freed(i->first.page_no()); i++, n_pages++)
+          {
+            ut_ad(!i->second.log.empty());
+            i->second.being_processed= 1;
+          }
+          n-= n_pages - 1;
+          mysql_mutex_unlock(&mutex);
+          stats.reads+= buf_read_recover_pages(space, id, n_pages);
+          stats.pages_read+= n_pages;
+          /* Continue the search after the last submitted page. */
+          id= id + (n_pages - 1);
+        }
       }
 
       if (!--n)
@@ -3762,7 +3810,10 @@ inline fil_space_t *fil_system_t::find(const char *path) const
 /** Thread-safe function which sorts flush_list by oldest_modification */
 static void log_sort_flush_list()
 {
-  /* Ensure that oldest_modification() cannot change during std::sort() */
+  /* Ensure that oldest_modification() cannot change during std::sort().
+  With apply_online(), other threads may keep writing pages; we will
+  sort a snapshot of the oldest_modification() instead. */
+  if (!recv_sys.online)
   {
     const double pct_lwm= srv_max_dirty_pages_pct_lwm;
     /* Disable "idle" flushing in order to minimize the wait time below. */
@@ -3782,9 +3833,12 @@ static void log_sort_flush_list()
 
     srv_max_dirty_pages_pct_lwm= pct_lwm;
   }
+  else
+    mysql_mutex_lock(&buf_pool.flush_list_mutex);
 
   const size_t size= UT_LIST_GET_LEN(buf_pool.flush_list);
-  std::unique_ptr<buf_page_t *[]> list(new buf_page_t *[size]);
+  using page_lsn= std::pair<lsn_t, buf_page_t*>;
+  std::unique_ptr<page_lsn[]> list(new page_lsn[size]);
 
   /* Copy the dirty blocks from buf_pool.flush_list to an array for sorting. */
   size_t idx= 0;
@@ -3794,26 +3848,25 @@ static void log_sort_flush_list()
     ut_ad(lsn > 2 || lsn == 1);
     buf_page_t *n= UT_LIST_GET_NEXT(list, p);
     if (lsn > 1)
-      list.get()[idx++]= p;
+      list.get()[idx++]= {lsn, p};
     else
       buf_pool.delete_from_flush_list(p);
     p= n;
   }
 
   std::sort(list.get(), list.get() + idx,
-            [](const buf_page_t *lhs, const buf_page_t *rhs) {
-              const lsn_t l{lhs->oldest_modification()};
-              const lsn_t r{rhs->oldest_modification()};
-              DBUG_ASSERT(l > 2); DBUG_ASSERT(r > 2);
-              return r < l;
+            [](const page_lsn &lhs, const page_lsn &rhs) {
+              DBUG_ASSERT(lhs.first > 2); DBUG_ASSERT(rhs.first > 2);
+              return rhs.first < lhs.first;
             });
 
   UT_LIST_INIT(buf_pool.flush_list, &buf_page_t::list);
 
   for (size_t i= 0; i < idx; i++)
   {
-    UT_LIST_ADD_LAST(buf_pool.flush_list, list[i]);
-    DBUG_ASSERT(list[i]->oldest_modification() > 2);
+    UT_LIST_ADD_LAST(buf_pool.flush_list, list[i].second);
+    DBUG_ASSERT(list[i].second->oldest_modification() > 2 ||
+                recv_sys.online);
   }
 
   mysql_mutex_unlock(&buf_pool.flush_list_mutex);
@@ -3829,6 +3882,7 @@ void recv_sys_t::apply(bool last_batch)
 
   mysql_mutex_assert_owner(&mutex);
 
+  const ulonglong start_time{my_interval_timer()};
   garbage_collect();
 
   if (!pages.empty())
@@ -3975,6 +4029,125 @@ void recv_sys_t::apply(bool last_batch)
 
   ut_d(after_apply= true);
   clear();
+
+  stats.apply_time+= my_interval_timer() - start_time;
+  if (last_batch && stats.pages_read + stats.page_time)
+  {
+    sql_print_information("InnoDB: Recovery phases: parse %.3fs,"
+                          " read %zu pages in %zu requests,"
+                          " apply %.3fs (%.3fs in %u read threads)",
+                          double(stats.parse_time) / 1e9,
+                          stats.pages_read, stats.reads,
+                          double(stats.apply_time) / 1e9,
+                          double(stats.page_time) / 1e9,
+                          uint(srv_n_read_io_threads));
+    stats.parse_time= stats.apply_time= 0;
+    stats.page_time= 0;
+    stats.reads= stats.pages_read= 0;
+  }
+}
+
+/** Apply the last batch of log in the background.
+@see recv_sys_t::apply_online() */
+static void recv_apply_online(void*)
+{
+  /* Let a test access the pages before the log has been applied */
+  for (unsigned i= 1000; i-- && DBUG_IF("recv_apply_online_wait"); )
+    my_sleep(10000);
+  mysql_mutex_lock(&recv_sys.mutex);
+  recv_sys.apply(true);
+  const bool corrupted= recv_sys.is_corrupt_log() || recv_sys.is_corrupt_fs();
+  recv_sys.online= false;
+  pthread_cond_broadcast(&recv_sys.online_cond);
+  mysql_mutex_unlock(&recv_sys.mutex);
+
+  if (UNIV_UNLIKELY(corrupted))
+    ib::fatal() << "Crash recovery failed after the server was opened"
+                   " for connections; restart with"
+                   " innodb_recovery_online=OFF to diagnose";
+  sql_print_information("InnoDB: Completed the recovery in the background");
+}
+
+static tpool::task_group recv_apply_online_group(1);
+static tpool::task recv_apply_online_task(recv_apply_online, nullptr,
+                                          &recv_apply_online_group);
+
+bool recv_sys_t::apply_online()
+{
+  ut_ad(srv_operation == SRV_OPERATION_NORMAL);
+  ut_ad(recovery_on);
+
+  mysql_mutex_lock(&mutex);
+  ut_ad(!online);
+  ut_ad(apply_log_recs || pages.empty());
+  /* File truncation and deferred tablespace creation must be completed
+  before any other thread can access the files. */
+  bool start= !pages.empty() && !truncated_sys_space.lsn &&
+    deferred_spaces.defers.empty() && !is_corrupt_fs() && !is_corrupt_log();
+  for (auto id= srv_undo_tablespaces_open; start && id--; )
+    start= !truncated_undo_spaces[id].lsn;
+  online= start;
+  const size_t n{pages.size()};
+  mysql_mutex_unlock(&mutex);
+
+  if (start)
+  {
+    fil_system.extend_to_recv_size();
+    sql_print_information("InnoDB: Applying the log to %zu pages"
+                          " in the background", n);
+    srv_thread_pool->submit_task(&recv_apply_online_task);
+  }
+
+  return start;
+}
+
+void recv_sys_t::wait_online()
+{
+  mysql_mutex_lock(&mutex);
+  while (online)
+    my_cond_wait(&online_cond, &mutex.m_mutex);
+  mysql_mutex_unlock(&mutex);
+}
+
+void recv_sys_t::apply_all()
+{
+  mysql_mutex_lock(&mutex);
+  while (online)
+    my_cond_wait(&online_cond, &mutex.m_mutex);
+  if (recovery_on)
+    apply(true);
+  mysql_mutex_unlock(&mutex);
+}
+
+void recv_sys_t::discard(page_id_t page_id)
+{
+  mysql_mutex_lock(&mutex);
+  map::iterator p= pages.find(page_id);
+  /* The caller is holding an exclusive page latch, and therefore no
+  read_complete() can be in progress. If apply_batch() is about to read
+  the page, buf_page_init_for_read() will notice that the page exists. */
+  if (p != pages.end())
+    p->second.being_processed= -1;
+  mysql_mutex_unlock(&mutex);
+}
+
+lsn_t recv_sys_t::claim_init(page_id_t page_id, page_recv_t *&recs)
+{
+  lsn_t init_lsn= 0;
+  mysql_mutex_lock(&mutex);
+  map::iterator p= pages.find(page_id);
+  /* Because the caller is holding the read-fix, a concurrent
+  buf_read_recover() for the page will find it in the buffer pool
+  and give up. */
+  if (online && p != pages.end() && p->second.skip_read &&
+      p->second.being_processed >= 0)
+  {
+    p->second.being_processed= 1;
+    init_lsn= mlog_init.last(page_id);
+    recs= &p->second;
+  }
+  mysql_mutex_unlock(&mutex);
+  return init_lsn;
 }
 
 /** Scan log_t::FORMAT_10_8 log store records to the parsing buffer.
@@ -3986,6 +4159,13 @@ static bool recv_scan_log(bool last_phase)
 
   ut_ad(log_sys.is_latest());
   const size_t block_size_1{log_sys.get_block_size() - 1};
+  const ulonglong start_time{my_interval_timer()};
+  const ulonglong apply_time{recv_sys.stats.apply_time};
+  /* Account for the parsing time, excluding any apply(false) */
+  auto parsed= [&]() {
+    recv_sys.stats.parse_time+= my_interval_timer() - start_time -
+      (recv_sys.stats.apply_time - apply_time);
+  };
 
   mysql_mutex_lock(&recv_sys.mutex);
   if (!last_phase)
@@ -4090,6 +4270,7 @@ static bool recv_scan_log(bool last_phase)
                             ") at " LSN_PF, log_sys.next_checkpoint_lsn,
                             recv_sys.lsn);
           }
+          parsed();
           DBUG_RETURN(true);
         }
       }
@@ -4107,6 +4288,7 @@ static bool recv_scan_log(bool last_phase)
           if (srv_read_only_mode)
           {
             mysql_mutex_unlock(&recv_sys.mutex);
+            parsed();
             DBUG_RETURN(false);
           }
           sql_print_information("InnoDB: Starting crash recovery from"
@@ -4198,6 +4380,7 @@ static bool recv_scan_log(bool last_phase)
 func_exit:
   ut_d(recv_sys.after_apply= last_phase);
   mysql_mutex_unlock(&recv_sys.mutex);
+  parsed();
   DBUG_RETURN(!store);
 }
 
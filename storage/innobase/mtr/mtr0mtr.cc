@@ -518,6 +518,8 @@ void mtr_t::commit_shrink(fil_space_t &space)
   ut_ad(!space.id || m_made_dirty);
   ut_ad(!m_memo.empty());
   ut_ad(!recv_recovery_is_on());
+  /* Any buffered log for the discarded pages must have been applied. */
+  recv_sys.wait_online();
   ut_ad(m_log_mode == MTR_LOG_ALL);
   ut_ad(!m_freed_pages);
 
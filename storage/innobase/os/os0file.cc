@@ -116,6 +116,12 @@ class io_slots
 		m_cache.wait();
 	}
 
+	/* Wait until fewer than n AIO operations are pending */
+	void wait_below(size_t n)
+	{
+		m_cache.wait_below(n);
+	}
+
 	size_t pending_io_count()
 	{
 		return m_cache.pos();
@@ -3413,7 +3419,12 @@ static void read_io_callback(void *c)
   ut_ad(read_slots->contains(cb));
   const IORequest &request= *static_cast<const IORequest*>
     (static_cast<const void*>(cb->m_userdata));
-  request.read_complete(cb->m_err);
+  int err= cb->m_err;
+  /* A batch must not copy a partially read buffer into the page frames */
+  if (!err && request.type == IORequest::READ_BATCH &&
+      cb->m_ret_len != cb->m_len)
+    err= EIO;
+  request.read_complete(err);
   read_slots->release(cb);
 }
 
@@ -3736,6 +3747,17 @@ void os_aio_wait_until_no_pending_reads(bool declare)
     tpool::tpool_wait_end();
 }
 
+/** Wait until fewer than n asynchronous reads are pending.
+@param n  maximum number of pending reads, plus 1 */
+void os_aio_wait_until_pending_reads_below(size_t n)
+{
+  if (read_slots->pending_io_count() < n)
+    return;
+  tpool::tpool_wait_begin();
+  read_slots->wait_below(n);
+  tpool::tpool_wait_end();
+}
+
 /** Submit a fake read request during crash recovery.
 @param type  fake read request
 @param offset additional context */
@@ -46,6 +46,7 @@ using st_::span;
 #include "srv0srv.h"
 #include "buf0lru.h"
 #include "srv0mon.h"
+#include "lz4.h"
 
 #include <map>
 #include <algorithm>
@@ -800,6 +801,151 @@ page_zip_set_alloc(
 	strm->opaque = heap;
 }
 
+/** First byte of the payload of a page that was compressed with LZ4.
+A zlib stream starts with a byte whose 4 least significant bits are
+Z_DEFLATED=8. */
+static constexpr byte PAGE_ZIP_LZ4_MAGIC= 1;
+/** Size of the header of a LZ4 payload: PAGE_ZIP_LZ4_MAGIC, followed by
+the length of the index information, the uncompressed length and the
+compressed length, 2 bytes each */
+static constexpr ulint PAGE_ZIP_LZ4_HEADER= 7;
+
+/** A zlib stream, or an emulation of it for PAGE_ZIP_LZ4.
+The uncompressed payload of a PAGE_ZIP_LZ4 page is the same as the
+input of deflate() in a PAGE_ZIP_ZLIB page: the index information
+followed by the records in heap_no order. The payload is buffered
+and compressed or decompressed in one go, so that the code that
+processes the records can remain unchanged. */
+struct page_zip_stream_t : z_stream
+{
+  /** the uncompressed payload, or nullptr for PAGE_ZIP_ZLIB */
+  byte *raw= nullptr;
+  /** length of the payload */
+  ulint raw_len;
+  /** length of the index information at the start of the payload */
+  ulint raw_fields;
+  /** current position in the payload during decompression */
+  ulint raw_pos;
+};
+
+/** Wrapper for deflate().
+@param s      compressed stream
+@param flush  deflate() flushing method
+@return deflate() status: Z_OK, Z_BUF_ERROR, ... */
+static int page_zip_deflate(page_zip_stream_t *s, int flush)
+{
+  if (!s->raw)
+    return deflate(s, flush);
+
+  ut_ad(s->raw_len + s->avail_in <= srv_page_size);
+  memcpy(s->raw + s->raw_len, s->next_in, s->avail_in);
+  s->raw_len+= s->avail_in;
+  s->next_in+= s->avail_in;
+  s->total_in+= s->avail_in;
+  s->avail_in= 0;
+
+  if (flush == Z_FULL_FLUSH)
+    s->raw_fields= s->raw_len;
+  if (flush != Z_FINISH)
+    return Z_OK;
+  if (s->avail_out <= PAGE_ZIP_LZ4_HEADER)
+    return Z_BUF_ERROR;
+
+  int len= LZ4_compress_default(reinterpret_cast<const char*>(s->raw),
+                                reinterpret_cast<char*>
+                                (s->next_out + PAGE_ZIP_LZ4_HEADER),
+                                int(s->raw_len),
+                                int(s->avail_out - PAGE_ZIP_LZ4_HEADER));
+  if (len <= 0)
+    return Z_BUF_ERROR;
+
+  s->next_out[0]= PAGE_ZIP_LZ4_MAGIC;
+  mach_write_to_2(s->next_out + 1, s->raw_fields);
+  mach_write_to_2(s->next_out + 3, s->raw_len);
+  mach_write_to_2(s->next_out + 5, len);
+  len+= int(PAGE_ZIP_LZ4_HEADER);
+  s->next_out+= len;
+  s->avail_out-= uInt(len);
+  s->total_out+= uLong(len);
+  return Z_STREAM_END;
+}
+
+/** Wrapper for deflateEnd().
+@param s      compressed stream
+@return deflateEnd() status */
+static int page_zip_deflate_end(page_zip_stream_t *s)
+{
+  return s->raw ? Z_OK : deflateEnd(s);
+}
+
+/** Decompress the LZ4 payload of a page.
+@param s      stream whose next_in points to PAGE_ZIP_LZ4_MAGIC
+@param heap   memory heap for the payload
+@return whether the payload was decompressed */
+static bool page_zip_lz4_decompress(page_zip_stream_t *s, mem_heap_t *heap)
+{
+  static char msg[]= "LZ4";
+  s->msg= msg;
+  if (s->avail_in < PAGE_ZIP_LZ4_HEADER)
+    return false;
+  const byte *h= s->next_in;
+  const ulint fields= mach_read_from_2(h + 1);
+  const ulint len= mach_read_from_2(h + 3);
+  const ulint c= mach_read_from_2(h + 5);
+  if (fields > len || len > srv_page_size - PAGE_ZIP_START ||
+      c > s->avail_in - PAGE_ZIP_LZ4_HEADER)
+    return false;
+  s->raw= static_cast<byte*>(mem_heap_alloc(heap, len + 1));
+  if (LZ4_decompress_safe(reinterpret_cast<const char*>
+                          (h + PAGE_ZIP_LZ4_HEADER),
+                          reinterpret_cast<char*>(s->raw),
+                          int(c), int(len)) != int(len))
+    return false;
+  s->raw_len= len;
+  s->raw_fields= fields;
+  s->raw_pos= 0;
+  s->next_in+= PAGE_ZIP_LZ4_HEADER + c;
+  s->avail_in-= uInt(PAGE_ZIP_LZ4_HEADER + c);
+  s->total_in= uLong(PAGE_ZIP_LZ4_HEADER + c);
+  s->total_out= 0;
+  MONITOR_INC(MONITOR_PAGE_DECOMPRESS_LZ4);
+  return true;
+}
+
+/** Wrapper for inflate().
+@param s      compressed stream
+@param flush  inflate() flushing method
+@return inflate() status: Z_OK, Z_STREAM_END, Z_BUF_ERROR, ... */
+static int page_zip_inflate(page_zip_stream_t *s, int flush)
+{
+  if (!s->raw)
+    return inflate(s, flush);
+
+  /* Z_BLOCK is only used for reading the index information. */
+  const ulint end= flush == Z_BLOCK ? s->raw_fields : s->raw_len;
+  ut_ad(s->raw_pos <= end);
+  const ulint n= std::min<ulint>(s->avail_out, end - s->raw_pos);
+  memcpy(s->next_out, s->raw + s->raw_pos, n);
+  s->raw_pos+= n;
+  s->next_out+= n;
+  s->avail_out-= uInt(n);
+  s->total_out+= uLong(n);
+
+  if (flush == Z_BLOCK)
+    return Z_OK;
+  if (s->raw_pos == s->raw_len)
+    return Z_STREAM_END;
+  return n ? Z_OK : Z_BUF_ERROR;
+}
+
+/** Wrapper for inflateEnd().
+@param s      compressed stream
+@return inflateEnd() status */
+static int page_zip_inflate_end(page_zip_stream_t *s)
+{
+  return s->raw ? Z_OK : inflateEnd(s);
+}
+
 #if 0 || defined UNIV_DEBUG || defined UNIV_ZIP_DEBUG
 /** Symbol for enabling compression and decompression diagnostics */
 # define PAGE_ZIP_COMPRESS_DBG
@@ -823,7 +969,7 @@ int
 page_zip_compress_deflate(
 /*======================*/
 	FILE*		logfile,/*!< in: log file, or NULL */
-	z_streamp	strm,	/*!< in/out: compressed stream for deflate() */
+	page_zip_stream_t* strm,/*!< in/out: compressed stream */
 	int		flush)	/*!< in: deflate() flushing method */
 {
 	int	status;
@@ -836,26 +982,26 @@ page_zip_compress_deflate(
 			perror("fwrite");
 		}
 	}
-	status = deflate(strm, flush);
+	status = page_zip_deflate(strm, flush);
 	if (UNIV_UNLIKELY(page_zip_compress_dbg)) {
 		fprintf(stderr, " -> %d\n", status);
 	}
 	return(status);
 }
 
-/* Redefine deflate(). */
-# undef deflate
-/** Debug wrapper for the zlib compression routine deflate().
-Log the operation if page_zip_compress_dbg is set.
-@param strm in/out: compressed stream
-@param flush in: flushing method
-@return deflate() status: Z_OK, Z_BUF_ERROR, ... */
-# define deflate(strm, flush) page_zip_compress_deflate(logfile, strm, flush)
 /** Declaration of the logfile parameter */
 # define FILE_LOGFILE FILE* logfile,
 /** The logfile parameter */
 # define LOGFILE logfile,
 #else /* PAGE_ZIP_COMPRESS_DBG */
+/** Wrapper for deflate().
+@param strm   compressed stream
+@param flush  deflate() flushing method
+@return deflate() status: Z_OK, Z_BUF_ERROR, ... */
+static inline int page_zip_compress_deflate(page_zip_stream_t *strm, int flush)
+{
+  return page_zip_deflate(strm, flush);
+}
 /** Empty declaration of the logfile parameter */
 # define FILE_LOGFILE
 /** Missing logfile parameter */
@@ -870,7 +1016,7 @@ int
 page_zip_compress_node_ptrs(
 /*========================*/
 	FILE_LOGFILE
-	z_stream*	c_stream,	/*!< in/out: compressed page stream */
+	page_zip_stream_t* c_stream,/*!< in/out: compressed page stream */
 	const rec_t**	recs,		/*!< in: dense page directory
 					sorted by address */
 	ulint		n_dense,	/*!< in: size of recs[] */
@@ -898,7 +1044,7 @@ page_zip_compress_node_ptrs(
 			rec - REC_N_NEW_EXTRA_BYTES - c_stream->next_in);
 
 		if (c_stream->avail_in) {
-			err = deflate(c_stream, Z_NO_FLUSH);
+			err = page_zip_compress_deflate(LOGFILE c_stream, Z_NO_FLUSH);
 			if (UNIV_UNLIKELY(err != Z_OK)) {
 				break;
 			}
@@ -911,7 +1057,7 @@ page_zip_compress_node_ptrs(
 			rec_offs_data_size(offsets) - REC_NODE_PTR_SIZE);
 
 		if (c_stream->avail_in) {
-			err = deflate(c_stream, Z_NO_FLUSH);
+			err = page_zip_compress_deflate(LOGFILE c_stream, Z_NO_FLUSH);
 			if (UNIV_UNLIKELY(err != Z_OK)) {
 				break;
 			}
@@ -936,7 +1082,7 @@ int
 page_zip_compress_sec(
 /*==================*/
 	FILE_LOGFILE
-	z_stream*	c_stream,	/*!< in/out: compressed page stream */
+	page_zip_stream_t* c_stream,/*!< in/out: compressed page stream */
 	const rec_t**	recs,		/*!< in: dense page directory
 					sorted by address */
 	ulint		n_dense)	/*!< in: size of recs[] */
@@ -956,7 +1102,7 @@ page_zip_compress_sec(
 		if (UNIV_LIKELY(c_stream->avail_in != 0)) {
 			MEM_CHECK_DEFINED(c_stream->next_in,
 					  c_stream->avail_in);
-			err = deflate(c_stream, Z_NO_FLUSH);
+			err = page_zip_compress_deflate(LOGFILE c_stream, Z_NO_FLUSH);
 			if (UNIV_UNLIKELY(err != Z_OK)) {
 				break;
 			}
@@ -982,7 +1128,7 @@ int
 page_zip_compress_clust_ext(
 /*========================*/
 	FILE_LOGFILE
-	z_stream*	c_stream,	/*!< in/out: compressed page stream */
+	page_zip_stream_t* c_stream,/*!< in/out: compressed page stream */
 	const rec_t*	rec,		/*!< in: record */
 	const rec_offs*	offsets,	/*!< in: rec_get_offsets(rec) */
 	ulint		trx_id_col,	/*!< in: position of of DB_TRX_ID */
@@ -1020,7 +1166,8 @@ page_zip_compress_clust_ext(
 				src - c_stream->next_in);
 
 			if (c_stream->avail_in) {
-				err = deflate(c_stream, Z_NO_FLUSH);
+				err = page_zip_compress_deflate(
+					LOGFILE c_stream, Z_NO_FLUSH);
 				if (UNIV_UNLIKELY(err != Z_OK)) {
 
 					return(err);
@@ -1049,7 +1196,8 @@ page_zip_compress_clust_ext(
 			c_stream->avail_in = static_cast<uInt>(
 				src - c_stream->next_in);
 			if (UNIV_LIKELY(c_stream->avail_in != 0)) {
-				err = deflate(c_stream, Z_NO_FLUSH);
+				err = page_zip_compress_deflate(
+					LOGFILE c_stream, Z_NO_FLUSH);
 				if (UNIV_UNLIKELY(err != Z_OK)) {
 
 					return(err);
@@ -1109,7 +1257,7 @@ int
 page_zip_compress_clust(
 /*====================*/
 	FILE_LOGFILE
-	z_stream*	c_stream,	/*!< in/out: compressed page stream */
+	page_zip_stream_t* c_stream,/*!< in/out: compressed page stream */
 	const rec_t**	recs,		/*!< in: dense page directory
 					sorted by address */
 	ulint		n_dense,	/*!< in: size of recs[] */
@@ -1147,7 +1295,7 @@ page_zip_compress_clust(
 			- c_stream->next_in);
 
 		if (c_stream->avail_in) {
-			err = deflate(c_stream, Z_NO_FLUSH);
+			err = page_zip_compress_deflate(LOGFILE c_stream, Z_NO_FLUSH);
 			if (UNIV_UNLIKELY(err != Z_OK)) {
 
 				goto func_exit;
@@ -1195,7 +1343,8 @@ page_zip_compress_clust(
 				src - c_stream->next_in);
 
 			if (c_stream->avail_in) {
-				err = deflate(c_stream, Z_NO_FLUSH);
+				err = page_zip_compress_deflate(
+					LOGFILE c_stream, Z_NO_FLUSH);
 				if (UNIV_UNLIKELY(err != Z_OK)) {
 
 					return(err);
@@ -1223,7 +1372,7 @@ page_zip_compress_clust(
 			rec + rec_offs_data_size(offsets) - c_stream->next_in);
 
 		if (c_stream->avail_in) {
-			err = deflate(c_stream, Z_NO_FLUSH);
+			err = page_zip_compress_deflate(LOGFILE c_stream, Z_NO_FLUSH);
 			if (UNIV_UNLIKELY(err != Z_OK)) {
 
 				goto func_exit;
@@ -1245,7 +1394,7 @@ page_zip_compress(
 	ulint			level,	/*!< in: commpression level */
 	mtr_t*			mtr)	/*!< in/out: mini-transaction */
 {
-	z_stream		c_stream;
+	page_zip_stream_t	c_stream;
 	int			err;
 	byte*			fields;		/*!< index field information */
 	byte*			buf;		/*!< compressed payload of the
@@ -1261,6 +1410,8 @@ page_zip_compress(
 	ulint			n_blobs	= 0;
 	byte*			storage;	/* storage of uncompressed
 						columns */
+	bool			lz4;		/* whether PAGE_ZIP_LZ4
+						is being used */
 	const ulonglong		ns = my_interval_timer();
 #ifdef PAGE_ZIP_COMPRESS_DBG
 	FILE*			logfile = NULL;
@@ -1351,6 +1502,13 @@ page_zip_compress(
 
 	MONITOR_INC(MONITOR_PAGE_COMPRESS);
 
+	/* LZ4 is only used if the provider plugin is loaded.
+	Decompression can handle any mix of algorithms. */
+	lz4 = (index->table->flags2 & DICT_TF2_ZIP_LZ4)
+		&& provider_service_lz4->is_loaded;
+compress:
+	/* Reset the output of a failed LZ4 attempt */
+	n_blobs = 0;
 	heap = mem_heap_create(page_zip_get_size(page_zip)
 			       + n_fields * (2 + sizeof(ulint))
 			       + REC_OFFS_HEADER_SIZE
@@ -1372,10 +1530,21 @@ page_zip_compress(
 	/* Compress the data payload. */
 	page_zip_set_alloc(&c_stream, heap);
 
-	err = deflateInit2(&c_stream, static_cast<int>(level),
-			   Z_DEFLATED, static_cast<int>(srv_page_size_shift),
-			   MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY);
-	ut_a(err == Z_OK);
+	if (lz4) {
+		c_stream.raw = static_cast<byte*>(
+			mem_heap_alloc(heap, srv_page_size));
+		c_stream.raw_len = 0;
+		c_stream.raw_fields = 0;
+		c_stream.total_in = 0;
+		c_stream.total_out = 0;
+	} else {
+		c_stream.raw = NULL;
+		err = deflateInit2(&c_stream, static_cast<int>(level),
+				   Z_DEFLATED,
+				   static_cast<int>(srv_page_size_shift),
+				   MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY);
+		ut_a(err == Z_OK);
+	}
 
 	c_stream.next_out = buf;
 
@@ -1417,7 +1586,7 @@ page_zip_compress(
 	}
 
 	MEM_CHECK_DEFINED(c_stream.next_in, c_stream.avail_in);
-	err = deflate(&c_stream, Z_FULL_FLUSH);
+	err = page_zip_compress_deflate(LOGFILE &c_stream, Z_FULL_FLUSH);
 	if (err != Z_OK) {
 		goto zlib_error;
 	}
@@ -1471,12 +1640,22 @@ page_zip_compress(
 	ut_a(c_stream.avail_in <= srv_page_size - PAGE_ZIP_START - PAGE_DIR);
 
 	MEM_CHECK_DEFINED(c_stream.next_in, c_stream.avail_in);
-	err = deflate(&c_stream, Z_FINISH);
+	err = page_zip_compress_deflate(LOGFILE &c_stream, Z_FINISH);
+	DBUG_EXECUTE_IF("page_zip_compress_lz4_fail",
+			if (lz4) err = Z_BUF_ERROR;);
 
 	if (UNIV_UNLIKELY(err != Z_STREAM_END)) {
 zlib_error:
-		deflateEnd(&c_stream);
+		page_zip_deflate_end(&c_stream);
 		mem_heap_free(heap);
+		if (lz4 && n_dense <= 2) {
+			/* page_zip_empty_size() assumes that zlib is
+			being used. A page with one or two records must
+			always be compressible, to prevent infinite
+			page splits. */
+			lz4 = false;
+			goto compress;
+		}
 err_exit:
 #ifdef PAGE_ZIP_COMPRESS_DBG
 		if (logfile) {
@@ -1499,9 +1678,13 @@ page_zip_compress(
 		return false;
 	}
 
-	err = deflateEnd(&c_stream);
+	err = page_zip_deflate_end(&c_stream);
 	ut_a(err == Z_OK);
 
+	if (lz4) {
+		MONITOR_INC(MONITOR_PAGE_COMPRESS_LZ4);
+	}
+
 	ut_ad(buf + c_stream.total_out == c_stream.next_out);
 	ut_ad((ulint) (storage - c_stream.next_out) >= c_stream.avail_out);
 
@@ -2205,7 +2388,7 @@ static
 ibool
 page_zip_decompress_heap_no(
 /*========================*/
-	z_stream*	d_stream,	/*!< in/out: compressed page stream */
+	page_zip_stream_t* d_stream,/*!< in/out: compressed page stream */
 	rec_t*		rec,		/*!< in/out: record */
 	ulint&		heap_status)	/*!< in/out: heap_no and status bits */
 {
@@ -2231,7 +2414,7 @@ ibool
 page_zip_decompress_node_ptrs(
 /*==========================*/
 	page_zip_des_t*	page_zip,	/*!< in/out: compressed page */
-	z_stream*	d_stream,	/*!< in/out: compressed page stream */
+	page_zip_stream_t* d_stream,/*!< in/out: compressed page stream */
 	rec_t**		recs,		/*!< in: dense page directory
 					sorted by address */
 	ulint		n_dense,	/*!< in: size of recs[] */
@@ -2257,7 +2440,7 @@ page_zip_decompress_node_ptrs(
 
 		ut_ad(d_stream->avail_out < srv_page_size
 		      - PAGE_ZIP_START - PAGE_DIR);
-		switch (inflate(d_stream, Z_SYNC_FLUSH)) {
+		switch (page_zip_inflate(d_stream, Z_SYNC_FLUSH)) {
 		case Z_STREAM_END:
 			page_zip_decompress_heap_no(
 				d_stream, rec, heap_status);
@@ -2292,7 +2475,7 @@ page_zip_decompress_node_ptrs(
 		d_stream->avail_out =static_cast<uInt>(
 			rec_offs_data_size(offsets) - REC_NODE_PTR_SIZE);
 
-		switch (inflate(d_stream, Z_SYNC_FLUSH)) {
+		switch (page_zip_inflate(d_stream, Z_SYNC_FLUSH)) {
 		case Z_STREAM_END:
 			goto zlib_done;
 		case Z_OK:
@@ -2331,12 +2514,12 @@ page_zip_decompress_node_ptrs(
 		goto zlib_error;
 	}
 
-	if (UNIV_UNLIKELY(inflate(d_stream, Z_FINISH) != Z_STREAM_END)) {
+	if (UNIV_UNLIKELY(page_zip_inflate(d_stream, Z_FINISH) != Z_STREAM_END)) {
 		page_zip_fail(("page_zip_decompress_node_ptrs:"
 			       " inflate(Z_FINISH)=%s\n",
 			       d_stream->msg));
 zlib_error:
-		inflateEnd(d_stream);
+		page_zip_inflate_end(d_stream);
 		return(FALSE);
 	}
 
@@ -2344,7 +2527,7 @@ page_zip_decompress_node_ptrs(
 	if the modification log is nonempty. */
 
 zlib_done:
-	if (UNIV_UNLIKELY(inflateEnd(d_stream) != Z_OK)) {
+	if (UNIV_UNLIKELY(page_zip_inflate_end(d_stream) != Z_OK)) {
 		ut_error;
 	}
 
@@ -2421,7 +2604,7 @@ ibool
 page_zip_decompress_sec(
 /*====================*/
 	page_zip_des_t*	page_zip,	/*!< in/out: compressed page */
-	z_stream*	d_stream,	/*!< in/out: compressed page stream */
+	page_zip_stream_t* d_stream,/*!< in/out: compressed page stream */
 	rec_t**		recs,		/*!< in: dense page directory
 					sorted by address */
 	ulint		n_dense,	/*!< in: size of recs[] */
@@ -2446,7 +2629,7 @@ page_zip_decompress_sec(
 			rec - REC_N_NEW_EXTRA_BYTES - d_stream->next_out);
 
 		if (UNIV_LIKELY(d_stream->avail_out)) {
-			switch (inflate(d_stream, Z_SYNC_FLUSH)) {
+			switch (page_zip_inflate(d_stream, Z_SYNC_FLUSH)) {
 			case Z_STREAM_END:
 				page_zip_decompress_heap_no(
 					d_stream, rec, heap_status);
@@ -2486,12 +2669,12 @@ page_zip_decompress_sec(
 		goto zlib_error;
 	}
 
-	if (UNIV_UNLIKELY(inflate(d_stream, Z_FINISH) != Z_STREAM_END)) {
+	if (UNIV_UNLIKELY(page_zip_inflate(d_stream, Z_FINISH) != Z_STREAM_END)) {
 		page_zip_fail(("page_zip_decompress_sec:"
 			       " inflate(Z_FINISH)=%s\n",
 			       d_stream->msg));
 zlib_error:
-		inflateEnd(d_stream);
+		page_zip_inflate_end(d_stream);
 		return(FALSE);
 	}
 
@@ -2499,7 +2682,7 @@ page_zip_decompress_sec(
 	if the modification log is nonempty. */
 
 zlib_done:
-	if (UNIV_UNLIKELY(inflateEnd(d_stream) != Z_OK)) {
+	if (UNIV_UNLIKELY(page_zip_inflate_end(d_stream) != Z_OK)) {
 		ut_error;
 	}
 
@@ -2558,7 +2741,7 @@ static
 ibool
 page_zip_decompress_clust_ext(
 /*==========================*/
-	z_stream*	d_stream,	/*!< in/out: compressed page stream */
+	page_zip_stream_t* d_stream,/*!< in/out: compressed page stream */
 	rec_t*		rec,		/*!< in/out: record */
 	const rec_offs*	offsets,	/*!< in: rec_get_offsets(rec) */
 	ulint		trx_id_col)	/*!< in: position of of DB_TRX_ID */
@@ -2592,7 +2775,7 @@ page_zip_decompress_clust_ext(
 			d_stream->avail_out = static_cast<uInt>(
 				dst - d_stream->next_out);
 
-			switch (inflate(d_stream, Z_SYNC_FLUSH)) {
+			switch (page_zip_inflate(d_stream, Z_SYNC_FLUSH)) {
 			case Z_STREAM_END:
 			case Z_OK:
 			case Z_BUF_ERROR:
@@ -2623,7 +2806,7 @@ page_zip_decompress_clust_ext(
 
 			d_stream->avail_out = static_cast<uInt>(
 				dst - d_stream->next_out);
-			switch (inflate(d_stream, Z_SYNC_FLUSH)) {
+			switch (page_zip_inflate(d_stream, Z_SYNC_FLUSH)) {
 			case Z_STREAM_END:
 			case Z_OK:
 			case Z_BUF_ERROR:
@@ -2669,7 +2852,7 @@ ibool
 page_zip_decompress_clust(
 /*======================*/
 	page_zip_des_t*	page_zip,	/*!< in/out: compressed page */
-	z_stream*	d_stream,	/*!< in/out: compressed page stream */
+	page_zip_stream_t* d_stream,/*!< in/out: compressed page stream */
 	rec_t**		recs,		/*!< in: dense page directory
 					sorted by address */
 	ulint		n_dense,	/*!< in: size of recs[] */
@@ -2700,7 +2883,7 @@ page_zip_decompress_clust(
 
 		ut_ad(d_stream->avail_out < srv_page_size
 		      - PAGE_ZIP_START - PAGE_DIR);
-		err = inflate(d_stream, Z_SYNC_FLUSH);
+		err = page_zip_inflate(d_stream, Z_SYNC_FLUSH);
 		switch (err) {
 		case Z_STREAM_END:
 			page_zip_decompress_heap_no(
@@ -2757,7 +2940,7 @@ page_zip_decompress_clust(
 			d_stream->avail_out = static_cast<uInt>(
 				dst - d_stream->next_out);
 
-			switch (inflate(d_stream, Z_SYNC_FLUSH)) {
+			switch (page_zip_inflate(d_stream, Z_SYNC_FLUSH)) {
 			case Z_STREAM_END:
 			case Z_OK:
 			case Z_BUF_ERROR:
@@ -2787,7 +2970,7 @@ page_zip_decompress_clust(
 		d_stream->avail_out = static_cast<uInt>(
 			rec_get_end(rec, offsets) - d_stream->next_out);
 
-		switch (inflate(d_stream, Z_SYNC_FLUSH)) {
+		switch (page_zip_inflate(d_stream, Z_SYNC_FLUSH)) {
 		case Z_STREAM_END:
 		case Z_OK:
 		case Z_BUF_ERROR:
@@ -2817,12 +3000,12 @@ page_zip_decompress_clust(
 		goto zlib_error;
 	}
 
-	if (UNIV_UNLIKELY(inflate(d_stream, Z_FINISH) != Z_STREAM_END)) {
+	if (UNIV_UNLIKELY(page_zip_inflate(d_stream, Z_FINISH) != Z_STREAM_END)) {
 		page_zip_fail(("page_zip_decompress_clust:"
 			       " inflate(Z_FINISH)=%s\n",
 			       d_stream->msg));
 zlib_error:
-		inflateEnd(d_stream);
+		page_zip_inflate_end(d_stream);
 		return(FALSE);
 	}
 
@@ -2830,7 +3013,7 @@ page_zip_decompress_clust(
 	if the modification log is nonempty. */
 
 zlib_done:
-	if (UNIV_UNLIKELY(inflateEnd(d_stream) != Z_OK)) {
+	if (UNIV_UNLIKELY(page_zip_inflate_end(d_stream) != Z_OK)) {
 		ut_error;
 	}
 
@@ -2974,7 +3157,7 @@ page_zip_decompress_low(
 				page header fields that should not change
 				after page creation */
 {
-	z_stream	d_stream;
+	page_zip_stream_t d_stream;
 	dict_index_t*	index	= NULL;
 	rec_t**		recs;	/*!< dense page directory, sorted by address */
 	ulint		n_dense;/* number of user records on the page */
@@ -3067,20 +3250,28 @@ page_zip_decompress_low(
 	d_stream.next_out = page + PAGE_ZIP_START;
 	d_stream.avail_out = uInt(srv_page_size - PAGE_ZIP_START);
 
-	if (UNIV_UNLIKELY(inflateInit2(&d_stream, int(srv_page_size_shift))
-			  != Z_OK)) {
+	if (*d_stream.next_in == PAGE_ZIP_LZ4_MAGIC) {
+		if (UNIV_UNLIKELY(!page_zip_lz4_decompress(&d_stream,
+							   heap))) {
+			page_zip_fail(("page_zip_decompress:"
+				       " LZ4_decompress_safe()\n"));
+			goto zlib_error;
+		}
+	} else if (UNIV_UNLIKELY(inflateInit2(&d_stream,
+					      int(srv_page_size_shift))
+				 != Z_OK)) {
 		ut_error;
 	}
 
 	/* Decode the zlib header and the index information. */
-	if (UNIV_UNLIKELY(inflate(&d_stream, Z_BLOCK) != Z_OK)) {
+	if (UNIV_UNLIKELY(page_zip_inflate(&d_stream, Z_BLOCK) != Z_OK)) {
 
 		page_zip_fail(("page_zip_decompress:"
 			       " 1 inflate(Z_BLOCK)=%s\n", d_stream.msg));
 		goto zlib_error;
 	}
 
-	if (UNIV_UNLIKELY(inflate(&d_stream, Z_BLOCK) != Z_OK)) {
+	if (UNIV_UNLIKELY(page_zip_inflate(&d_stream, Z_BLOCK) != Z_OK)) {
 
 		page_zip_fail(("page_zip_decompress:"
 			       " 2 inflate(Z_BLOCK)=%s\n", d_stream.msg));
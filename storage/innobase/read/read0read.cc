@@ -26,6 +26,8 @@ Created 2/16/1997 Heikki Tuuri
 
 #include "read0types.h"
 
+#include "row0vers.h"
+#include "srv0mon.h"
 #include "srv0srv.h"
 #include "trx0sys.h"
 #include "trx0purge.h"
@@ -172,23 +174,63 @@ For details see: row_vers_old_has_index_entry() and row_purge_poss_sec()
 */
 inline void ReadViewBase::snapshot(trx_t *trx)
 {
+  uint64_t generation;
+  if (trx_sys.get_snapshot(this, &generation))
+  {
+    if (trx)
+      MONITOR_INC(MONITOR_TRX_SNAPSHOTS_REUSED);
+    return;
+  }
+
   trx_sys.snapshot_ids(trx, &m_ids, &m_low_limit_id, &m_low_limit_no);
   if (m_ids.empty())
-  {
     m_up_limit_id= m_low_limit_id;
-    return;
+  else
+  {
+    std::sort(m_ids.begin(), m_ids.end());
+    m_up_limit_id= m_ids.front();
+    ut_ad(m_up_limit_id <= m_low_limit_id);
+
+    if (m_low_limit_no == m_low_limit_id &&
+        m_low_limit_id == m_up_limit_id + m_ids.size())
+    {
+      m_ids.clear();
+      m_low_limit_id= m_low_limit_no= m_up_limit_id;
+    }
   }
 
-  std::sort(m_ids.begin(), m_ids.end());
-  m_up_limit_id= m_ids.front();
-  ut_ad(m_up_limit_id <= m_low_limit_id);
+  trx_sys.put_snapshot(*this, generation);
+}
+
 
-  if (m_low_limit_no == m_low_limit_id &&
-      m_low_limit_id == m_up_limit_id + m_ids.size())
+bool trx_sys_t::get_snapshot(ReadViewBase *view, uint64_t *generation)
+{
+  *generation= m_snapshot_generation.load(std::memory_order_acquire);
+  if (m_snapshot_cached.load(std::memory_order_relaxed) != *generation)
+    return false;
+  m_snapshot_latch.rd_lock();
+  const bool found=
+    m_snapshot_cached.load(std::memory_order_relaxed) == *generation;
+  if (found)
+    *view= m_snapshot;
+  m_snapshot_latch.rd_unlock();
+  return found;
+}
+
+
+void trx_sys_t::put_snapshot(const ReadViewBase &view, uint64_t generation)
+{
+  /* If a transaction was deregistered meanwhile, the snapshot may already
+  be outdated. If another thread is storing a snapshot, let it do so. */
+  if (generation != m_snapshot_generation.load(std::memory_order_relaxed) ||
+      !m_snapshot_latch.wr_lock_try())
+    return;
+  if (m_snapshot_cached.load(std::memory_order_relaxed) < generation)
   {
-    m_ids.clear();
-    m_low_limit_id= m_low_limit_no= m_up_limit_id;
+    m_snapshot= view;
+    m_snapshot_cached.store(generation, std::memory_order_relaxed);
   }
+  m_snapshot_latch.wr_unlock();
 }
 
 
@@ -239,6 +281,8 @@ void ReadView::open(trx_t *trx)
       m_open.store(true, std::memory_order_relaxed);
     else
     {
+      if (trx->vers_cache)
+        trx->vers_cache->clear();
       m_mutex.wr_lock();
       snapshot(trx);
       m_open.store(true, std::memory_order_relaxed);
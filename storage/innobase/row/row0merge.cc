@@ -44,8 +44,11 @@ Completed by Sunny Bains and Marko Makela
 #include "row0ftsort.h"
 #include "row0import.h"
 #include "row0vers.h"
+#include "row0pread.h"
 #include "handler0alter.h"
 #include "btr0bulk.h"
+#include "gis0geo.h"
+#include "gis0rtree.h"
 #ifdef BTR_CUR_ADAPT
 # include "btr0sea.h"
 #endif /* BTR_CUR_ADAPT */
@@ -61,186 +64,101 @@ Completed by Sunny Bains and Marko Makela
 /* Whether to disable file system cache */
 char	srv_disable_sort_file_cache;
 
-/** Class that caches spatial index row tuples made from a single cluster
-index page scan, and then insert into corresponding index tree */
-class spatial_index_info {
-public:
-  /** constructor
-  @param index	spatial index to be created */
-  spatial_index_info(dict_index_t *index) : index(index)
-  {
-    ut_ad(index->is_spatial());
-  }
-
-  /** Caches an index row into index tuple vector
-  @param[in]	row	table row
-  @param[in]	ext	externally stored column prefixes, or NULL */
-  void add(const dtuple_t *row, const row_ext_t *ext, mem_heap_t *heap)
-  {
-    dtuple_t *dtuple= row_build_index_entry(row, ext, index, heap);
-    ut_ad(dtuple);
-    ut_ad(dtuple->n_fields == index->n_fields);
-    if (ext)
-    {
-      /* Replace any references to ext, because ext will be allocated
-      from row_heap. */
-      for (ulint i= 1; i < dtuple->n_fields; i++)
-      {
-        dfield_t &dfield= dtuple->fields[i];
-        if (dfield.data >= ext->buf &&
-            dfield.data <= &ext->buf[ext->n_ext * ext->max_len])
-          dfield_dup(&dfield, heap);
-      }
-    }
-    m_dtuple_vec.push_back(dtuple);
-  }
-
-	/** Insert spatial index rows cached in vector into spatial index
-	@param[in]	trx_id		transaction id
-	@param[in]	pcur		cluster index scanning cursor
-	@param[in,out]	mtr_started	whether scan_mtr is active
-	@param[in,out]	heap		temporary memory heap
-	@param[in,out]	scan_mtr	mini-transaction for pcur
-	@return DB_SUCCESS if successful, else error number */
-	dberr_t insert(trx_id_t trx_id, btr_pcur_t* pcur,
-		       bool& mtr_started, mem_heap_t* heap, mtr_t* scan_mtr)
-	{
-		big_rec_t*      big_rec;
-		rec_t*          rec;
-		btr_cur_t       ins_cur;
-		mtr_t           mtr;
-		rtr_info_t      rtr_info;
-		rec_offs*	ins_offsets = NULL;
-		dberr_t		error = DB_SUCCESS;
-		dtuple_t*	dtuple;
-		const ulint	flag = BTR_NO_UNDO_LOG_FLAG
-				       | BTR_NO_LOCKING_FLAG
-				       | BTR_KEEP_SYS_FLAG | BTR_CREATE_FLAG;
-
-		ut_ad(mtr_started == scan_mtr->is_active());
-
-		DBUG_EXECUTE_IF("row_merge_instrument_log_check_flush",
-				log_sys.set_check_for_checkpoint(););
-
-		for (idx_tuple_vec::iterator it = m_dtuple_vec.begin();
-		     it != m_dtuple_vec.end();
-		     ++it) {
-			dtuple = *it;
-			ut_ad(dtuple);
-
-			if (log_sys.check_for_checkpoint()) {
-				if (mtr_started) {
-					if (!btr_pcur_move_to_prev_on_page(pcur)) {
-						error = DB_CORRUPTION;
-						break;
-					}
-					btr_pcur_store_position(pcur, scan_mtr);
-					scan_mtr->commit();
-					mtr_started = false;
-				}
-
-				log_free_check();
-			}
-
-			mtr.start();
-			index->set_modified(mtr);
-
-			ins_cur.page_cur.index = index;
-			rtr_init_rtr_info(&rtr_info, false, &ins_cur, index,
-					  false);
-			rtr_info_update_btr(&ins_cur, &rtr_info);
-
-			error = rtr_insert_leaf(&ins_cur, nullptr, dtuple,
-						BTR_MODIFY_LEAF, &mtr);
-
-			/* It need to update MBR in parent entry,
-			so change search mode to BTR_MODIFY_TREE */
-			if (error == DB_SUCCESS && rtr_info.mbr_adj) {
-				mtr.commit();
-				rtr_clean_rtr_info(&rtr_info, true);
-				rtr_init_rtr_info(&rtr_info, false, &ins_cur,
-						  index, false);
-				rtr_info_update_btr(&ins_cur, &rtr_info);
-				mtr.start();
-				index->set_modified(mtr);
-				error = rtr_insert_leaf(&ins_cur, nullptr,
-							dtuple,
-							BTR_MODIFY_TREE, &mtr);
-			}
-
-			if (error == DB_SUCCESS) {
-				error = btr_cur_optimistic_insert(
-					flag, &ins_cur, &ins_offsets,
-					&heap, dtuple, &rec, &big_rec,
-					0, NULL, &mtr);
-			}
-
-			ut_ad(!big_rec);
-
-			if (error == DB_FAIL) {
-				mtr.commit();
-				mtr.start();
-				index->set_modified(mtr);
+/** Create a temporary index for sorting the records of a SPATIAL INDEX.
+The first field is the position of the centre of the MBR on a Hilbert
+curve, followed by the fields of the spatial index. Sorting by it lets
+BtrBulk pack nearby objects into the same R-tree pages.
+@param index  spatial index to be created
+@return the sort index */
+static dict_index_t *row_merge_create_spatial_sort_index(dict_index_t *index)
+{
+  ut_ad(index->is_spatial());
+  dict_index_t *sort_index=
+    dict_mem_index_create(index->table, "tmp_spatial_idx", 0,
+                          index->n_fields + 1);
+  sort_index->id= index->id;
+  sort_index->n_uniq= sort_index->n_fields;
+  sort_index->n_def= sort_index->n_fields;
+  sort_index->n_nullable= index->n_nullable;
+  sort_index->n_core_null_bytes= index->n_core_null_bytes;
+  sort_index->cached= true;
+
+  dict_field_t *field= dict_index_get_nth_field(sort_index, 0);
+  field->name= nullptr;
+  field->prefix_len= 0;
+  field->descending= false;
+  field->col= static_cast<dict_col_t*>
+    (mem_heap_zalloc(sort_index->heap, sizeof(dict_col_t)));
+  field->col->mtype= DATA_INT;
+  field->col->prtype= DATA_NOT_NULL | DATA_UNSIGNED;
+  field->col->len= 8;
+  field->fixed_len= 8;
+
+  memcpy(field + 1, index->fields, index->n_fields * sizeof *field);
+  return sort_index;
+}
 
-				rtr_clean_rtr_info(&rtr_info, true);
-				rtr_init_rtr_info(&rtr_info, false,
-						  &ins_cur, index, false);
+/** Insert a SPATIAL INDEX record into a sort buffer of
+row_merge_create_spatial_sort_index().
+@param buf    sort buffer
+@param index  spatial index
+@param row    table row
+@param ext    cache of externally stored column prefixes, or nullptr
+@return number of rows added, 0 if out of space */
+static ulint row_merge_buf_add_spatial(row_merge_buf_t *buf,
+                                       dict_index_t *index,
+                                       const dtuple_t *row,
+                                       const row_ext_t *ext)
+{
+  ut_ad(index->is_spatial());
+  ut_ad(buf->index->n_fields == index->n_fields + 1);
 
-				rtr_info_update_btr(&ins_cur, &rtr_info);
-				error = rtr_insert_leaf(&ins_cur, nullptr,
-							dtuple,
-							BTR_MODIFY_TREE, &mtr);
+  if (buf->n_tuples >= buf->max_tuples)
+    return 0;
 
-				if (error == DB_SUCCESS) {
-					error = btr_cur_pessimistic_insert(
-						flag, &ins_cur, &ins_offsets,
-						&heap, dtuple, &rec,
-						&big_rec, 0, NULL, &mtr);
-				}
-			}
+  const dtuple_t *entry= row_build_index_entry(row, ext, index, buf->heap);
+  ut_ad(entry);
+  ut_ad(entry->n_fields == index->n_fields);
 
-			ut_ad(!big_rec);
+  const ulint n_fields= buf->index->n_fields;
+  mtuple_t *t= &buf->tuples[buf->n_tuples];
+  dfield_t *field= t->fields= static_cast<dfield_t*>
+    (mem_heap_alloc(buf->heap, n_fields * sizeof *field));
 
-			DBUG_EXECUTE_IF(
-				"row_merge_ins_spatial_fail",
-				error = DB_FAIL;
-			);
+  rtr_mbr_t mbr;
+  rtr_read_mbr(static_cast<const byte*>(entry->fields[0].data), &mbr);
+  byte *hilbert= static_cast<byte*>(mem_heap_alloc(buf->heap, 8));
+  mach_write_to_8(hilbert,
+                  rtree_hilbert_value(reinterpret_cast<double*>(&mbr)));
+  dfield_set_data(field, hilbert, 8);
+  memcpy(field + 1, entry->fields, entry->n_fields * sizeof *field);
 
-			if (error == DB_SUCCESS) {
-				if (rtr_info.mbr_adj) {
-					error = rtr_ins_enlarge_mbr(
-							&ins_cur, &mtr);
-				}
+  for (ulint i= 0; i < n_fields; i++)
+    dict_col_copy_type(dict_index_get_nth_field(buf->index, i)->col,
+                       dfield_get_type(&field[i]));
 
-				if (error == DB_SUCCESS) {
-					page_update_max_trx_id(
-						btr_cur_get_block(&ins_cur),
-						btr_cur_get_page_zip(&ins_cur),
-						trx_id, &mtr);
-				}
-			}
+  /* See row_merge_buf_add() and row_merge_buf_encode(). */
+  ulint extra_size;
+  ulint data_size= rec_get_converted_size_temp<false>(buf->index, field,
+                                                      n_fields, &extra_size);
+  data_size+= 1 + ((extra_size + 1) >= 0x80);
 
-			mtr.commit();
+  ut_ad(data_size < srv_sort_buf_size);
 
-			rtr_clean_rtr_info(&rtr_info, true);
-		}
+  /* Reserve bytes for the end marker of row_merge_block_t. */
+  if (buf->total_size + data_size >= srv_sort_buf_size)
+    return 0;
 
-		m_dtuple_vec.clear();
+  buf->total_size+= data_size;
+  buf->n_tuples++;
 
-		return(error);
-	}
+  /* The PRIMARY KEY fields may point to the row, which will be freed
+  before the buffer is written. */
+  for (ulint i= 1; i < n_fields; i++)
+    dfield_dup(&field[i], buf->heap);
 
-private:
-  /** Cache index rows made from a cluster index scan. Usually
-  for rows on single cluster index page */
-  typedef std::vector<dtuple_t*, ut_allocator<dtuple_t*> > idx_tuple_vec;
-
-  /** vector used to cache index rows made from cluster index scan */
-  idx_tuple_vec m_dtuple_vec;
-public:
-  /** the index being built */
-  dict_index_t*const	index;
-};
+  return 1;
+}
 
 /* Maximum pending doc memory limit in bytes for a fts tokenization thread */
 #define FTS_PENDING_DOC_MEMORY_LIMIT	1000000
@@ -1736,37 +1654,6 @@ row_mtuple_cmp(
                              *current_mtuple, *prev_mtuple, dup);
 }
 
-/** Insert cached spatial index rows.
-@param[in]	trx_id		transaction id
-@param[in]	sp_tuples	cached spatial rows
-@param[in]	num_spatial	number of spatial indexes
-@param[in,out]	heap		temporary memory heap
-@param[in,out]	pcur		cluster index cursor
-@param[in,out]	started		whether mtr is active
-@param[in,out]	mtr		mini-transaction
-@return DB_SUCCESS or error number */
-static
-dberr_t
-row_merge_spatial_rows(
-	trx_id_t		trx_id,
-	spatial_index_info**	sp_tuples,
-	ulint			num_spatial,
-	mem_heap_t*		heap,
-	btr_pcur_t*		pcur,
-	bool&			started,
-	mtr_t*			mtr)
-{
-  if (!sp_tuples)
-    return DB_SUCCESS;
-
-  for (ulint j= 0; j < num_spatial; j++)
-    if (dberr_t err= sp_tuples[j]->insert(trx_id, pcur, started, heap, mtr))
-      return err;
-
-  mem_heap_empty(heap);
-  return DB_SUCCESS;
-}
-
 /** Check if the geometry field is valid.
 @param[in]	row		the row
 @param[in]	index		spatial index
@@ -1794,6 +1681,491 @@ row_geo_field_is_valid(
 	return(true);
 }
 
+/** Invoke a function in several threads that use private buffers.
+The calling thread is one of the threads, and it uses the buffers
+that were passed by the caller.
+@tparam Fn		void(row_merge_block_t* block,
+			row_merge_block_t* crypt_block)
+@param[in]	n_threads	number of threads
+@param[in]	size		size of the buffers of each thread
+@param[in,out]	block		buffer of the calling thread
+@param[in,out]	crypt_block	encryption buffer of the calling thread,
+				or NULL if the temporary files are not
+				encrypted
+@param[in]	fn		function to invoke in each thread
+@return DB_SUCCESS or DB_OUT_OF_MEMORY */
+template<typename Fn>
+static
+dberr_t
+row_merge_parallel(
+	ulint			n_threads,
+	size_t			size,
+	row_merge_block_t*	block,
+	row_merge_block_t*	crypt_block,
+	Fn&			fn)
+{
+	struct thread_t {
+		row_merge_block_t*	block;
+		row_merge_block_t*	crypt_block;
+		ut_new_pfx_t		block_pfx;
+		ut_new_pfx_t		crypt_pfx;
+	};
+
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+	std::vector<thread_t>		threads(n_threads - 1);
+	dberr_t				err = DB_SUCCESS;
+
+	for (thread_t& t : threads) {
+		t.block = alloc.allocate_large(size, &t.block_pfx);
+
+		if (t.block && crypt_block) {
+			t.crypt_block = alloc.allocate_large(
+				size, &t.crypt_pfx);
+		}
+
+		if (!t.block || (crypt_block && !t.crypt_block)) {
+			err = DB_OUT_OF_MEMORY;
+		}
+	}
+
+	if (err == DB_SUCCESS) {
+		row_pread_run(n_threads, [&](ulint i) {
+			if (i) {
+				fn(threads[i - 1].block,
+				   threads[i - 1].crypt_block);
+			} else {
+				fn(block, crypt_block);
+			}
+		});
+	}
+
+	for (thread_t& t : threads) {
+		if (t.block) {
+			alloc.deallocate_large(t.block, &t.block_pfx);
+		}
+
+		if (t.crypt_block) {
+			alloc.deallocate_large(t.crypt_block, &t.crypt_pfx);
+		}
+	}
+
+	return(err);
+}
+
+/** Parallel scan of the clustered index for creating secondary indexes
+without rebuilding the table. Each thread scans key ranges of the
+clustered index into its own sort buffers, and writes the sorted
+buffers as runs to the shared merge files. */
+class row_merge_scan_t
+{
+	/** the ALTER TABLE transaction */
+	trx_t* const				m_trx;
+	/** MySQL table object, for reporting duplicate keys */
+	TABLE* const				m_table;
+	/** the table */
+	const dict_table_t* const		m_old_table;
+	/** whether the indexes are being created online */
+	const bool				m_online;
+	/** indexes to be created */
+	dict_index_t** const			m_index;
+	/** temporary files, one per index */
+	merge_file_t* const			m_files;
+	/** MySQL key numbers of the indexes */
+	const ulint* const			m_key_numbers;
+	/** number of indexes */
+	const ulint				m_n_index;
+	/** temporary file handle for row_merge_sort() */
+	pfs_os_file_t* const			m_tmpfd;
+	/** innodb_tmpdir, or NULL */
+	const char* const			m_path;
+	/** columns whose collations changed, or NULL */
+	const col_collations* const		m_col_collate;
+	/** reader of the key ranges of the clustered index */
+	row_pread_t&				m_reader;
+	/** the next range to scan */
+	std::atomic<size_t>			m_next{0};
+	/** protects m_files, m_tmpfd, m_err, m_error_key_num and
+	the duplicate key reporting in m_table */
+	std::mutex				m_mutex;
+	/** the first error */
+	dberr_t					m_err = DB_SUCCESS;
+	/** MySQL key number of the index where m_err occurred */
+	ulint					m_error_key_num = 0;
+
+public:
+	row_merge_scan_t(
+		trx_t*					trx,
+		TABLE*					table,
+		const dict_table_t*			old_table,
+		bool					online,
+		dict_index_t**				index,
+		merge_file_t*				files,
+		const ulint*				key_numbers,
+		ulint					n_index,
+		pfs_os_file_t*				tmpfd,
+		const col_collations*			col_collate,
+		row_pread_t&				reader) :
+		m_trx(trx), m_table(table), m_old_table(old_table),
+		m_online(online), m_index(index), m_files(files),
+		m_key_numbers(key_numbers), m_n_index(n_index),
+		m_tmpfd(tmpfd), m_path(thd_innodb_tmpdir(trx->mysql_thd)),
+		m_col_collate(col_collate), m_reader(reader) {}
+
+	/** Scan the clustered index.
+	@param[in]	n_threads	number of threads
+	@param[in,out]	block		file buffer of the calling thread
+	@param[in,out]	crypt_block	encryption buffer of the calling
+					thread, or NULL
+	@return DB_SUCCESS or error code */
+	dberr_t run(
+		ulint			n_threads,
+		row_merge_block_t*	block,
+		row_merge_block_t*	crypt_block)
+	{
+		auto	fn = [this](row_merge_block_t* b,
+				    row_merge_block_t* c) { scan(b, c); };
+
+		dberr_t	err = row_merge_parallel(
+			std::min<ulint>(n_threads, m_reader.n_ranges()),
+			srv_sort_buf_size, block, crypt_block, fn);
+
+		if (err == DB_SUCCESS) {
+			err = m_err;
+		}
+
+		if (err != DB_SUCCESS) {
+			m_trx->error_key_num = m_error_key_num;
+			return(err);
+		}
+
+		if (m_online) {
+			/* Note the newest transaction that modified
+			each index when the scan was completed. We
+			prevent older readers from accessing the
+			indexes, to ensure read consistency. */
+			for (ulint i = 0; i < m_n_index; i++) {
+				dict_index_t*	index = m_index[i];
+				index->lock.x_lock(SRW_LOCK_CALL);
+				ut_a(dict_index_get_online_status(index)
+				     == ONLINE_INDEX_CREATION);
+
+				trx_id_t max_trx_id = row_log_get_max_trx(
+					index);
+
+				if (max_trx_id > index->trx_id) {
+					index->trx_id = max_trx_id;
+				}
+
+				index->lock.x_unlock();
+			}
+		}
+
+		return(DB_SUCCESS);
+	}
+
+private:
+	/** Note an error.
+	@param[in]	err	error code
+	@param[in]	key_num	MySQL key number of the index */
+	void set_error(dberr_t err, ulint key_num)
+	{
+		std::lock_guard<std::mutex>	lock(m_mutex);
+
+		if (m_err == DB_SUCCESS) {
+			m_err = err;
+			m_error_key_num = key_num;
+		}
+
+		m_reader.abort();
+	}
+
+	/** Scan key ranges until all have been scanned.
+	@param[in,out]	block		file buffer
+	@param[in,out]	crypt_block	encryption buffer, or NULL */
+	void scan(row_merge_block_t* block, row_merge_block_t* crypt_block)
+	{
+		row_merge_buf_t**	buf = static_cast<row_merge_buf_t**>(
+			ut_malloc_nokey(m_n_index * sizeof *buf));
+		ib_uint64_t*		n_rec = static_cast<ib_uint64_t*>(
+			ut_zalloc_nokey(m_n_index * sizeof *n_rec));
+		dberr_t			err = DB_SUCCESS;
+		ulint			i;
+
+		for (i = 0; i < m_n_index; i++) {
+			buf[i] = row_merge_buf_create(m_index[i]);
+		}
+
+		while (!m_reader.aborted()) {
+			const size_t	range = m_next++;
+
+			if (range >= m_reader.n_ranges()) {
+				/* Write the remaining records. */
+				for (i = 0; i < m_n_index; i++) {
+					if (!buf[i]->n_tuples) {
+						continue;
+					}
+
+					err = write(i, buf[i], block,
+						    crypt_block);
+					if (err != DB_SUCCESS) {
+						set_error(err, 0);
+						break;
+					}
+				}
+
+				break;
+			}
+
+			err = scan_range(range, buf, n_rec, block,
+					 crypt_block);
+			if (err != DB_SUCCESS) {
+				set_error(err, 0);
+				break;
+			}
+		}
+
+		m_mutex.lock();
+		for (i = 0; i < m_n_index; i++) {
+			m_files[i].n_rec += n_rec[i];
+			row_merge_buf_free(buf[i]);
+		}
+		m_mutex.unlock();
+
+		ut_free(n_rec);
+		ut_free(buf);
+	}
+
+	/** Sort a buffer and write it as a run to the merge file.
+	@param[in]	i		index number
+	@param[in,out]	buf		sort buffer
+	@param[in,out]	block		file buffer
+	@param[in,out]	crypt_block	encryption buffer, or NULL
+	@return DB_SUCCESS or error code */
+	dberr_t write(
+		ulint			i,
+		row_merge_buf_t*	buf,
+		row_merge_block_t*	block,
+		row_merge_block_t*	crypt_block)
+	{
+		if (dict_index_is_unique(buf->index)) {
+			row_merge_dup_t	dup = {buf->index, NULL, NULL, 0};
+
+			row_merge_buf_sort(buf, &dup);
+
+			if (dup.n_dup) {
+				std::lock_guard<std::mutex>	lock(m_mutex);
+
+				if (m_err == DB_SUCCESS) {
+					/* Sort again, to copy the
+					duplicate key value to m_table. */
+					dup.table = m_table;
+					dup.n_dup = 0;
+					row_merge_buf_sort(buf, &dup);
+					m_err = DB_DUPLICATE_KEY;
+					m_error_key_num = m_key_numbers[i];
+				}
+
+				m_reader.abort();
+				return(DB_DUPLICATE_KEY);
+			}
+		} else {
+			row_merge_buf_sort(buf, NULL);
+		}
+
+		merge_file_t	of;
+		bool		created;
+
+		m_mutex.lock();
+		merge_file_t*	file = &m_files[i];
+		created = row_merge_file_create_if_needed(
+			file, m_tmpfd, file->n_rec, m_path);
+		of = *file;
+		file->offset += created;
+		m_mutex.unlock();
+
+		if (!created) {
+			return(DB_OUT_OF_MEMORY);
+		}
+
+		row_merge_buf_write(buf,
+#ifndef DBUG_OFF
+				    &of,
+#endif
+				    block);
+
+		if (!row_merge_write(of.fd, of.offset, block, crypt_block,
+				     m_old_table->space_id)) {
+			return(DB_TEMP_FILE_WRITE_FAIL);
+		}
+
+		MEM_UNDEFINED(&block[0], srv_sort_buf_size);
+		return(DB_SUCCESS);
+	}
+
+	/** Add a row to a sort buffer, writing out the buffer if it is full.
+	@param[in]	i		index number
+	@param[in,out]	buf		sort buffer
+	@param[in]	row		table row
+	@param[in]	ext		cache of externally stored column
+					prefixes, or NULL
+	@param[in,out]	v_heap		heap memory for virtual columns
+	@param[in,out]	block		file buffer
+	@param[in,out]	crypt_block	encryption buffer, or NULL
+	@param[out]	err		set if an error occurs
+	@return number of records added, or 0 on error */
+	ulint add(
+		ulint			i,
+		row_merge_buf_t*&	buf,
+		dtuple_t*		row,
+		const row_ext_t*	ext,
+		mem_heap_t**		v_heap,
+		row_merge_block_t*	block,
+		row_merge_block_t*	crypt_block,
+		dberr_t*		err)
+	{
+		doc_id_t	doc_id = 0;
+		ulint		n = row_merge_buf_add(
+			buf, NULL, m_old_table, m_old_table, NULL, row, ext,
+			false, &doc_id, NULL, err, v_heap, NULL, m_trx,
+			m_col_collate);
+
+		if (n || *err != DB_SUCCESS) {
+			return(n);
+		}
+
+		/* The buffer is full. Write it out and try again. */
+		*err = write(i, buf, block, crypt_block);
+		buf = row_merge_buf_empty(buf);
+
+		if (*err == DB_SUCCESS) {
+			n = row_merge_buf_add(
+				buf, NULL, m_old_table, m_old_table, NULL,
+				row, ext, false, &doc_id, NULL, err, v_heap,
+				NULL, m_trx, m_col_collate);
+			/* An empty buffer should have enough room for
+			at least one record. */
+			ut_ad(n || *err != DB_SUCCESS);
+		}
+
+		return(n);
+	}
+
+	/** Scan a key range of the clustered index.
+	@param[in]	range		range number
+	@param[in,out]	buf		sort buffers
+	@param[in,out]	n_rec		numbers of records added to buf
+	@param[in,out]	block		file buffer
+	@param[in,out]	crypt_block	encryption buffer, or NULL
+	@return DB_SUCCESS or error code */
+	dberr_t scan_range(
+		size_t			range,
+		row_merge_buf_t**	buf,
+		ib_uint64_t*		n_rec,
+		row_merge_block_t*	block,
+		row_merge_block_t*	crypt_block)
+	{
+		/** Adds the visible rows to the sort buffers */
+		struct visitor_t : public row_pread_visitor_t
+		{
+			row_merge_scan_t&	scan;
+			row_merge_buf_t**	buf;
+			ib_uint64_t*		n_rec;
+			row_merge_block_t*	block;
+			row_merge_block_t*	crypt_block;
+			mem_heap_t*		v_heap;
+
+			visitor_t(row_merge_scan_t& scan,
+				  row_merge_buf_t** buf, ib_uint64_t* n_rec,
+				  row_merge_block_t* block,
+				  row_merge_block_t* crypt_block) :
+				scan(scan), buf(buf), n_rec(n_rec),
+				block(block), crypt_block(crypt_block),
+				v_heap(NULL) {}
+
+			~visitor_t()
+			{
+				if (v_heap) {
+					mem_heap_free(v_heap);
+				}
+			}
+
+			dberr_t visit(const rec_t* rec,
+				      const rec_offs* offsets,
+				      mem_heap_t* heap) override
+			{
+				row_ext_t*	ext;
+				dtuple_t*	row = row_build_w_add_vcol(
+					ROW_COPY_POINTERS,
+					dict_table_get_first_index(
+						scan.m_old_table),
+					rec, offsets, scan.m_old_table,
+					NULL, NULL, NULL, &ext, heap);
+				dberr_t		err = DB_SUCCESS;
+
+				for (ulint i = 0; i < scan.m_n_index; i++) {
+					ulint	n = scan.add(
+						i, buf[i], row, ext, &v_heap,
+						block, crypt_block, &err);
+					if (err != DB_SUCCESS) {
+						break;
+					}
+
+					n_rec[i] += n;
+				}
+
+				return(err);
+			}
+		};
+
+		visitor_t	visitor(*this, buf, n_rec, block,
+					crypt_block);
+
+		return(m_reader.scan(range, visitor));
+	}
+};
+
+/** Determine whether the clustered index can be scanned in parallel
+for creating indexes.
+@param[in]	trx		transaction
+@param[in]	old_table	table where rows are read from
+@param[in]	new_table	table where indexes are created
+@param[in]	online		true if creating indexes online
+@param[in]	index		indexes to be created
+@param[in]	n_index		number of indexes to create
+@param[in]	add_v		newly added virtual columns, or NULL
+@return number of threads for scanning the clustered index
+@retval 0 if the clustered index must be scanned by row_merge_read_clustered_index() */
+static
+ulint
+row_merge_scan_threads(
+	const trx_t*		trx,
+	const dict_table_t*	old_table,
+	const dict_table_t*	new_table,
+	bool			online,
+	dict_index_t**		index,
+	ulint			n_index,
+	const dict_add_v_col_t*	add_v)
+{
+	const ulint	n_threads = thd_ddl_threads(trx->mysql_thd);
+
+	/* Only the creation of secondary indexes without rebuilding
+	the table is supported. When an empty table was bulk-loaded,
+	the visibility of bulk_trx_id must be checked first. */
+	if (n_threads <= 1 || old_table != new_table || add_v
+	    || (online && old_table->bulk_trx_id)) {
+		return(0);
+	}
+
+	for (ulint i = 0; i < n_index; i++) {
+		if ((index[i]->type & (DICT_FTS | DICT_SPATIAL))
+		    || index[i]->has_virtual()) {
+			return(0);
+		}
+	}
+
+	return(n_threads);
+}
+
 /** Reads clustered index of the table and create temporary files
 containing the index entries for the indexes to be built.
 @param[in]	trx		transaction
@@ -1807,6 +2179,8 @@ containing the index entries for the indexes to be built.
 @param[in]	fts_sort_idx	full-text index to be created, or NULL
 @param[in]	psort_info	parallel sort info for fts_sort_idx creation,
 				or NULL
+@param[in]	spatial_sort_idx sort indexes for the SPATIAL INDEX in index[],
+				or NULL
 @param[in]	files		temporary files
 @param[in]	key_numbers	MySQL key numbers to create
 @param[in]	n_index		number of indexes to create
@@ -1842,6 +2216,7 @@ row_merge_read_clustered_index(
 	dict_index_t**		index,
 	dict_index_t*		fts_sort_idx,
 	fts_psort_t*		psort_info,
+	dict_index_t**		spatial_sort_idx,
 	merge_file_t*		files,
 	const ulint*		key_numbers,
 	ulint			n_index,
@@ -1879,8 +2254,6 @@ row_merge_read_clustered_index(
 	doc_id_t		max_doc_id = 0;
 	ibool			add_doc_id = FALSE;
 	pthread_cond_t*		fts_parallel_sort_cond = nullptr;
-	spatial_index_info**	sp_tuples = nullptr;
-	ulint			num_spatial = 0;
 	BtrBulk*		clust_btr_bulk = NULL;
 	bool			clust_temp_file = false;
 	mem_heap_t*		mtuple_heap = NULL;
@@ -1913,6 +2286,37 @@ row_merge_read_clustered_index(
 	DEBUG_FTS_SORT_PRINT("FTS_SORT: Start Create Index\n");
 #endif
 
+	if (const ulint n_threads = row_merge_scan_threads(
+		    trx, old_table, new_table, online, index, n_index,
+		    add_v)) {
+		/* Perform a REPEATABLE READ when creating the indexes
+		online, like the single-threaded scan below. */
+		row_pread_t	reader(dict_table_get_first_index(old_table),
+				       trx, online ? &trx->read_view : NULL);
+
+		err = reader.split(n_threads * row_pread_t::RANGES_PER_THREAD);
+
+		if (err != DB_SUCCESS) {
+			trx->error_key_num = 0;
+		} else if (reader.n_ranges() > 1) {
+			row_merge_scan_t	scan(
+				trx, table, old_table, online, index, files,
+				key_numbers, n_index, tmpfd, col_collate,
+				reader);
+
+			err = scan.run(n_threads, block, crypt_block);
+			/* presenting 10.12% as 1012 integer */
+			onlineddl_pct_progress = ulint(pct_cost * 100);
+		}
+
+		/* Scan a single-page clustered index with a single
+		thread. */
+		if (err != DB_SUCCESS || reader.n_ranges() > 1) {
+			trx->op_info = "";
+			DBUG_RETURN(err);
+		}
+	}
+
 	/* Create and initialize memory for record buffers */
 
 	merge_buf = static_cast<row_merge_buf_t**>(
@@ -1956,34 +2360,14 @@ row_merge_read_clustered_index(
 			row_fts_start_psort(psort_info);
 			fts_parallel_sort_cond =
 				 &psort_info[0].psort_common->sort_cond;
+		} else if (dict_index_is_spatial(index[i])) {
+			merge_buf[i] = row_merge_buf_create(
+				spatial_sort_idx[i]);
 		} else {
-			if (dict_index_is_spatial(index[i])) {
-				num_spatial++;
-			}
-
 			merge_buf[i] = row_merge_buf_create(index[i]);
 		}
 	}
 
-	if (num_spatial > 0) {
-		ulint	count = 0;
-
-		sp_tuples = static_cast<spatial_index_info**>(
-			ut_malloc_nokey(num_spatial
-					* sizeof(*sp_tuples)));
-
-		for (ulint i = 0; i < n_index; i++) {
-			if (dict_index_is_spatial(index[i])) {
-				sp_tuples[count]
-					= UT_NEW_NOKEY(
-						spatial_index_info(index[i]));
-				count++;
-			}
-		}
-
-		ut_ad(count == num_spatial);
-	}
-
 	mtr.start();
 	mtr_started = true;
 
@@ -2148,15 +2532,6 @@ row_merge_read_clustered_index(
 				}
 			}
 
-			/* Insert the cached spatial index rows. */
-			err = row_merge_spatial_rows(
-				trx->id, sp_tuples, num_spatial,
-				row_heap, &pcur, mtr_started, &mtr);
-
-			if (err != DB_SUCCESS) {
-				goto func_exit;
-			}
-
 			mem_heap_empty(row_heap);
 
 			if (!mtr_started) {
@@ -2534,33 +2909,20 @@ row_merge_read_clustered_index(
 		in a single scan of the clustered index. */
 
 		n_rows++;
-		ulint	s_idx_cnt = 0;
 		bool	skip_sort = skip_pk_sort
 			&& dict_index_is_clust(merge_buf[0]->index);
 
 		for (ulint k = 0, i = 0; i < n_index; i++, skip_sort = false) {
 			row_merge_buf_t*	buf	= merge_buf[i];
 			ulint			rows_added = 0;
+			const bool		spatial
+				= dict_index_is_spatial(index[i]);
 
-			if (dict_index_is_spatial(buf->index)) {
-				if (!row) {
-					continue;
-				}
-
-				ut_ad(sp_tuples[s_idx_cnt]->index
-				      == buf->index);
-
-				/* If the geometry field is invalid, report
-				error. */
-				if (!row_geo_field_is_valid(row, buf->index)) {
-					err = DB_CANT_CREATE_GEOMETRY_OBJECT;
-					break;
-				}
-
-				sp_tuples[s_idx_cnt]->add(row, ext, buf->heap);
-				s_idx_cnt++;
-
-				continue;
+			/* If the geometry field is invalid, report error. */
+			if (spatial && row
+			    && !row_geo_field_is_valid(row, index[i])) {
+				err = DB_CANT_CREATE_GEOMETRY_OBJECT;
+				break;
 			}
 
 			ut_ad(!row
@@ -2571,7 +2933,10 @@ row_merge_read_clustered_index(
 			merge_file_t*	file = &files[k++];
 
 			if (UNIV_LIKELY
-			    (row && (rows_added = row_merge_buf_add(
+			    (row && (rows_added = spatial
+				     ? row_merge_buf_add_spatial(
+					     buf, index[i], row, ext)
+				     : row_merge_buf_add(
 					buf, fts_index, old_table, new_table,
 					psort_info, row, ext, history_fts,
 					&doc_id, conv_heap, &err,
@@ -2670,23 +3035,6 @@ row_merge_read_clustered_index(
 					/* Temporary File is not used.
 					so insert sorted block to the index */
 					if (row != NULL) {
-						/* We have to do insert the
-						cached spatial index rows, since
-						after the mtr_commit, the cluster
-						index page could be updated, then
-						the data in cached rows become
-						invalid. */
-						err = row_merge_spatial_rows(
-							trx->id, sp_tuples,
-							num_spatial,
-							row_heap,
-							&pcur, mtr_started,
-							&mtr);
-
-						if (err != DB_SUCCESS) {
-							goto func_exit;
-						}
-
 						/* We are not at the end of
 						the scan yet. We must
 						mtr.commit() in order to be
@@ -2839,7 +3187,7 @@ row_merge_read_clustered_index(
 					BtrBulk	btr_bulk(index[i], trx);
 
 					err = row_merge_insert_index_tuples(
-						index[i], old_table,
+						buf->index, old_table,
 						OS_FILE_CLOSED, NULL, buf,
 						&btr_bulk,
 						table_total_rows,
@@ -2903,7 +3251,10 @@ row_merge_read_clustered_index(
 				and emptied. */
 
 				if (UNIV_UNLIKELY
-				    (!(rows_added = row_merge_buf_add(
+				    (!(rows_added = spatial
+				       ? row_merge_buf_add_spatial(
+					       buf, index[i], row, ext)
+				       : row_merge_buf_add(
 						buf, fts_index, old_table,
 						new_table, psort_info,
 						row, ext, history_fts, &doc_id,
@@ -3040,13 +3391,6 @@ row_merge_read_clustered_index(
 	ut_free(merge_buf);
 	ut_free(pcur.old_rec_buf);
 
-	if (sp_tuples != NULL) {
-		for (ulint i = 0; i < num_spatial; i++) {
-			UT_DELETE(sp_tuples[i]);
-		}
-		ut_free(sp_tuples);
-	}
-
 	/* Update the next Doc ID we used. Table should be locked, so
 	no concurrent DML */
 	if (max_doc_id && err == DB_SUCCESS) {
@@ -3486,6 +3830,147 @@ row_merge(
 	return(DB_SUCCESS);
 }
 
+/** Merge disk files in parallel. Unlike row_merge(), this does not
+require the runs to be contiguous in the file: the output run of each
+pair of input runs is written at an offset that leaves room for all
+blocks of the input runs, and the offsets of all runs are remembered
+in run_offset.
+@param[in]	trx		transaction
+@param[in]	dup		descriptor of index being created
+@param[in,out]	file		file containing index entries
+@param[in,out]	block		3 buffers
+@param[in,out]	tmpfd		temporary file handle
+@param[in,out]	num_run		Number of runs that remain to be merged
+@param[in,out]	run_offset	Array that contains the first offset number
+for each merge run
+@param[in,out]	crypt_block	encryption buffer
+@param[in]	space		tablespace ID for encryption
+@param[in]	n_threads	number of threads
+@return DB_SUCCESS or error code */
+static
+dberr_t
+row_merge_parallel_pass(
+	trx_t*			trx,
+	const row_merge_dup_t*	dup,
+	merge_file_t*		file,
+	row_merge_block_t*	block,
+	pfs_os_file_t*		tmpfd,
+	ulint*			num_run,
+	ulint*			run_offset,
+	row_merge_block_t*	crypt_block,
+	ulint			space,
+	ulint			n_threads)
+{
+	const ulint	n_in	= *num_run;
+	const ulint	half	= n_in / 2;
+	/* Run j is merged with run half + j. If there is an odd number
+	of runs, the last one is copied. */
+	const ulint	n_out	= n_in - half;
+	ulint*		out_offset = static_cast<ulint*>(
+		ut_malloc_nokey(n_out * sizeof *out_offset));
+	const pfs_os_file_t	out_fd	= *tmpfd;
+	std::atomic<ulint>	next{0};
+	std::atomic<bool>	failed{false};
+	std::atomic<ib_uint64_t> n_rec{0};
+	std::mutex		mutex;
+	dberr_t			error	= DB_SUCCESS;
+	ulint			error_run = 0;
+
+	ut_ad(half > 0);
+
+	/* The number of blocks of an input run, including any unused
+	blocks after it. */
+	auto	run_size = [&](ulint r) {
+		return (r + 1 < n_in ? run_offset[r + 1] : file->offset)
+			- run_offset[r];
+	};
+
+	/* The output run cannot be longer than the input runs. */
+	for (ulint j = 0, offset = 0; j < n_out; j++) {
+		out_offset[j] = offset;
+		offset += run_size(half + j);
+
+		if (j < half) {
+			offset += run_size(j);
+		}
+	}
+
+	ut_ad(out_offset[n_out - 1] < file->offset);
+
+	auto	merge = [&](row_merge_block_t* b, row_merge_block_t* c) {
+		/* Duplicates are reported to dup->table afterwards,
+		by the calling thread. */
+		const row_merge_dup_t	d = {dup->index, NULL,
+					     dup->col_map, 0};
+
+		for (ulint j; !failed && (j = next++) < n_out; ) {
+			merge_file_t	of = {out_fd, out_offset[j], 0};
+			ulint		foffs1 = run_offset[half + j];
+			dberr_t		err;
+
+			if (trx_is_interrupted(trx)) {
+				err = DB_INTERRUPTED;
+			} else if (j < half) {
+				ulint	foffs0 = run_offset[j];
+				err = row_merge_blocks(
+					&d, file, b, &foffs0, &foffs1, &of,
+					NULL, c, space);
+			} else if (!row_merge_blocks_copy(
+					   d.index, file, b, &foffs1, &of,
+					   NULL, c, space)) {
+				err = DB_CORRUPTION;
+			} else {
+				err = DB_SUCCESS;
+			}
+
+			n_rec += of.n_rec;
+
+			if (err != DB_SUCCESS) {
+				std::lock_guard<std::mutex>	lock(mutex);
+
+				if (error == DB_SUCCESS) {
+					error = err;
+					error_run = j;
+				}
+
+				failed = true;
+			}
+		}
+	};
+
+	dberr_t	err = row_merge_parallel(std::min(n_threads, n_out),
+					 3 * srv_sort_buf_size,
+					 block, crypt_block, merge);
+
+	if (err != DB_SUCCESS) {
+	} else if (error == DB_DUPLICATE_KEY && dup->table) {
+		/* Merge the runs again, to report the duplicate. */
+		merge_file_t	of = {out_fd, out_offset[error_run], 0};
+		ulint		foffs0 = run_offset[error_run];
+		ulint		foffs1 = run_offset[half + error_run];
+
+		err = row_merge_blocks(dup, file, block, &foffs0, &foffs1,
+				       &of, NULL, crypt_block, space);
+		ut_ad(err == DB_DUPLICATE_KEY);
+	} else if (error != DB_SUCCESS) {
+		err = error;
+	} else if (UNIV_UNLIKELY(n_rec != file->n_rec)) {
+		err = DB_CORRUPTION;
+	} else {
+		memcpy(run_offset, out_offset, n_out * sizeof *run_offset);
+		*num_run = n_out;
+
+		/* Swap file descriptors for the next pass. The size of
+		the file is unchanged. */
+		*tmpfd = file->fd;
+		file->fd = out_fd;
+	}
+
+	ut_free(out_offset);
+
+	return(err);
+}
+
 /** Merge disk files.
 @param[in]	trx	transaction
 @param[in]	dup	descriptor of index being created
@@ -3495,6 +3980,7 @@ row_merge(
 @param[in,out]	stage	performance schema accounting object, used by
 ALTER TABLE. If not NULL, stage->begin_phase_sort() will be called initially
 and then stage->inc() will be called for each record processed.
+@param[in]	n_threads	number of threads for merging
 @return DB_SUCCESS or error code */
 dberr_t
 row_merge_sort(
@@ -3512,7 +3998,8 @@ row_merge_sort(
 	const double		pct_cost, /*!< in: current progress percent */
 	row_merge_block_t*	crypt_block, /*!< in: crypt buf or NULL */
 	ulint			space,	   /*!< in: space id */
-	ut_stage_alter_t* 	stage)
+	ut_stage_alter_t* 	stage,
+	ulint			n_threads)
 {
 	const ulint	half	= file->offset / 2;
 	ulint		num_runs;
@@ -3545,6 +4032,14 @@ row_merge_sort(
 	of merge. */
 	run_offset[half] = half;
 
+	if (n_threads > 1) {
+		/* Each block is a run in the first round of
+		row_merge_parallel_pass(). */
+		for (ulint i = 0; i < num_runs; i++) {
+			run_offset[i] = i;
+		}
+	}
+
 	/* The file should always contain at least one byte (the end
 	of file marker).  Thus, it must be at least one block. */
 	ut_ad(file->offset > 0);
@@ -3557,9 +4052,16 @@ row_merge_sort(
 
 	/* Merge the runs until we have one big run */
 	do {
-		error = row_merge(trx, dup, file, block, tmpfd,
-				  &num_runs, run_offset, stage,
-				  crypt_block, space);
+		/* row_merge() relies on the runs being contiguous,
+		which row_merge_parallel_pass() does not guarantee. */
+		error = n_threads > 1
+			? row_merge_parallel_pass(trx, dup, file, block,
+						  tmpfd, &num_runs,
+						  run_offset, crypt_block,
+						  space, n_threads)
+			: row_merge(trx, dup, file, block, tmpfd,
+				    &num_runs, run_offset, stage,
+				    crypt_block, space);
 
 		if(update_progress) {
 			merge_count++;
@@ -3729,6 +4231,7 @@ row_merge_insert_index_tuples(
 	double			curr_progress = 0;
 	dict_index_t*		old_index = NULL;
 	const mrec_t*		mrec  = NULL;
+	dtuple_t*		sp_dtuple = NULL;
 	mtr_t			mtr;
 
 
@@ -3754,6 +4257,18 @@ row_merge_insert_index_tuples(
 		rec_offs_set_n_fields(offsets, dict_index_get_n_fields(index));
 	}
 
+	if (const dict_index_t* spatial = btr_bulk->index()->is_spatial()
+	    ? btr_bulk->index() : NULL) {
+		/* The records are in the format of
+		row_merge_create_spatial_sort_index(). The Hilbert
+		value in the first field will be discarded. */
+		ut_ad(index->n_fields == spatial->n_fields + 1);
+		sp_dtuple = dtuple_create(
+			heap, dict_index_get_n_fields(spatial));
+		dtuple_set_n_fields_cmp(
+			sp_dtuple, dict_index_get_n_unique_in_tree(spatial));
+	}
+
 	if (row_buf != NULL) {
 		ut_ad(fd == OS_FILE_CLOSED);
 		ut_ad(block == NULL);
@@ -3857,7 +4372,15 @@ row_merge_insert_index_tuples(
 		}
 
 		ut_ad(dtuple_validate(dtuple));
-		error = btr_bulk->insert(dtuple);
+
+		if (sp_dtuple) {
+			memcpy(sp_dtuple->fields, dtuple->fields + 1,
+			       sp_dtuple->n_fields * sizeof *dtuple->fields);
+			sp_dtuple->fields[0].type.prtype |= DATA_GIS_MBR;
+			error = btr_bulk->insert(sp_dtuple);
+		} else {
+			error = btr_bulk->insert(dtuple);
+		}
 
 		if (error != DB_SUCCESS) {
 			goto err_exit;
@@ -4643,6 +5166,7 @@ row_merge_build_indexes(
 	dberr_t			error;
 	pfs_os_file_t		tmpfd = OS_FILE_CLOSED;
 	dict_index_t*		fts_sort_idx = NULL;
+	dict_index_t**		spatial_sort_idx = NULL;
 	fts_psort_t*		psort_info = NULL;
 	fts_psort_t*		merge_info = NULL;
 	bool			fts_psort_initiated = false;
@@ -4691,14 +5215,7 @@ row_merge_build_indexes(
 	}
 
 	trx_start_if_not_started_xa(trx, true);
-	ulint	n_merge_files = 0;
-
-	for (ulint i = 0; i < n_indexes; i++)
-	{
-		if (!dict_index_is_spatial(indexes[i])) {
-			n_merge_files++;
-		}
-	}
+	const ulint	n_merge_files = n_indexes;
 
 	merge_files = static_cast<merge_file_t*>(
 		ut_malloc_nokey(n_merge_files * sizeof *merge_files));
@@ -4749,6 +5266,19 @@ row_merge_build_indexes(
 			/* We need to ensure that we free the resources
 			allocated */
 			fts_psort_initiated = true;
+		} else if (dict_index_is_spatial(indexes[i])) {
+			if (!spatial_sort_idx) {
+				spatial_sort_idx = static_cast<dict_index_t**>(
+					ut_zalloc_nokey(n_indexes
+							* sizeof *spatial_sort_idx));
+			}
+
+			/* SPATIAL INDEX entries are sorted by the
+			Hilbert value of their MBR before the R-tree
+			is built bottom-up. */
+			spatial_sort_idx[i]
+				= row_merge_create_spatial_sort_index(
+					indexes[i]);
 		}
 	}
 
@@ -4777,7 +5307,8 @@ row_merge_build_indexes(
 	secondary index entries for merge sort */
 	error = row_merge_read_clustered_index(
 		trx, table, old_table, new_table, online, indexes,
-		fts_sort_idx, psort_info, merge_files, key_numbers,
+		fts_sort_idx, psort_info, spatial_sort_idx, merge_files,
+		key_numbers,
 		n_indexes, defaults, add_v, col_map, add_autoinc,
 		sequence, block, skip_pk_sort, &tmpfd, stage,
 		pct_cost, crypt_block, eval_table, allow_not_null,
@@ -4808,10 +5339,9 @@ row_merge_build_indexes(
 
 	for (ulint k = 0, i = 0; i < n_indexes; i++) {
 		dict_index_t*	sort_idx = indexes[i];
-
-		if (dict_index_is_spatial(sort_idx)) {
-			continue;
-		}
+		/* index of the records in merge_files[k] */
+		dict_index_t*	rec_idx = dict_index_is_spatial(sort_idx)
+			? spatial_sort_idx[i] : sort_idx;
 
 		if (indexes[i]->type & DICT_FTS) {
 
@@ -4837,7 +5367,7 @@ row_merge_build_indexes(
 		} else if (merge_files[k].fd != OS_FILE_CLOSED) {
 			char	buf[NAME_LEN + 1];
 			row_merge_dup_t	dup = {
-				sort_idx, table, col_map, 0};
+				rec_idx, table, col_map, 0};
 
 			pct_cost = (COST_BUILD_INDEX_STATIC +
 				    (total_dynamic_cost
@@ -4869,7 +5399,8 @@ row_merge_build_indexes(
 					block, &tmpfd, true,
 					pct_progress, pct_cost,
 					crypt_block, new_table->space_id,
-					stage);
+					stage,
+					thd_ddl_threads(trx->mysql_thd));
 
 			pct_progress += pct_cost;
 
@@ -4906,7 +5437,7 @@ row_merge_build_indexes(
 				}
 
 				error = row_merge_insert_index_tuples(
-					sort_idx, old_table,
+					rec_idx, old_table,
 					merge_files[k].fd, block, NULL,
 					&btr_bulk,
 					merge_files[k].n_rec, pct_progress, pct_cost,
@@ -4990,6 +5521,16 @@ row_merge_build_indexes(
 		dict_mem_index_free(fts_sort_idx);
 	}
 
+	if (spatial_sort_idx) {
+		for (i = 0; i < n_indexes; i++) {
+			if (spatial_sort_idx[i]) {
+				dict_mem_index_free(spatial_sort_idx[i]);
+			}
+		}
+
+		ut_free(spatial_sort_idx);
+	}
+
 	ut_free(merge_files);
 
 	alloc.deallocate_large(block, &block_pfx);
@@ -0,0 +1,352 @@
+/*****************************************************************************
+
+Copyright (c) 2026, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file row/row0pread.cc
+Parallel read of the clustered index in key ranges
+*******************************************************/
+
+#include "row0pread.h"
+#include "btr0btr.h"
+#include "btr0pcur.h"
+#include "row0row.h"
+#include "row0vers.h"
+#include "trx0sys.h"
+#include <mutex>
+#include <thread>
+
+row_pread_t::row_pread_t(dict_index_t *index, const trx_t *trx,
+                         ReadView *view) :
+  m_index(index), m_trx(trx), m_view(view), m_heap(mem_heap_create(1024))
+{
+  ut_ad(index->is_primary());
+}
+
+row_pread_t::~row_pread_t()
+{
+  mem_heap_free(m_heap);
+}
+
+/** Split the index into key ranges. Descend from the root until there
+are enough node pointers, and pick evenly spaced node pointers as the
+boundaries of the ranges. The index consists of a single range if the
+root page is a leaf page.
+@param n  maximum number of ranges
+@return error code */
+dberr_t row_pread_t::split(ulint n)
+{
+  ut_ad(m_bounds.empty());
+
+  if (n <= 1)
+    return DB_SUCCESS;
+
+  mtr_t mtr;
+  dberr_t err;
+  rec_offs *offsets= nullptr;
+  mem_heap_t *offsets_heap= nullptr;
+  const ulint n_uniq= dict_index_get_n_unique_in_tree(m_index);
+
+  mtr.start();
+  /* Prevent page splits and merges while we are reading the node
+  pointers. */
+  mtr_s_lock_index(m_index, &mtr);
+
+  buf_block_t *block= btr_root_block_get(m_index, RW_S_LATCH, &mtr, &err);
+  if (!block || !btr_page_get_level(block->page.frame))
+    goto func_exit;
+
+  {
+    std::vector<buf_block_t*> level{block};
+    ulint n_recs= page_get_n_recs(block->page.frame);
+
+    for (ulint height= btr_page_get_level(block->page.frame);
+         height > 1 && n_recs < n; height--)
+    {
+      std::vector<buf_block_t*> children;
+
+      for (buf_block_t *b : level)
+      {
+        page_cur_t cur;
+        page_cur_set_before_first(b, &cur);
+
+        for (;;)
+        {
+          if (!page_cur_move_to_next(&cur))
+          {
+            err= DB_CORRUPTION;
+            goto func_exit;
+          }
+          if (page_cur_is_after_last(&cur))
+            break;
+
+          const rec_t *rec= page_cur_get_rec(&cur);
+          offsets= rec_get_offsets(rec, m_index, offsets, 0,
+                                   ULINT_UNDEFINED, &offsets_heap);
+          buf_block_t *child= buf_page_get_gen
+            (page_id_t(m_index->table->space_id,
+                       btr_node_ptr_get_child_page_no(rec, offsets)),
+             m_index->table->space->zip_size(), RW_S_LATCH, nullptr,
+             BUF_GET, &mtr, &err);
+          if (!child)
+            goto func_exit;
+          children.push_back(child);
+        }
+      }
+
+      level.swap(children);
+      n_recs= 0;
+      for (const buf_block_t *b : level)
+        n_recs+= page_get_n_recs(b->page.frame);
+    }
+
+    const ulint n_ranges= std::min(n, n_recs);
+    if (n_ranges <= 1)
+      goto func_exit;
+
+    /* Skip the first node pointer, which covers the start of the index. */
+    ulint i= 0, k= 1;
+
+    for (buf_block_t *b : level)
+    {
+      page_cur_t cur;
+      page_cur_set_before_first(b, &cur);
+
+      for (;;)
+      {
+        if (!page_cur_move_to_next(&cur))
+        {
+          err= DB_CORRUPTION;
+          goto func_exit;
+        }
+        if (page_cur_is_after_last(&cur))
+          break;
+        if (i++ != k * n_recs / n_ranges)
+          continue;
+
+        dtuple_t *tuple= dtuple_create(m_heap, n_uniq);
+        dict_index_copy_types(tuple, m_index, n_uniq);
+        rec_copy_prefix_to_dtuple(tuple, page_cur_get_rec(&cur), m_index,
+                                  0, n_uniq, m_heap);
+        m_bounds.push_back(tuple);
+
+        if (++k == n_ranges)
+          goto func_exit;
+      }
+    }
+
+    ut_ad("wrong number of node pointers" == 0);
+    err= DB_CORRUPTION;
+  }
+
+func_exit:
+  mtr.commit();
+  if (offsets_heap)
+    mem_heap_free(offsets_heap);
+  if (err != DB_SUCCESS)
+    m_bounds.clear();
+  return err;
+}
+
+/** Scan a key range.
+@param range    range number, less than n_ranges()
+@param visitor  record processor
+@return error code */
+dberr_t row_pread_t::scan(size_t range, row_pread_visitor_t &visitor)
+{
+  ut_ad(range < n_ranges());
+  const dtuple_t *start= range ? m_bounds[range - 1] : nullptr;
+  const dtuple_t *end= range < m_bounds.size() ? m_bounds[range] : nullptr;
+  const bool comp= m_index->table->not_redundant();
+  mem_heap_t *heap= mem_heap_create(srv_page_size / 4);
+  btr_pcur_t pcur;
+  mtr_t mtr;
+  dberr_t err;
+
+  mtr.start();
+
+  if (start)
+    /* Position the cursor before the first record of the range. */
+    err= btr_pcur_open_with_no_init(start, PAGE_CUR_L, BTR_SEARCH_LEAF,
+                                    &pcur, &mtr);
+  else
+  {
+    err= pcur.open_leaf(true, m_index, BTR_SEARCH_LEAF, &mtr);
+    if (err != DB_SUCCESS);
+    else if (const rec_t *rec= page_rec_get_next(btr_pcur_get_rec(&pcur)))
+    {
+      if (!(rec_get_info_bits(rec, comp) & REC_INFO_MIN_REC_FLAG));
+      else if (!m_index->is_instant())
+        err= DB_CORRUPTION;
+      else
+        /* Skip the metadata pseudo-record. */
+        btr_pcur_get_page_cur(&pcur)->rec= const_cast<rec_t*>(rec);
+    }
+    else
+      err= DB_CORRUPTION;
+  }
+
+  while (err == DB_SUCCESS)
+  {
+    page_cur_t *cur= btr_pcur_get_page_cur(&pcur);
+
+    if (!page_cur_move_to_next(cur))
+    {
+corrupted:
+      err= DB_CORRUPTION;
+      break;
+    }
+
+    mem_heap_empty(heap);
+
+    if (page_cur_is_after_last(cur))
+    {
+      if (m_abort)
+        break;
+      if (UNIV_UNLIKELY(trx_is_interrupted(m_trx)))
+      {
+        err= DB_INTERRUPTED;
+        break;
+      }
+      if (!m_index->table->is_readable())
+      {
+        err= DB_DECRYPTION_FAILED;
+        break;
+      }
+
+      if (m_index->lock.is_waiting())
+      {
+        /* There are waiters on the index tree lock, likely the purge
+        thread. Store and restore the cursor position, and yield so
+        that scanning a large table will not starve other threads. */
+        if (!btr_pcur_move_to_prev_on_page(&pcur))
+          goto corrupted;
+        btr_pcur_store_position(&pcur, &mtr);
+        mtr.commit();
+        std::this_thread::yield();
+        mtr.start();
+        if (pcur.restore_position(BTR_SEARCH_LEAF, &mtr) ==
+            btr_pcur_t::CORRUPTED)
+          goto corrupted;
+        if (!btr_pcur_move_to_next_user_rec(&pcur, &mtr))
+          break;
+      }
+      else
+      {
+        const uint32_t next_page_no= btr_page_get_next(page_cur_get_page(cur));
+        if (next_page_no == FIL_NULL)
+          break;
+        buf_block_t *block= buf_page_get_gen
+          (page_id_t(m_index->table->space_id, next_page_no),
+           m_index->table->space->zip_size(), RW_S_LATCH, nullptr, BUF_GET,
+           &mtr, &err);
+        if (!block)
+          break;
+        buf_page_make_young_if_needed(&block->page);
+        page_cur_set_before_first(block, cur);
+        if (!page_cur_move_to_next(cur) || page_cur_is_after_last(cur))
+          goto corrupted;
+        const auto s= mtr.get_savepoint();
+        mtr.rollback_to_savepoint(s - 2, s - 1);
+      }
+    }
+
+    const rec_t *rec= page_cur_get_rec(cur);
+    rec_offs *offsets= rec_get_offsets(rec, m_index, nullptr,
+                                       m_index->n_core_fields,
+                                       ULINT_UNDEFINED, &heap);
+
+    if (end && cmp_dtuple_rec(end, rec, m_index, offsets) <= 0)
+      break;
+
+    if (m_view)
+    {
+      const trx_id_t rec_trx_id= row_get_rec_trx_id(rec, m_index, offsets);
+
+      if (!m_view->changes_visible(rec_trx_id))
+      {
+        if (rec_trx_id >= m_view->low_limit_id() &&
+            rec_trx_id >= trx_sys.get_max_trx_id())
+          goto corrupted;
+
+        rec_t *old_vers;
+        row_vers_build_for_consistent_read(rec, &mtr, m_index, &offsets,
+                                           m_view, &heap, heap, &old_vers,
+                                           nullptr);
+        if (!old_vers)
+          continue;
+        rec= old_vers;
+      }
+    }
+
+    if (rec_get_deleted_flag(rec, comp))
+      continue;
+
+    err= visitor.visit(rec, offsets, heap);
+  }
+
+  mtr.commit();
+  ut_free(pcur.old_rec_buf);
+  mem_heap_free(heap);
+  return err;
+}
+
+dberr_t row_pread_count(dict_index_t *index, const trx_t *trx,
+                        ReadView *view, ulint n_threads, ulint *n_rows)
+{
+  /** Counter of the visible records */
+  struct counter_t : public row_pread_visitor_t
+  {
+    ulint n= 0;
+    dberr_t visit(const rec_t*, const rec_offs*, mem_heap_t*) override
+    {
+      n++;
+      return DB_SUCCESS;
+    }
+  };
+
+  row_pread_t reader(index, trx, view);
+  dberr_t err= reader.split(n_threads * row_pread_t::RANGES_PER_THREAD);
+  if (err != DB_SUCCESS)
+    return err;
+
+  std::atomic<size_t> next{0};
+  std::atomic<ulint> total{0};
+  std::mutex mutex;
+
+  row_pread_run(std::min<ulint>(n_threads, reader.n_ranges()),
+                [&](ulint)
+                {
+                  counter_t counter;
+                  for (size_t range;
+                       !reader.aborted() &&
+                         (range= next++) < reader.n_ranges(); )
+                  {
+                    if (dberr_t e= reader.scan(range, counter))
+                    {
+                      std::lock_guard<std::mutex> lock(mutex);
+                      if (err == DB_SUCCESS)
+                        err= e;
+                      reader.abort();
+                    }
+                  }
+                  total+= counter.n;
+                });
+
+  *n_rows= total;
+  return err;
+}
@@ -28,6 +28,7 @@ Created 3/14/1997 Heikki Tuuri
 #include "btr0cur.h"
 #include "fsp0fsp.h"
 #include "mach0data.h"
+#include "dict0boot.h"
 #include "dict0crea.h"
 #include "dict0stats.h"
 #include "trx0rseg.h"
@@ -41,6 +42,7 @@ Created 3/14/1997 Heikki Tuuri
 #include "row0upd.h"
 #include "row0vers.h"
 #include "row0mysql.h"
+#include "rem0cmp.h"
 #include "log0log.h"
 #include "srv0mon.h"
 #include "srv0start.h"
@@ -49,6 +51,7 @@ Created 3/14/1997 Heikki Tuuri
 #include "fil0fil.h"
 #include "debug_sync.h"
 #include <mysql/service_thd_mdl.h>
+#include <algorithm>
 
 /*************************************************************************
 IMPORTANT NOTE: Any operation that generates redo MUST check that there
@@ -414,18 +417,106 @@ row_purge_remove_sec_if_poss_tree(
 	return(success);
 }
 
+/** The leaf page where the previous secondary index entry was purged */
+struct row_purge_sec_hint_t
+{
+  /** the secondary index */
+  const dict_index_t *index= nullptr;
+  /** the leaf page, or nullptr */
+  buf_block_t *block= nullptr;
+  /** block->modify_clock after the previous entry was purged */
+  uint64_t modify_clock;
+
+  /** Remember the current leaf page of a cursor.
+  @param pcur  cursor that is positioned on an X-latched leaf page */
+  void set(const btr_pcur_t &pcur)
+  {
+    index= pcur.index();
+    block= pcur.btr_cur.page_cur.block;
+    modify_clock= block->modify_clock;
+  }
+};
+
+/** Outcome of row_purge_sec_guess() */
+enum row_purge_guess_t
+{
+  /** the leaf page could not be used; a search is needed */
+  ROW_PURGE_GUESS_FAIL,
+  /** the cursor was positioned on the entry */
+  ROW_PURGE_GUESS_FOUND,
+  /** the entry does not exist in the index */
+  ROW_PURGE_GUESS_NOT_FOUND
+};
+
+/** Try to position a cursor on a secondary index entry on the leaf page
+where the previous entry was purged, without searching the index tree.
+This succeeds if the page was not modified since then and the entry
+is within the key range of the page.
+@param entry  secondary index entry
+@param hint   the leaf page of the previous entry
+@param pcur   cursor
+@param mtr    mini-transaction
+@return whether the cursor was positioned on the entry */
+static row_purge_guess_t
+row_purge_sec_guess(const dtuple_t *entry, const row_purge_sec_hint_t &hint,
+                    btr_pcur_t *pcur, mtr_t *mtr)
+{
+  if (!hint.block || hint.index != pcur->index())
+    return ROW_PURGE_GUESS_FAIL;
+
+  const ulint savepoint= mtr->get_savepoint();
+  if (!buf_page_optimistic_get(RW_X_LATCH, hint.block, hint.modify_clock,
+                               mtr))
+    return ROW_PURGE_GUESS_FAIL;
+
+  page_cur_t *page_cur= btr_pcur_get_page_cur(pcur);
+  page_cur->block= hint.block;
+  const page_t *page= hint.block->page.frame;
+  ulint up_match= 0, low_match= 0;
+
+  if (!page_is_leaf(page) ||
+      btr_page_get_index_id(page) != pcur->index()->id ||
+      page_cur_search_with_match(entry, PAGE_CUR_LE, &up_match, &low_match,
+                                 page_cur, nullptr))
+  {
+fail:
+    mtr->rollback_to_savepoint(savepoint);
+    return ROW_PURGE_GUESS_FAIL;
+  }
+
+  pcur->latch_mode= BTR_MODIFY_LEAF;
+  pcur->search_mode= PAGE_CUR_LE;
+  pcur->pos_state= BTR_PCUR_IS_POSITIONED;
+  pcur->btr_cur.up_match= up_match;
+  pcur->btr_cur.low_match= low_match;
+
+  if (low_match == dtuple_get_n_fields(entry))
+    return ROW_PURGE_GUESS_FOUND;
+
+  /* If the entry is not between two records of the page,
+  it could be located in another page. */
+  const rec_t *rec= page_cur_get_rec(page_cur);
+  if (page_rec_is_infimum(rec) ||
+      page_rec_is_supremum(page_rec_get_next_const(rec)))
+    goto fail;
+
+  return ROW_PURGE_GUESS_NOT_FOUND;
+}
+
 /***************************************************************
 Removes a secondary index entry without modifying the index tree,
 if possible.
 @retval true if success or if not found
 @retval false if row_purge_remove_sec_if_poss_tree() should be invoked */
-static MY_ATTRIBUTE((nonnull, warn_unused_result))
+static MY_ATTRIBUTE((nonnull(1,2,3), warn_unused_result))
 bool
 row_purge_remove_sec_if_poss_leaf(
 /*==============================*/
 	purge_node_t*	node,	/*!< in: row purge node */
 	dict_index_t*	index,	/*!< in: index */
-	const dtuple_t*	entry)	/*!< in: index entry */
+	const dtuple_t*	entry,	/*!< in: index entry */
+	row_purge_sec_hint_t* hint)/*!< in/out: leaf page of the previously
+				purged entry, or nullptr */
 {
 	mtr_t			mtr;
 	btr_pcur_t		pcur;
@@ -440,16 +531,37 @@ row_purge_remove_sec_if_poss_leaf(
 	pcur.btr_cur.page_cur.index = index;
 
 	if (index->is_spatial()) {
+		hint = nullptr;
 		if (!rtr_search(entry, BTR_MODIFY_LEAF, &pcur, nullptr,
 				&mtr)) {
 			goto found;
 		}
-	} else if (btr_pcur_open(entry, PAGE_CUR_LE, BTR_MODIFY_LEAF, &pcur,
-				 &mtr)
-		   == DB_SUCCESS
-		   && !btr_pcur_is_before_first_on_page(&pcur)
-		   && btr_pcur_get_low_match(&pcur)
-		   == dtuple_get_n_fields(entry)) {
+		goto func_exit;
+	}
+
+	if (hint) {
+		switch (row_purge_sec_guess(entry, *hint, &pcur, &mtr)) {
+		case ROW_PURGE_GUESS_FAIL:
+			break;
+		case ROW_PURGE_GUESS_FOUND:
+			goto found;
+		case ROW_PURGE_GUESS_NOT_FOUND:
+			hint->set(pcur);
+			goto func_exit;
+		}
+	}
+
+	if (btr_pcur_open(entry, PAGE_CUR_LE, BTR_MODIFY_LEAF, &pcur, &mtr)
+	    != DB_SUCCESS) {
+		if (hint) {
+			hint->block = nullptr;
+		}
+		goto func_exit;
+	}
+
+	if (!btr_pcur_is_before_first_on_page(&pcur)
+	    && btr_pcur_get_low_match(&pcur)
+	    == dtuple_get_n_fields(entry)) {
 found:
 		/* Before attempting to purge a record, check
 		if it is safe to do so. */
@@ -472,6 +584,9 @@ row_purge_remove_sec_if_poss_leaf(
 						index);
 				mtr.commit();
 				dict_set_corrupted(index, "purge");
+				if (hint) {
+					hint->block = nullptr;
+				}
 				goto cleanup;
 			}
 
@@ -499,6 +614,14 @@ row_purge_remove_sec_if_poss_leaf(
 		}
 	}
 
+	if (hint) {
+		if (success) {
+			hint->set(pcur);
+		} else {
+			hint->block = nullptr;
+		}
+	}
+
 func_exit:
 	mtr.commit();
 cleanup:
@@ -514,7 +637,10 @@ row_purge_remove_sec_if_poss(
 /*=========================*/
 	purge_node_t*	node,	/*!< in: row purge node */
 	dict_index_t*	index,	/*!< in: index */
-	const dtuple_t*	entry)	/*!< in: index entry */
+	const dtuple_t*	entry,	/*!< in: index entry */
+	row_purge_sec_hint_t* hint = nullptr)
+				/*!< in/out: leaf page of the previously
+				purged entry, or nullptr */
 {
 	ibool	success;
 	ulint	n_tries		= 0;
@@ -528,10 +654,14 @@ row_purge_remove_sec_if_poss(
 		return;
 	}
 
-	if (row_purge_remove_sec_if_poss_leaf(node, index, entry)) {
+	if (row_purge_remove_sec_if_poss_leaf(node, index, entry, hint)) {
 
 		return;
 	}
+
+	if (hint) {
+		hint->block = nullptr;
+	}
 retry:
 	success = row_purge_remove_sec_if_poss_tree(node, index, entry);
 	/* The delete operation may fail if we have little
@@ -550,6 +680,28 @@ row_purge_remove_sec_if_poss(
 	ut_a(success);
 }
 
+/** Remove a delete-marked clustered index record after its secondary
+index entries have been purged.
+@param node  purge node, positioned on the record
+@retval true if the row was not found, or it was successfully removed
+@retval false the purge needs to be suspended because of
+running out of file space */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+bool row_purge_del_mark_clust(purge_node_t *node)
+{
+  bool result= row_purge_remove_clust_if_poss(node);
+
+#ifdef ENABLED_DEBUG_SYNC
+  DBUG_EXECUTE_IF("enable_row_purge_del_mark_exit_sync_point",
+                  debug_sync_set_action
+                  (current_thd,
+                   STRING_WITH_LEN("now SIGNAL row_purge_del_mark_finished"));
+                  );
+#endif
+
+  return result;
+}
+
 /***********************************************************//**
 Purges a delete marking of a record.
 @retval true if the row was not found, or it was successfully removed
@@ -579,17 +731,161 @@ bool row_purge_del_mark(purge_node_t *node)
     mem_heap_free(heap);
   }
 
-  bool result= row_purge_remove_clust_if_poss(node);
+  return row_purge_del_mark_clust(node);
+}
 
-#ifdef ENABLED_DEBUG_SYNC
-  DBUG_EXECUTE_IF("enable_row_purge_del_mark_exit_sync_point",
-                  debug_sync_set_action
-                  (current_thd,
-                   STRING_WITH_LEN("now SIGNAL row_purge_del_mark_finished"));
-                  );
-#endif
+/** Maximum number of delete-marked rows whose purge may be deferred */
+static constexpr size_t ROW_PURGE_MAX_DEFERRED= 1000;
 
-  return result;
+/** Compare two secondary index entries of deferred rows.
+@return whether a should be purged before b */
+static bool row_purge_sec_entry_less(const purge_node_t::sec_entry_t &a,
+                                     const purge_node_t::sec_entry_t &b)
+{
+  if (a.index != b.index)
+    return a.index->id < b.index->id;
+  if (a.index->is_spatial())
+    return false;
+  ut_ad(dtuple_get_n_fields(a.entry) == dtuple_get_n_fields(b.entry));
+  for (ulint i= 0; i < dtuple_get_n_fields(a.entry); i++)
+    if (int cmp= cmp_dfield_dfield(dtuple_get_nth_field(a.entry, i),
+                                   dtuple_get_nth_field(b.entry, i),
+                                   a.index->fields[i].descending))
+      return cmp < 0;
+  return false;
+}
+
+/** Purge the deferred delete-marked rows. The secondary index entries
+are removed in index key order, so that consecutive entries can be
+found on the same leaf page without searching the index tree.
+@param node  purge node
+@param thr   query thread */
+static void row_purge_deferred(purge_node_t *node, que_thr_t *thr)
+{
+  if (node->del_marks.empty())
+    return;
+
+  ut_ad(!node->found_clust);
+  dict_table_t *const table= node->table;
+  const dtuple_t *const ref= node->ref;
+  const roll_ptr_t roll_ptr= node->roll_ptr;
+  const trx_id_t trx_id= node->trx_id;
+  size_t row= ULINT_UNDEFINED;
+
+  node->table= node->del_mark_table;
+
+  /* The clustered index record of a row is looked up once. Its stored
+  position is swapped in and out of node->pcur whenever the secondary
+  index entries of another row are being processed, so that
+  row_purge_reposition_pcur() can usually restore the position without
+  searching the clustered index. */
+  auto save_row= [node, &row]()
+  {
+    if (row == ULINT_UNDEFINED)
+      return;
+    purge_node_t::del_mark_t &d= node->del_marks[row];
+    std::swap(d.pcur, node->pcur);
+    d.found_clust= node->found_clust;
+    node->found_clust= false;
+  };
+
+  auto set_row= [node, &row, &save_row](size_t r)
+  {
+    if (row == r)
+      return;
+    save_row();
+    row= r;
+    purge_node_t::del_mark_t &d= node->del_marks[r];
+    std::swap(d.pcur, node->pcur);
+    node->found_clust= d.found_clust;
+    node->ref= d.ref;
+    node->roll_ptr= d.roll_ptr;
+    node->trx_id= d.trx_id;
+  };
+
+  std::stable_sort(node->sec_entries.begin(), node->sec_entries.end(),
+                   row_purge_sec_entry_less);
+
+  row_purge_sec_hint_t hint;
+  for (const purge_node_t::sec_entry_t &e : node->sec_entries)
+  {
+    set_row(e.row);
+    row_purge_remove_sec_if_poss(node, e.index, e.entry, &hint);
+  }
+
+  for (size_t r= 0; r < node->del_marks.size(); r++)
+  {
+    set_row(r);
+    bool purged;
+    while (!(purged= row_purge_del_mark_clust(node)) &&
+           srv_shutdown_state <= SRV_SHUTDOWN_INITIATED)
+    {
+      /* Retry the purge in a second. */
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+
+    if (purged)
+    {
+      if (node->table->stat_initialized && srv_stats_include_delete_marked)
+        dict_stats_update_if_needed(node->table, *thr->graph->trx);
+      MONITOR_INC(MONITOR_N_DEL_ROW_PURGE);
+    }
+  }
+
+  save_row();
+  for (purge_node_t::del_mark_t &d : node->del_marks)
+    btr_pcur_close(&d.pcur);
+
+  node->del_marks.clear();
+  node->sec_entries.clear();
+  node->del_mark_table= nullptr;
+  node->table= table;
+  node->ref= ref;
+  node->roll_ptr= roll_ptr;
+  node->trx_id= trx_id;
+}
+
+/** Defer the purge of a delete marking of a record, so that the secondary
+index entries of consecutive delete-marked rows of a table can be removed
+in index key order by row_purge_deferred().
+@param node  purge node
+@param thr   query thread
+@return whether the purge was deferred */
+static bool row_purge_defer_del_mark(purge_node_t *node, que_thr_t *thr)
+{
+  ut_ad(node->rec_type == TRX_UNDO_DEL_MARK_REC);
+  ut_ad(!node->found_clust);
+
+  if (dict_is_sys_table(node->table->id))
+    return false;
+
+  ut_ad(node->del_marks.empty() || node->del_mark_table == node->table);
+  const size_t row= node->del_marks.size();
+  node->del_mark_table= node->table;
+  node->del_marks.emplace_back();
+  purge_node_t::del_mark_t &d= node->del_marks.back();
+  d.ref= node->ref;
+  d.roll_ptr= node->roll_ptr;
+  d.trx_id= node->trx_id;
+
+  /* The entries must remain valid until the end of the batch,
+  like node->row and node->ref. */
+  for (dict_index_t *index= dict_table_get_next_index
+         (dict_table_get_first_index(node->table));
+       index; index= dict_table_get_next_index(index))
+  {
+    if (index->type & (DICT_FTS | DICT_CORRUPT) || !index->is_committed())
+      continue;
+    if (const dtuple_t *entry=
+        row_build_index_entry_low(node->row, nullptr, index, node->heap,
+                                  ROW_BUILD_FOR_PURGE))
+      node->sec_entries.push_back({index, entry, row});
+  }
+
+  if (node->del_marks.size() >= ROW_PURGE_MAX_DEFERRED)
+    row_purge_deferred(node, thr);
+
+  return true;
 }
 
 /** Reset DB_TRX_ID, DB_ROLL_PTR of a clustered index record
@@ -1135,6 +1431,16 @@ row_purge(
 		while (row_purge_parse_undo_rec(
 			       node, undo_rec, thr, &updated_extern)) {
 
+			if (node->rec_type != TRX_UNDO_DEL_MARK_REC
+			    || node->table != node->del_mark_table) {
+				row_purge_deferred(node, thr);
+			}
+
+			if (node->rec_type == TRX_UNDO_DEL_MARK_REC
+			    && row_purge_defer_del_mark(node, thr)) {
+				return;
+			}
+
 			bool purged = row_purge_record(
 				node, undo_rec, thr, updated_extern);
 
@@ -1169,6 +1475,7 @@ inline que_node_t *purge_node_t::end(THD *thd)
 {
   DBUG_ASSERT(common.type == QUE_NODE_PURGE);
   ut_ad(undo_recs.empty());
+  ut_ad(del_marks.empty());
   ut_d(in_progress= false);
   innobase_reset_background_thd(thd);
 #ifndef DBUG_OFF
@@ -1201,6 +1508,8 @@ row_purge_step(
 		row_purge(node, purge_rec.undo_rec, thr);
 	}
 
+	row_purge_deferred(node, thr);
+
 	thr->run_node = node->end(current_thd);
 	return(thr);
 }
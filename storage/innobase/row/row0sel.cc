@@ -3250,6 +3250,16 @@ static bool row_sel_store_mysql_rec(
 	DBUG_RETURN(true);
 }
 
+bool row_sel_store_mysql_rec_clust(byte *mysql_rec, row_prebuilt_t *prebuilt,
+                                   const rec_t *rec, const rec_offs *offsets)
+{
+  ut_ad(!prebuilt->blob_heap);
+  ut_ad(!dict_table_has_fts_index(prebuilt->table));
+  return row_sel_store_mysql_rec(mysql_rec, prebuilt, rec, nullptr, true,
+                                 dict_table_get_first_index(prebuilt->table),
+                                 offsets);
+}
+
 static void row_sel_reset_old_vers_heap(row_prebuilt_t *prebuilt)
 {
   if (prebuilt->old_vers_heap)
@@ -3285,7 +3295,8 @@ row_sel_build_prev_vers_for_mysql(
 	return row_vers_build_for_consistent_read(
 		rec, mtr, clust_index, offsets,
 		&prebuilt->trx->read_view, offset_heap,
-		prebuilt->old_vers_heap, old_vers, vrow);
+		prebuilt->old_vers_heap, old_vers, vrow,
+		row_vers_cache_t::get(prebuilt->trx));
 }
 
 /** Helper class to cache clust_rec and old_vers */
@@ -3924,7 +3935,8 @@ row_sel_enqueue_cache_row_for_mysql(
 	/* For non ICP code path the row should already exist in the
 	next fetch cache slot. */
 
-	if (prebuilt->pk_filter || prebuilt->idx_cond) {
+	if (prebuilt->pk_filter || prebuilt->idx_cond
+	    || prebuilt->scan_filter) {
 		memcpy(row_sel_fetch_last_buf(prebuilt), mysql_rec,
 		       prebuilt->mysql_row_len);
 	}
@@ -4014,7 +4026,7 @@ row_sel_try_search_shortcut_for_mysql(
 #endif /* BTR_CUR_HASH_ADAPT */
 
 /*********************************************************************//**
-Check a pushed-down index condition.
+Check a pushed-down index condition, rowid filter or table scan filter.
 @return CHECK_ABORTED_BY_USER, CHECK_NEG, CHECK_POS, or CHECK_OUT_OF_RANGE */
 static
 check_result_t
@@ -4034,7 +4046,9 @@ row_search_idx_cond_check(
 	ut_ad(rec_offs_validate(rec, prebuilt->index, offsets));
 
 	if (!prebuilt->idx_cond) {
-		if (!prebuilt->pk_filter ||
+		if (prebuilt->scan_filter) {
+			ut_ad(dict_index_is_clust(prebuilt->index));
+		} else if (!prebuilt->pk_filter ||
                     !handler_rowid_filter_is_active(prebuilt->pk_filter)) {
 			return(CHECK_POS);
 		}
@@ -4073,6 +4087,8 @@ row_search_idx_cond_check(
 	inserted in a different case. */
 	check_result_t result = prebuilt->idx_cond
 		? handler_index_cond_check(prebuilt->idx_cond)
+		: prebuilt->scan_filter
+		? handler_scan_filter_check(prebuilt->scan_filter)
 		: CHECK_POS;
 
 	switch (result) {
@@ -4563,7 +4579,8 @@ row_search_mvcc(
 				mtr.commit(). */
 				ut_ad(!rec_get_deleted_flag(rec, comp));
 
-				if (prebuilt->pk_filter || prebuilt->idx_cond) {
+				if (prebuilt->pk_filter || prebuilt->idx_cond
+				    || prebuilt->scan_filter) {
 					switch (row_search_idx_cond_check(
 							buf, prebuilt,
 							rec, offsets)) {
@@ -5569,7 +5586,8 @@ row_search_mvcc(
 		result_rec = clust_rec;
 		ut_ad(rec_offs_validate(result_rec, clust_index, offsets));
 
-		if (prebuilt->pk_filter || prebuilt->idx_cond) {
+		if (prebuilt->pk_filter || prebuilt->idx_cond
+		    || prebuilt->scan_filter) {
 			/* Convert the record to MySQL format. We were
 			unable to do this in row_search_idx_cond_check(),
 			because the condition is on the secondary index
@@ -5627,7 +5645,8 @@ row_search_mvcc(
 		/* We only convert from InnoDB row format to MySQL row
 		format when ICP is disabled. */
 
-		if (!prebuilt->pk_filter && !prebuilt->idx_cond) {
+		if (!prebuilt->pk_filter && !prebuilt->idx_cond
+		    && !prebuilt->scan_filter) {
 			/* We use next_buf to track the allocation of buffers
 			where we store and enqueue the buffers for our
 			pre-fetch optimisation.
@@ -5678,7 +5697,8 @@ row_search_mvcc(
 			goto next_rec;
 		}
 	} else {
-		if (!prebuilt->pk_filter && !prebuilt->idx_cond) {
+		if (!prebuilt->pk_filter && !prebuilt->idx_cond
+		    && !prebuilt->scan_filter) {
 			/* The record was not yet converted to MySQL format. */
 			if (!row_sel_store_mysql_rec(
 				    buf, prebuilt, result_rec, vrow,
@@ -5797,10 +5817,15 @@ row_search_mvcc(
 				if (btr_pcur_is_after_last_in_tree(pcur)) {
 					goto not_moved;
 				}
+				const page_id_t left_page_id{
+					btr_pcur_get_block(pcur)->page.id()};
 				err = btr_pcur_move_to_next_page(pcur, &mtr);
 				if (err != DB_SUCCESS) {
 					goto lock_wait_or_error;
 				}
+				if (prebuilt->scan_resistant) {
+					buf_LRU_make_last(left_page_id);
+				}
 			} else if (!btr_pcur_move_to_next_on_page(pcur)) {
 				goto corrupted;
 			}
@@ -5901,7 +5926,8 @@ row_search_mvcc(
 
 	DEBUG_SYNC_C("row_search_for_mysql_before_return");
 
-	if (prebuilt->pk_filter || prebuilt->idx_cond) {
+	if (prebuilt->pk_filter || prebuilt->idx_cond
+	    || prebuilt->scan_filter) {
 		/* When ICP is active we don't write to the MySQL buffer
 		directly, only to buffers that are enqueued in the pre-fetch
 		queue. We need to dequeue the first buffer and copy the contents
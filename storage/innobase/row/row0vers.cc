@@ -41,6 +41,7 @@ Created 2/6/1997 Heikki Tuuri
 #include "rem0cmp.h"
 #include "lock0lock.h"
 #include "row0mysql.h"
+#include "srv0mon.h"
 
 /** Check whether all non-virtual index fields are equal.
 @param[in]	index	the secondary index
@@ -1157,6 +1158,80 @@ row_vers_old_has_index_entry(
 	}
 }
 
+Atomic_relaxed<uint64_t> row_vers_cache_t::undo_truncations;
+
+void row_vers_cache_t::clear()
+{
+  map.clear();
+  if (heap)
+  {
+    mem_heap_free(heap);
+    heap= nullptr;
+  }
+  used= 0;
+}
+
+bool row_vers_cache_t::find(const dict_index_t &index, roll_ptr_t roll_ptr,
+                            mem_heap_t *heap, rec_t **old_vers)
+{
+  if (!validate())
+    return false;
+  auto it= map.find(roll_ptr);
+  if (it == map.end() || it->second.index_id != index.id)
+    return false;
+  const entry_t &e= it->second;
+  if (!e.buf)
+    *old_vers= nullptr;
+  else
+  {
+    byte *buf= static_cast<byte*>(mem_heap_dup(heap, e.buf, e.size));
+    *old_vers= buf + e.extra;
+  }
+  return true;
+}
+
+void row_vers_cache_t::add(const dict_index_t &index, roll_ptr_t roll_ptr,
+                           const rec_t *old_vers, const rec_offs *offsets)
+{
+  /* Account for the hash table node as well as the record. */
+  const size_t size= (old_vers ? rec_offs_size(offsets) : 0) +
+    sizeof(entry_t) + 4 * sizeof(void*);
+  validate();
+  if (used + size > srv_old_version_cache_size)
+  {
+    clear();
+    if (size > srv_old_version_cache_size)
+      return;
+  }
+
+  entry_t e{nullptr, 0, 0, index.id};
+  if (old_vers)
+  {
+    if (!heap)
+      heap= mem_heap_create(srv_page_size);
+    e.extra= uint32_t(rec_offs_extra_size(offsets));
+    e.size= uint32_t(rec_offs_size(offsets));
+    e.buf= static_cast<const byte*>
+      (mem_heap_dup(heap, old_vers - e.extra, e.size));
+  }
+
+  if (map.emplace(roll_ptr, e).second)
+    used+= size;
+}
+
+row_vers_cache_t *row_vers_cache_t::get(trx_t *trx)
+{
+  if (!srv_old_version_cache_size)
+  {
+    if (trx->vers_cache)
+      trx->vers_cache->clear();
+    return nullptr;
+  }
+  if (!trx->vers_cache)
+    trx->vers_cache= new row_vers_cache_t;
+  return trx->vers_cache;
+}
+
 /*****************************************************************//**
 Constructs the version of a clustered index record which a consistent
 read should see. We assume that the trx id stored in rec is such that
@@ -1186,7 +1261,9 @@ row_vers_build_for_consistent_read(
 				if the history is missing or the record
 				does not exist in the view, that is,
 				it was freshly inserted afterwards */
-	dtuple_t**	vrow)	/*!< out: virtual row */
+	dtuple_t**	vrow,	/*!< out: virtual row */
+	row_vers_cache_t*cache)	/*!< in/out: cache of old versions
+				for the read view, or nullptr */
 {
 	const rec_t*	version;
 	rec_t*		prev_version;
@@ -1194,6 +1271,7 @@ row_vers_build_for_consistent_read(
 	mem_heap_t*	heap		= NULL;
 	byte*		buf;
 	dberr_t		err;
+	roll_ptr_t	roll_ptr	= 0;
 
 	ut_ad(index->is_primary());
 	ut_ad(mtr->memo_contains_page_flagged(rec, MTR_MEMO_PAGE_X_FIX
@@ -1207,6 +1285,23 @@ row_vers_build_for_consistent_read(
 
 	ut_ad(!vrow || !(*vrow));
 
+	MONITOR_INC(MONITOR_TRX_OLD_VERSIONS_BUILT);
+
+	if (cache && !vrow) {
+		roll_ptr = row_get_rec_roll_ptr(rec, index, *offsets);
+
+		if (cache->find(*index, roll_ptr, in_heap, old_vers)) {
+			MONITOR_INC(MONITOR_TRX_OLD_VERSION_CACHE_HITS);
+			if (*old_vers) {
+				*offsets = rec_get_offsets(
+					*old_vers, index, *offsets,
+					index->n_core_fields,
+					ULINT_UNDEFINED, offset_heap);
+			}
+			return DB_SUCCESS;
+		}
+	}
+
 	version = rec;
 
 	for (;;) {
@@ -1214,6 +1309,8 @@ row_vers_build_for_consistent_read(
 
 		heap = mem_heap_create(1024);
 
+		MONITOR_INC(MONITOR_TRX_OLD_VERSION_UNDO_RECS);
+
 		if (vrow) {
 			*vrow = NULL;
 		}
@@ -1233,6 +1330,9 @@ row_vers_build_for_consistent_read(
 			/* It was a freshly inserted version */
 			*old_vers = NULL;
 			ut_ad(!vrow || !(*vrow));
+			if (roll_ptr && err == DB_SUCCESS) {
+				cache->add(*index, roll_ptr, NULL, NULL);
+			}
 			break;
 		}
 
@@ -1258,6 +1358,11 @@ row_vers_build_for_consistent_read(
 			*old_vers = rec_copy(buf, prev_version, *offsets);
 			rec_offs_make_valid(*old_vers, index, true, *offsets);
 
+			if (roll_ptr) {
+				cache->add(*index, roll_ptr,
+					   *old_vers, *offsets);
+			}
+
 			if (vrow && *vrow) {
 				*vrow = dtuple_copy(*vrow, in_heap);
 				dtuple_dup_v_fld(*vrow, in_heap);
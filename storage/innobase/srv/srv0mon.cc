@@ -167,6 +167,36 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_EXISTING | MONITOR_DISPLAY_CURRENT | MONITOR_DEFAULT_ON),
 	 MONITOR_DEFAULT_START, MONITOR_OVLD_LOCK_AVG_WAIT_TIME},
 
+	{"lock_row_lock_waits_under_10ms", "lock",
+	 "Number of row lock waits that took less than 10 milliseconds",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ROW_LOCK_WAIT_10MS},
+
+	{"lock_row_lock_waits_under_100ms", "lock",
+	 "Number of row lock waits that took 10 to 100 milliseconds",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ROW_LOCK_WAIT_100MS},
+
+	{"lock_row_lock_waits_under_1s", "lock",
+	 "Number of row lock waits that took 100 milliseconds to 1 second",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ROW_LOCK_WAIT_1S},
+
+	{"lock_row_lock_waits_under_10s", "lock",
+	 "Number of row lock waits that took 1 to 10 seconds",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ROW_LOCK_WAIT_10S},
+
+	{"lock_row_lock_waits_over_10s", "lock",
+	 "Number of row lock waits that took 10 seconds or longer",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ROW_LOCK_WAIT_LONGER},
+
 	/* ========== Counters for Buffer Manager and I/O ========== */
 	{"module_buffer", "buffer", "Buffer Manager Module",
 	 MONITOR_MODULE,
@@ -338,6 +368,47 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_SET_MEMBER, MONITOR_FLUSH_NEIGHBOR_TOTAL_PAGE,
 	 MONITOR_FLUSH_NEIGHBOR_PAGES},
 
+	/* Pages written by each worker of buf_do_flush_list_batch() */
+	{"buffer_flush_worker0_pages", "buffer",
+	 "Pages written by innodb_page_cleaner_threads worker 0",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_WORKER_PAGES_0},
+
+	{"buffer_flush_worker1_pages", "buffer",
+	 "Pages written by innodb_page_cleaner_threads worker 1",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_WORKER_PAGES_1},
+
+	{"buffer_flush_worker2_pages", "buffer",
+	 "Pages written by innodb_page_cleaner_threads worker 2",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_WORKER_PAGES_2},
+
+	{"buffer_flush_worker3_pages", "buffer",
+	 "Pages written by innodb_page_cleaner_threads worker 3",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_WORKER_PAGES_3},
+
+	{"buffer_flush_worker4_pages", "buffer",
+	 "Pages written by innodb_page_cleaner_threads worker 4",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_WORKER_PAGES_4},
+
+	{"buffer_flush_worker5_pages", "buffer",
+	 "Pages written by innodb_page_cleaner_threads worker 5",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_WORKER_PAGES_5},
+
+	{"buffer_flush_worker6_pages", "buffer",
+	 "Pages written by innodb_page_cleaner_threads worker 6",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_WORKER_PAGES_6},
+
+	{"buffer_flush_worker7_pages", "buffer",
+	 "Pages written by innodb_page_cleaner_threads worker 7",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_WORKER_PAGES_7},
+
 	{"buffer_flush_n_to_flush_requested", "buffer",
 	 "Number of pages requested for flushing.",
 	 MONITOR_NONE,
@@ -667,6 +738,26 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_EXISTING | MONITOR_DISPLAY_CURRENT),
 	 MONITOR_DEFAULT_START, MONITOR_RSEG_CUR_SIZE},
 
+	{"trx_old_versions_built", "transaction",
+	 "Number of old record versions constructed for consistent reads",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_TRX_OLD_VERSIONS_BUILT},
+
+	{"trx_old_version_undo_records", "transaction",
+	 "Number of undo log records applied to construct old record versions",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_TRX_OLD_VERSION_UNDO_RECS},
+
+	{"trx_old_version_cache_hits", "transaction",
+	 "Number of old record versions found in innodb_old_version_cache_size",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_TRX_OLD_VERSION_CACHE_HITS},
+
+	{"trx_snapshots_reused", "transaction",
+	 "Number of read views that copied the snapshot of an earlier read view",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_TRX_SNAPSHOTS_REUSED},
+
 	/* ========== Counters for Purge Module ========== */
 	{"module_purge", "purge", "Purge Module",
 	 MONITOR_MODULE,
@@ -784,6 +875,16 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_PAGE_DECOMPRESS},
 
+	{"compress_pages_lz4_compressed", "compression",
+	 "Number of pages compressed with LZ4 (ZIP_ALGORITHM=LZ4)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_COMPRESS_LZ4},
+
+	{"compress_pages_lz4_decompressed", "compression",
+	 "Number of pages decompressed with LZ4",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_DECOMPRESS_LZ4},
+
 	{"compression_pad_increments", "compression",
 	 "Number of times padding is incremented to avoid compression failures",
 	 MONITOR_NONE,
@@ -1461,6 +1562,20 @@ srv_mon_process_existing_counter(
 		value = lock_sys.get_wait_cumulative();
 		break;
 
+	/* lock wait time histogram */
+	case MONITOR_OVLD_ROW_LOCK_WAIT_10MS:
+	case MONITOR_OVLD_ROW_LOCK_WAIT_100MS:
+	case MONITOR_OVLD_ROW_LOCK_WAIT_1S:
+	case MONITOR_OVLD_ROW_LOCK_WAIT_10S:
+	case MONITOR_OVLD_ROW_LOCK_WAIT_LONGER:
+		static_assert(MONITOR_OVLD_ROW_LOCK_WAIT_LONGER
+			      - MONITOR_OVLD_ROW_LOCK_WAIT_10MS + 1
+			      == lock_sys_t::WAIT_HISTOGRAM_SIZE, "");
+		// dirty read without lock_sys.wait_mutex
+		value = lock_sys.get_wait_histogram(
+			monitor_id - MONITOR_OVLD_ROW_LOCK_WAIT_10MS);
+		break;
+
 	case MONITOR_RSEG_HISTORY_LEN:
 		value = trx_sys.history_size_approx();
 		break;
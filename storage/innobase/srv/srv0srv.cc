@@ -130,6 +130,9 @@ bool high_level_read_only;
 
 /** Sort buffer size in index creation */
 ulong	srv_sort_buf_size;
+/** Maximum size of the cache of old record versions of a transaction,
+in bytes; 0 disables the cache */
+ulong	srv_old_version_cache_size;
 /** Maximum modification log file size for online index creation */
 unsigned long long	srv_online_max_size;
 
@@ -139,6 +142,7 @@ use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 my_bool	srv_use_native_aio;
 my_bool	srv_numa_interleave;
+my_bool	srv_numa_local_chunks;
 /** copy of innodb_use_atomic_writes; @see innodb_init_params() */
 my_bool	srv_use_atomic_writes;
 /** innodb_compression_algorithm; used with page compression */
@@ -187,6 +191,9 @@ size_t	srv_buf_pool_chunk_unit;
 ulong	srv_LRU_scan_depth;
 /** innodb_flush_neighbors; whether or not to flush neighbors of a block */
 ulong	srv_flush_neighbors;
+/** innodb_page_cleaner_threads; number of threads that write the pages
+of a buf_pool.flush_list batch */
+ulong	srv_page_cleaner_threads;
 /** Previously requested size */
 ulint	srv_buf_pool_old_size;
 /** Current size as scaling factor for the other components */
@@ -195,6 +202,10 @@ ulint	srv_buf_pool_base_size;
 ulint	srv_buf_pool_curr_size;
 /** Dump this % of each buffer pool during BP dump */
 ulong	srv_buf_pool_dump_pct;
+/** Number of threads that submit reads during BP load */
+ulong	srv_buf_pool_load_threads;
+/** Maximum number of pending read requests during BP load */
+ulong	srv_buf_pool_load_io_depth;
 /** Abort load after this amount of pages */
 #ifdef UNIV_DEBUG
 ulong srv_buf_pool_load_pages_abort = LONG_MAX;
@@ -265,6 +276,11 @@ by SELECT or mysqldump. When this is nonzero, we do not allow any user
 modifications to the data. */
 ulong	srv_force_recovery;
 
+/** innodb_recovery_online: whether the last batch of crash recovery
+may be applied in the background while the server accepts connections.
+Pages that are accessed before that will be recovered on demand. */
+my_bool	srv_recovery_online;
+
 /** innodb_print_all_deadlocks; whether to print all user-level
 transactions deadlocks to the error log */
 my_bool	srv_print_all_deadlocks;
@@ -308,6 +324,9 @@ based on number of configured pages */
 my_bool	srv_stats_sample_traditional;
 
 my_bool	srv_use_doublewrite_buf;
+/** innodb_doublewrite_batches: number of doublewrite batches that can be
+written concurrently */
+ulong	srv_doublewrite_batches= 1;
 
 /** innodb_sync_spin_loops */
 ulong	srv_n_spin_wait_rounds;
@@ -475,6 +494,11 @@ std::unique_ptr<tpool::timer> srv_monitor_timer;
 /** The buffer pool dump/load file name */
 char*	srv_buf_dump_filename;
 
+/** The second-level page cache file name, or NULL */
+char*	srv_buf_l2_file;
+/** Size of the second-level page cache file, in bytes */
+ulonglong	srv_buf_l2_size;
+
 /** Boolean config knobs that tell InnoDB to dump the buffer pool at shutdown
 and/or load it during startup. */
 char	srv_buffer_pool_dump_at_shutdown = TRUE;
@@ -47,6 +47,7 @@ Created 2/16/1996 Heikki Tuuri
 #include "buf0buf.h"
 #include "buf0dblwr.h"
 #include "buf0dump.h"
+#include "buf0l2.h"
 #include "os0file.h"
 #include "fil0fil.h"
 #include "fil0crypt.h"
@@ -1137,6 +1138,15 @@ ATTRIBUTE_COLD static dberr_t srv_log_rebuild()
   return err;
 }
 
+/** @return whether the redo log needs to be resized, upgraded,
+or (de)encrypted */
+static bool srv_log_rebuild_needed()
+{
+  return log_sys.file_size != srv_log_file_size ||
+    log_sys.format !=
+    (srv_encrypt_log ? log_t::FORMAT_ENC_10_8 : log_t::FORMAT_10_8);
+}
+
 /** Rebuild the redo log if needed. */
 static dberr_t srv_log_rebuild_if_needed()
 {
@@ -1147,9 +1157,7 @@ static dberr_t srv_log_rebuild_if_needed()
     /* Leave the redo log alone. */
     return DB_SUCCESS;
 
-  if (log_sys.file_size == srv_log_file_size &&
-      log_sys.format ==
-      (srv_encrypt_log ? log_t::FORMAT_ENC_10_8 : log_t::FORMAT_10_8))
+  if (!srv_log_rebuild_needed())
   {
     /* No need to add or remove encryption, upgrade, or resize. */
     delete_log_files();
@@ -1341,6 +1349,8 @@ dberr_t srv_start(bool create_new_db)
 
 	ib::info() << "Completed initialization of buffer pool";
 
+	buf_l2.create();
+
 #ifdef UNIV_DEBUG
 	/* We have observed deadlocks with a 5MB buffer pool but
 	the actual lower limit could very well be a little higher. */
@@ -1566,24 +1576,35 @@ dberr_t srv_start(bool create_new_db)
 		}
 
 		if (srv_force_recovery < SRV_FORCE_NO_LOG_REDO) {
-			/* Apply the hashed log records to the
-			respective file pages, for the last batch of
-			recv_group_scan_log_recs().
-			Since it may generate huge batch of threadpool tasks,
-			for read io task group, scale down thread creation rate
-			by temporarily restricting tpool concurrency.
-			*/
-			srv_thread_pool->set_concurrency(srv_n_read_io_threads);
-
-			mysql_mutex_lock(&recv_sys.mutex);
-			recv_sys.apply(true);
-			mysql_mutex_unlock(&recv_sys.mutex);
-
-			srv_thread_pool->set_concurrency();
-
-			if (recv_sys.is_corrupt_log()
-			    || recv_sys.is_corrupt_fs()) {
-				return(srv_init_abort(DB_CORRUPTION));
+			if (srv_recovery_online
+			    && srv_operation == SRV_OPERATION_NORMAL
+			    && !must_upgrade_ibuf
+			    && !srv_log_rebuild_needed()
+			    && recv_sys.apply_online()) {
+				/* The remaining pages will be recovered
+				in the background, or on demand when
+				they are being accessed. */
+			} else {
+				/* Apply the hashed log records to the
+				respective file pages, for the last batch of
+				recv_group_scan_log_recs().
+				Since it may generate huge batch of threadpool
+				tasks, for read io task group, scale down
+				thread creation rate by temporarily restricting
+				tpool concurrency. */
+				srv_thread_pool->set_concurrency(
+					srv_n_read_io_threads);
+
+				mysql_mutex_lock(&recv_sys.mutex);
+				recv_sys.apply(true);
+				mysql_mutex_unlock(&recv_sys.mutex);
+
+				srv_thread_pool->set_concurrency();
+
+				if (recv_sys.is_corrupt_log()
+				    || recv_sys.is_corrupt_fs()) {
+					return(srv_init_abort(DB_CORRUPTION));
+				}
 			}
 
 			if (srv_operation != SRV_OPERATION_RESTORE
@@ -1996,6 +2017,10 @@ void innodb_shutdown()
 {
 	innodb_preshutdown();
 	ut_ad(!srv_undo_sources);
+	if (recv_sys.is_initialised()) {
+		/* Wait for recv_sys_t::apply_online() */
+		recv_sys.wait_online();
+	}
 	switch (srv_operation) {
 	case SRV_OPERATION_BACKUP:
 	case SRV_OPERATION_RESTORE_DELTA:
@@ -2068,6 +2093,7 @@ void innodb_shutdown()
 	purge_sys.close();
 	trx_sys.close();
 	buf_dblwr.close();
+	buf_l2.close();
 	lock_sys.close();
 	trx_pool_close();
 
@@ -146,6 +146,9 @@ void trx_sys_t::create()
   m_initialised= true;
   trx_list.create();
   rw_trx_hash.init();
+  m_snapshot_generation.store(1, std::memory_order_relaxed);
+  m_snapshot_cached.store(0, std::memory_order_relaxed);
+  m_snapshot_latch.init();
 }
 
 size_t trx_sys_t::history_size()
@@ -320,6 +323,7 @@ trx_sys_t::close()
 	}
 
 	rw_trx_hash.destroy();
+	m_snapshot_latch.destroy();
 
 	/* There can't be any active transactions. */
 
@@ -36,6 +36,7 @@ Created 3/26/1996 Heikki Tuuri
 #include "lock0lock.h"
 #include "log0log.h"
 #include "que0que.h"
+#include "row0vers.h"
 #include "srv0mon.h"
 #include "srv0srv.h"
 #include "srv0start.h"
@@ -236,6 +237,9 @@ struct TrxFactory {
 
 		trx->mod_tables.~trx_mod_tables_t();
 
+		delete trx->vers_cache;
+		trx->vers_cache = NULL;
+
 		ut_ad(!trx->read_view.is_open());
 
 		trx->lock.table_locks.~lock_list();
@@ -1374,6 +1378,8 @@ TRANSACTIONAL_INLINE inline void trx_t::commit_in_memory(const mtr_t *mtr)
   /* We already detached from rseg in write_serialisation_history() */
   ut_ad(!rsegs.m_redo.undo);
   read_view.close();
+  if (vers_cache)
+    vers_cache->clear();
 
   if (is_autocommit_non_locking())
   {
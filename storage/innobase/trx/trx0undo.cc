@@ -34,6 +34,7 @@ Created 3/26/1996 Heikki Tuuri
 #include "trx0purge.h"
 #include "trx0rec.h"
 #include "trx0rseg.h"
+#include "row0vers.h"
 #include "log.h"
 
 /* How should the old versions in the history list be managed?
@@ -868,6 +869,9 @@ dberr_t trx_undo_try_truncate(const trx_t &trx)
   if (trx_undo_t *undo= trx.rsegs.m_redo.undo)
   {
     ut_ad(undo->rseg == trx.rsegs.m_redo.rseg);
+    /* The DB_ROLL_PTR of the discarded undo log records may be
+    assigned to other records. */
+    row_vers_cache_t::undo_truncations.fetch_add(1);
     if (dberr_t err= trx_undo_truncate_end(*undo, trx.undo_no, false))
       return err;
   }
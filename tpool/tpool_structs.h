@@ -81,6 +81,12 @@ template<typename T> class cache
   Protected by m_mtx */
   int m_waiters;
 
+  /** Number of threads waiting in wait_below(). Protected by m_mtx */
+  int m_below_waiters;
+
+  /** The largest limit of the wait_below() waiters. Protected by m_mtx */
+  size_t m_below;
+
   /** Current cache size. Protected by m_mtx*/
   size_t m_pos;
 
@@ -113,7 +119,7 @@ template<typename T> class cache
   @param size - maximum number of items in cache
   */
   cache(size_t size) : m_base(size), m_cache(size),
-    m_waiters(), m_pos(0)
+    m_waiters(), m_below_waiters(), m_below(0), m_pos(0)
   {
     mysql_mutex_init(tpool_cache_mutex_key, &m_mtx, nullptr);
     pthread_cond_init(&m_cv, nullptr);
@@ -159,7 +165,8 @@ template<typename T> class cache
     // put element to the logical end of the array
     m_cache[--m_pos] = ele;
 
-    if (was_empty || (is_full() && m_waiters))
+    if (was_empty || (is_full() && m_waiters) ||
+        (m_below_waiters && m_pos < m_below))
       pthread_cond_broadcast(&m_cv);
     mysql_mutex_unlock(&m_mtx);
   }
@@ -190,6 +197,25 @@ template<typename T> class cache
     mysql_mutex_unlock(&m_mtx);
   }
 
+  /** Wait until fewer than n items are borrowed.
+  @param n  maximum number of borrowed items, plus 1 */
+  void wait_below(size_t n)
+  {
+    mysql_mutex_lock(&m_mtx);
+    if (m_pos >= n)
+    {
+      m_below_waiters++;
+      if (m_below < n)
+        m_below= n;
+      do
+        my_cond_wait(&m_cv, &m_mtx.m_mutex);
+      while (m_pos >= n);
+      if (!--m_below_waiters)
+        m_below= 0;
+    }
+    mysql_mutex_unlock(&m_mtx);
+  }
+
   /**
    @return approximate number of "borrowed" items.
    A "dirty" read, not used in any critical functionality.